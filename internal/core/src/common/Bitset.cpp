@@ -0,0 +1,248 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "common/Bitset.h"
+
+// The kernels below are plain word loops. On x86 they are cloned for AVX-512 and AVX2 and the
+// best clone is picked by the loader according to the running CPU, so the default build
+// (without -mavx flags) still gets wide logical ops and vector popcount (AVX-512 VPOPCNTDQ,
+// first shipped with Ice Lake) where available.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__APPLE__)
+#define BITSET_LOGICAL_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#define BITSET_POPCOUNT_KERNEL __attribute__((target_clones("arch=icelake-server", "avx2", "popcnt", "default")))
+#else
+#define BITSET_LOGICAL_KERNEL
+#define BITSET_POPCOUNT_KERNEL
+#endif
+
+namespace milvus {
+
+namespace {
+using block_type = Bitset::block_type;
+
+BITSET_LOGICAL_KERNEL
+void
+and_blocks(block_type* __restrict dst, const block_type* __restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] &= src[i];
+    }
+}
+
+BITSET_LOGICAL_KERNEL
+void
+or_blocks(block_type* __restrict dst, const block_type* __restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] |= src[i];
+    }
+}
+
+BITSET_LOGICAL_KERNEL
+void
+xor_blocks(block_type* __restrict dst, const block_type* __restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+BITSET_LOGICAL_KERNEL
+void
+andnot_blocks(block_type* __restrict dst, const block_type* __restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] &= ~src[i];
+    }
+}
+
+BITSET_LOGICAL_KERNEL
+void
+not_blocks(block_type* __restrict dst, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = ~dst[i];
+    }
+}
+
+BITSET_LOGICAL_KERNEL
+bool
+any_blocks(const block_type* __restrict src, size_t n) {
+    block_type acc = 0;
+    for (size_t i = 0; i < n; ++i) {
+        acc |= src[i];
+    }
+    return acc != 0;
+}
+
+BITSET_POPCOUNT_KERNEL
+size_t
+popcount_blocks(const block_type* __restrict src, size_t n) {
+    size_t res = 0;
+    for (size_t i = 0; i < n; ++i) {
+        res += __builtin_popcountll(src[i]);
+    }
+    return res;
+}
+
+}  // namespace
+
+Bitset::Bitset(const uint8_t* data, size_t num_bits) {
+    resize(num_bits);
+    std::memcpy(blocks_.data(), data, byte_size());
+    zero_unused_bits();
+}
+
+void
+Bitset::resize(size_t num_bits, bool value) {
+    auto old_num_bits = num_bits_;
+    blocks_.resize(calc_num_blocks(num_bits), value ? ~block_type(0) : block_type(0));
+    num_bits_ = num_bits;
+    if (value && num_bits > old_num_bits) {
+        // the tail of the old last word was zero
+        auto old_extra_bits = old_num_bits % bits_per_block;
+        if (old_extra_bits != 0) {
+            blocks_[old_num_bits / bits_per_block] |= ~((block_type(1) << old_extra_bits) - 1);
+        }
+    }
+    zero_unused_bits();
+}
+
+Bitset&
+Bitset::set(size_t pos, size_t len, bool value) {
+    assert(pos + len <= num_bits_);
+    auto end = pos + len;
+    while (pos < end && pos % bits_per_block != 0) {
+        set(pos++, value);
+    }
+    auto fill = value ? ~block_type(0) : block_type(0);
+    for (; pos + bits_per_block <= end; pos += bits_per_block) {
+        blocks_[pos / bits_per_block] = fill;
+    }
+    while (pos < end) {
+        set(pos++, value);
+    }
+    return *this;
+}
+
+Bitset&
+Bitset::set() {
+    std::fill(blocks_.begin(), blocks_.end(), ~block_type(0));
+    zero_unused_bits();
+    return *this;
+}
+
+Bitset&
+Bitset::reset() {
+    std::fill(blocks_.begin(), blocks_.end(), block_type(0));
+    return *this;
+}
+
+Bitset&
+Bitset::flip() {
+    not_blocks(blocks_.data(), blocks_.size());
+    zero_unused_bits();
+    return *this;
+}
+
+size_t
+Bitset::count() const {
+    return popcount_blocks(blocks_.data(), blocks_.size());
+}
+
+bool
+Bitset::any() const {
+    return any_blocks(blocks_.data(), blocks_.size());
+}
+
+size_t
+Bitset::find_from_block(size_t first_block) const {
+    for (auto i = first_block; i < blocks_.size(); ++i) {
+        if (blocks_[i] != 0) {
+            return i * bits_per_block + __builtin_ctzll(blocks_[i]);
+        }
+    }
+    return npos;
+}
+
+size_t
+Bitset::find_next(size_t pos) const {
+    ++pos;
+    if (pos >= num_bits_) {
+        return npos;
+    }
+    auto block_id = pos / bits_per_block;
+    auto rest = blocks_[block_id] >> (pos % bits_per_block);
+    if (rest != 0) {
+        return pos + __builtin_ctzll(rest);
+    }
+    return find_from_block(block_id + 1);
+}
+
+void
+Bitset::append(const Bitset& other) {
+    if (&other == this) {
+        Bitset copy(other);
+        append(copy);
+        return;
+    }
+    auto offset = num_bits_;
+    if (offset % bits_per_block == 0) {
+        blocks_.insert(blocks_.end(), other.blocks_.begin(), other.blocks_.end());
+        num_bits_ += other.num_bits_;
+        return;
+    }
+    resize(num_bits_ + other.num_bits_);
+    auto shift = offset % bits_per_block;
+    auto dst = offset / bits_per_block;
+    for (size_t i = 0; i < other.blocks_.size(); ++i) {
+        auto block = other.blocks_[i];
+        blocks_[dst + i] |= block << shift;
+        if (dst + i + 1 < blocks_.size()) {
+            blocks_[dst + i + 1] |= block >> (bits_per_block - shift);
+        }
+    }
+}
+
+Bitset&
+Bitset::operator&=(const Bitset& other) {
+    assert(num_bits_ == other.num_bits_);
+    and_blocks(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+}
+
+Bitset&
+Bitset::operator|=(const Bitset& other) {
+    assert(num_bits_ == other.num_bits_);
+    or_blocks(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+}
+
+Bitset&
+Bitset::operator^=(const Bitset& other) {
+    assert(num_bits_ == other.num_bits_);
+    xor_blocks(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+}
+
+Bitset&
+Bitset::operator-=(const Bitset& other) {
+    assert(num_bits_ == other.num_bits_);
+    andnot_blocks(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+}
+
+bool
+Bitset::operator==(const Bitset& other) const {
+    return num_bits_ == other.num_bits_ &&
+           std::memcmp(blocks_.data(), other.blocks_.data(), blocks_.size() * sizeof(block_type)) == 0;
+}
+
+}  // namespace milvus
@@ -0,0 +1,321 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <boost/align/aligned_allocator.hpp>
+
+namespace milvus {
+
+// Dense bitset used for filter results and masks.
+// Storage is 64-byte aligned 64-bit words, so that bulk operations (logical ops, count, flip)
+// run word by word and are dispatched to AVX2/AVX-512 at runtime, see Bitset.cpp.
+// The layout is the same as faiss::BitsetView (bit i lives in byte i / 8), so a BitsetView can
+// point to data() directly. Bits past size() in the last word are always zero.
+class Bitset {
+ public:
+    using block_type = uint64_t;
+    using size_type = size_t;
+    static constexpr size_t bits_per_block = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t alignment = 64;
+
+    // proxy for bitset[i] = value, prefer set()/test() in hot loops
+    class reference {
+     public:
+        reference(block_type& block, size_t bit) : block_(block), mask_(block_type(1) << bit) {
+        }
+
+        operator bool() const {  // NOLINT
+            return (block_ & mask_) != 0;
+        }
+
+        reference&
+        operator=(bool value) {
+            if (value) {
+                block_ |= mask_;
+            } else {
+                block_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        reference&
+        operator=(const reference& other) {
+            return *this = bool(other);
+        }
+
+        reference&
+        operator|=(bool value) {
+            if (value) {
+                block_ |= mask_;
+            }
+            return *this;
+        }
+
+        reference&
+        operator&=(bool value) {
+            if (!value) {
+                block_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        bool
+        operator~() const {
+            return !bool(*this);
+        }
+
+     private:
+        block_type& block_;
+        const block_type mask_;
+    };
+
+ public:
+    Bitset() = default;
+
+    explicit Bitset(size_t num_bits, bool value = false) {
+        resize(num_bits, value);
+    }
+
+    // copy num_bits bits from data, laid out as in BitsetView
+    Bitset(const uint8_t* data, size_t num_bits);
+
+    size_t
+    size() const {
+        return num_bits_;
+    }
+
+    bool
+    empty() const {
+        return num_bits_ == 0;
+    }
+
+    size_t
+    num_blocks() const {
+        return blocks_.size();
+    }
+
+    size_t
+    byte_size() const {
+        return (num_bits_ + 7) / 8;
+    }
+
+    // memory footprint of the storage
+    size_t
+    memory_bytes() const {
+        return blocks_.capacity() * sizeof(block_type);
+    }
+
+    const uint8_t*
+    data() const {
+        return reinterpret_cast<const uint8_t*>(blocks_.data());
+    }
+
+    uint8_t*
+    data() {
+        return reinterpret_cast<uint8_t*>(blocks_.data());
+    }
+
+    const block_type*
+    blocks() const {
+        return blocks_.data();
+    }
+
+    block_type*
+    blocks() {
+        return blocks_.data();
+    }
+
+    void
+    resize(size_t num_bits, bool value = false);
+
+    void
+    reserve(size_t num_bits) {
+        blocks_.reserve(calc_num_blocks(num_bits));
+    }
+
+    void
+    clear() {
+        blocks_.clear();
+        num_bits_ = 0;
+    }
+
+    void
+    swap(Bitset& other) noexcept {
+        blocks_.swap(other.blocks_);
+        std::swap(num_bits_, other.num_bits_);
+    }
+
+    bool
+    test(size_t pos) const {
+        return (blocks_[pos / bits_per_block] >> (pos % bits_per_block)) & 1;
+    }
+
+    bool
+    operator[](size_t pos) const {
+        return test(pos);
+    }
+
+    reference
+    operator[](size_t pos) {
+        return reference(blocks_[pos / bits_per_block], pos % bits_per_block);
+    }
+
+    Bitset&
+    set(size_t pos, bool value = true) {
+        auto mask = block_type(1) << (pos % bits_per_block);
+        if (value) {
+            blocks_[pos / bits_per_block] |= mask;
+        } else {
+            blocks_[pos / bits_per_block] &= ~mask;
+        }
+        return *this;
+    }
+
+    // set [pos, pos + len) to value, word at a time
+    Bitset&
+    set(size_t pos, size_t len, bool value);
+
+    Bitset&
+    set();
+
+    Bitset&
+    reset(size_t pos) {
+        blocks_[pos / bits_per_block] &= ~(block_type(1) << (pos % bits_per_block));
+        return *this;
+    }
+
+    Bitset&
+    reset();
+
+    Bitset&
+    flip(size_t pos) {
+        blocks_[pos / bits_per_block] ^= block_type(1) << (pos % bits_per_block);
+        return *this;
+    }
+
+    Bitset&
+    flip();
+
+    size_t
+    count() const;
+
+    bool
+    any() const;
+
+    bool
+    none() const {
+        return !any();
+    }
+
+    bool
+    all() const {
+        return count() == num_bits_;
+    }
+
+    size_t
+    find_first() const {
+        return find_from_block(0);
+    }
+
+    size_t
+    find_next(size_t pos) const;
+
+    // append the bits of other at the end
+    void
+    append(const Bitset& other);
+
+    void
+    push_back(bool value) {
+        resize(num_bits_ + 1);
+        set(num_bits_ - 1, value);
+    }
+
+    Bitset&
+    operator&=(const Bitset& other);
+
+    Bitset&
+    operator|=(const Bitset& other);
+
+    Bitset&
+    operator^=(const Bitset& other);
+
+    // this & ~other
+    Bitset&
+    operator-=(const Bitset& other);
+
+    Bitset
+    operator~() const {
+        Bitset res(*this);
+        res.flip();
+        return res;
+    }
+
+    bool
+    operator==(const Bitset& other) const;
+
+    bool
+    operator!=(const Bitset& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    static size_t
+    calc_num_blocks(size_t num_bits) {
+        return (num_bits + bits_per_block - 1) / bits_per_block;
+    }
+
+    size_t
+    find_from_block(size_t first_block) const;
+
+    // keep the invariant that bits past size() are zero
+    void
+    zero_unused_bits() {
+        auto extra_bits = num_bits_ % bits_per_block;
+        if (extra_bits != 0) {
+            blocks_.back() &= (block_type(1) << extra_bits) - 1;
+        }
+    }
+
+ private:
+    std::vector<block_type, boost::alignment::aligned_allocator<block_type, alignment>> blocks_;
+    size_t num_bits_ = 0;
+};
+
+inline Bitset
+operator&(const Bitset& lhs, const Bitset& rhs) {
+    Bitset res(lhs);
+    return res &= rhs;
+}
+
+inline Bitset
+operator|(const Bitset& lhs, const Bitset& rhs) {
+    Bitset res(lhs);
+    return res |= rhs;
+}
+
+inline Bitset
+operator^(const Bitset& lhs, const Bitset& rhs) {
+    Bitset res(lhs);
+    return res ^= rhs;
+}
+
+inline Bitset
+operator-(const Bitset& lhs, const Bitset& rhs) {
+    Bitset res(lhs);
+    return res -= rhs;
+}
+
+}  // namespace milvus
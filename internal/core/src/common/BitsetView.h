@@ -17,7 +17,6 @@
 #pragma once
 
 #include <deque>
-#include <boost_ext/dynamic_bitset_ext.hpp>
 #include "exceptions/EasyAssert.h"
 #include "common/Types.h"
 #include "knowhere/utils/BitsetView.h"
@@ -35,8 +34,9 @@ class BitsetView : public faiss::BitsetView {
     BitsetView(const uint8_t* data, size_t num_bits) : faiss::BitsetView(data, num_bits) {  // NOLINT
     }
 
+    // zero copy, the bitset must outlive the view
     BitsetView(const BitsetType& bitset)  // NOLINT
-        : BitsetView((uint8_t*)boost_ext::get_data(bitset), size_t(bitset.size())) {
+        : BitsetView(bitset.data(), bitset.size()) {
     }
 
     BitsetView(const BitsetTypePtr& bitset_ptr) {  // NOLINT
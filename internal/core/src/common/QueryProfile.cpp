@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/QueryProfile.h"
+#include "utils/Json.h"
+
+namespace milvus {
+
+std::string
+ExprProfile::path() const {
+    if (udf) {
+        return "udf";
+    }
+    if (index_chunks > 0 && raw_data_chunks > 0) {
+        return "index+raw_data";
+    }
+    if (index_chunks > 0) {
+        return "index";
+    }
+    if (raw_data_chunks > 0) {
+        return "raw_data";
+    }
+    return "none";
+}
+
+std::string
+QueryProfile::ToJson() const {
+    json res;
+    res["predicate_cache_hit"] = predicate_cache_hit;
+    res["lazy_predicate"] = lazy_predicate;
+    res["lazy_predicate_rows"] = lazy_predicate_rows;
+    res["search_strategy"] = search_strategy;
+    res["exprs"] = json::array();
+    for (auto& expr : exprs) {
+        json node;
+        node["expr"] = expr.expr;
+        node["depth"] = expr.depth;
+        node["rows_out"] = expr.rows_out;
+        node["path"] = expr.path();
+        node["ns"] = expr.ns;
+        res["exprs"].push_back(std::move(node));
+    }
+    res["phases"] = json::array();
+    for (auto& [phase, ns] : phases) {
+        res["phases"].push_back({{"phase", phase}, {"ns", ns}});
+    }
+    return res.dump();
+}
+
+}  // namespace milvus
@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+
+// how one expr node of the filter ran, every node is evaluated on all the rows of the segment
+struct ExprProfile {
+    std::string expr;
+    // depth in the expr tree, nodes are recorded in pre-order
+    int depth = 0;
+    int64_t rows_out = 0;
+    // chunks evaluated through a scalar index or by scanning raw data
+    int64_t index_chunks = 0;
+    int64_t raw_data_chunks = 0;
+    bool udf = false;
+    int64_t ns = 0;
+
+    // "index", "raw_data", "index+raw_data", "udf", or "none" for logical nodes
+    std::string
+    path() const;
+};
+
+// execution profile ("explain analyze") of a search or retrieve on one segment,
+// only collected when asked for, see SearchWithProfile/RetrieveWithProfile in segment_c.h
+struct QueryProfile {
+    std::vector<ExprProfile> exprs;
+    // the filter result was served by the predicate cache, exprs is empty then
+    bool predicate_cache_hit = false;
+    // the filter was evaluated lazily on the candidates of the search, on lazy_predicate_rows rows
+    bool lazy_predicate = false;
+    int64_t lazy_predicate_rows = 0;
+    // how the vectors were searched: "vector_search" (index or brute force, as the segment has it),
+    // "exact_on_survivors" (brute force over the few rows passing the filter) or "lazy_predicate"
+    std::string search_strategy;
+    // (phase, ns) in execution order
+    std::vector<std::pair<std::string, int64_t>> phases;
+
+    void
+    AddPhase(std::string phase, int64_t ns) {
+        phases.emplace_back(std::move(phase), ns);
+    }
+
+    std::string
+    ToJson() const;
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+// record the time until destruction as a phase of profile, does nothing if profile is nullptr
+class ProfilePhase {
+ public:
+    ProfilePhase(QueryProfile* profile, const char* phase) : profile_(profile), phase_(phase) {
+        if (profile_ != nullptr) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ProfilePhase(const ProfilePhase&) = delete;
+    ProfilePhase&
+    operator=(const ProfilePhase&) = delete;
+
+    ~ProfilePhase() {
+        if (profile_ != nullptr) {
+            auto duration = std::chrono::steady_clock::now() - start_;
+            profile_->AddPhase(phase_, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+    }
+
+ private:
+    QueryProfile* profile_;
+    const char* phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace milvus
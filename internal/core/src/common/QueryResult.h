@@ -23,10 +23,10 @@
 #include <utility>
 #include <vector>
 #include <boost/align/aligned_allocator.hpp>
-#include <boost/dynamic_bitset.hpp>
 #include <NamedType/named_type.hpp>
 
 #include "common/FieldMeta.h"
+#include "common/QueryProfile.h"
 #include "pb/schema.pb.h"
 
 namespace milvus {
@@ -65,6 +65,9 @@ struct SearchResult {
 
     // used for reduce, filter invalid pk, get real topks count
     std::vector<size_t> topk_per_nq_prefix_sum_;
+
+    // execution profile, only set if asked for when searching
+    QueryProfilePtr profile_;
 };
 
 using SearchResultPtr = std::shared_ptr<SearchResult>;
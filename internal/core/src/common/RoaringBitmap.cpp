@@ -0,0 +1,268 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <cassert>
+
+#include "common/RoaringBitmap.h"
+
+namespace milvus {
+
+bool
+RoaringBitmap::Container::test(uint16_t low) const {
+    if (is_bitmap()) {
+        return (words[low / 64] >> (low % 64)) & 1;
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void
+RoaringBitmap::Container::set(uint16_t low, bool value, size_t num_words) {
+    if (is_bitmap()) {
+        auto& word = words[low / 64];
+        auto mask = uint64_t(1) << (low % 64);
+        if (bool(word & mask) == value) {
+            return;
+        }
+        word ^= mask;
+        if (value) {
+            ++cardinality;
+        } else if (--cardinality <= max_array_cardinality(num_words)) {
+            to_array();
+        }
+        return;
+    }
+
+    auto iter = std::lower_bound(array.begin(), array.end(), low);
+    auto found = iter != array.end() && *iter == low;
+    if (found == value) {
+        return;
+    }
+    if (value) {
+        array.insert(iter, low);
+        ++cardinality;
+        if (cardinality > max_array_cardinality(num_words)) {
+            to_bitmap(num_words);
+        }
+    } else {
+        array.erase(iter);
+        --cardinality;
+    }
+}
+
+void
+RoaringBitmap::Container::to_bitmap(size_t num_words) {
+    words.assign(num_words, 0);
+    for (auto low : array) {
+        words[low / 64] |= uint64_t(1) << (low % 64);
+    }
+    std::vector<uint16_t>().swap(array);
+}
+
+void
+RoaringBitmap::Container::to_array() {
+    std::vector<uint16_t> res;
+    res.reserve(cardinality);
+    for (size_t i = 0; i < words.size(); ++i) {
+        for (auto word = words[i]; word != 0; word &= word - 1) {
+            res.push_back(i * 64 + __builtin_ctzll(word));
+        }
+    }
+    array.swap(res);
+    std::vector<uint64_t>().swap(words);
+}
+
+std::vector<RoaringBitmap::Container>::iterator
+RoaringBitmap::lower_bound(uint32_t key) {
+    return std::lower_bound(containers_.begin(), containers_.end(), key,
+                            [](const Container& container, uint32_t key) { return container.key < key; });
+}
+
+std::vector<RoaringBitmap::Container>::const_iterator
+RoaringBitmap::lower_bound(uint32_t key) const {
+    return std::lower_bound(containers_.begin(), containers_.end(), key,
+                            [](const Container& container, uint32_t key) { return container.key < key; });
+}
+
+RoaringBitmap
+RoaringBitmap::FromBitset(const Bitset& bitset) {
+    RoaringBitmap res(bitset.size());
+    auto blocks = bitset.blocks();
+    auto num_blocks = bitset.num_blocks();
+    for (size_t begin = 0; begin < num_blocks; begin += words_per_container) {
+        auto end = std::min(begin + words_per_container, num_blocks);
+        size_t cardinality = 0;
+        for (auto i = begin; i < end; ++i) {
+            cardinality += __builtin_popcountll(blocks[i]);
+        }
+        if (cardinality == 0) {
+            continue;
+        }
+
+        Container container;
+        container.key = begin / words_per_container;
+        container.cardinality = cardinality;
+        if (cardinality > max_array_cardinality(end - begin)) {
+            container.words.assign(blocks + begin, blocks + end);
+        } else {
+            container.array.reserve(cardinality);
+            for (auto i = begin; i < end; ++i) {
+                for (auto word = blocks[i]; word != 0; word &= word - 1) {
+                    container.array.push_back((i - begin) * 64 + __builtin_ctzll(word));
+                }
+            }
+        }
+        res.containers_.push_back(std::move(container));
+    }
+    return res;
+}
+
+void
+RoaringBitmap::resize(size_t num_bits) {
+    if (num_bits >= num_bits_) {
+        num_bits_ = num_bits;
+        // the last chunk may get longer
+        if (!containers_.empty() && containers_.back().is_bitmap()) {
+            auto& container = containers_.back();
+            container.words.resize(container_words(container.key), 0);
+            if (container.cardinality <= max_array_cardinality(container.words.size())) {
+                container.to_array();
+            }
+        }
+        return;
+    }
+    num_bits_ = num_bits;
+
+    uint32_t key = num_bits / bits_per_container;
+    auto low_limit = num_bits % bits_per_container;
+    auto iter = lower_bound(key);
+    if (iter != containers_.end() && iter->key == key && low_limit != 0) {
+        auto& container = *iter;
+        if (container.is_bitmap()) {
+            container.words.resize(container_words(key));
+            if (low_limit % 64 != 0) {
+                container.words.back() &= (uint64_t(1) << (low_limit % 64)) - 1;
+            }
+            container.cardinality = 0;
+            for (auto word : container.words) {
+                container.cardinality += __builtin_popcountll(word);
+            }
+            if (container.cardinality <= max_array_cardinality(container.words.size())) {
+                container.to_array();
+            }
+        } else {
+            auto tail = std::lower_bound(container.array.begin(), container.array.end(), low_limit);
+            container.array.erase(tail, container.array.end());
+            container.cardinality = container.array.size();
+        }
+        if (container.cardinality != 0) {
+            ++iter;
+        }
+    }
+    containers_.erase(iter, containers_.end());
+}
+
+bool
+RoaringBitmap::test(size_t pos) const {
+    if (pos >= num_bits_) {
+        return false;
+    }
+    uint32_t key = pos / bits_per_container;
+    auto iter = lower_bound(key);
+    if (iter == containers_.end() || iter->key != key) {
+        return false;
+    }
+    return iter->test(pos % bits_per_container);
+}
+
+void
+RoaringBitmap::set(size_t pos, bool value) {
+    assert(pos < num_bits_);
+    uint32_t key = pos / bits_per_container;
+    auto iter = lower_bound(key);
+    if (iter == containers_.end() || iter->key != key) {
+        if (!value) {
+            return;
+        }
+        Container container;
+        container.key = key;
+        iter = containers_.insert(iter, std::move(container));
+    }
+    iter->set(pos % bits_per_container, value, container_words(key));
+    if (iter->cardinality == 0) {
+        containers_.erase(iter);
+    }
+}
+
+size_t
+RoaringBitmap::count() const {
+    size_t res = 0;
+    for (auto& container : containers_) {
+        res += container.cardinality;
+    }
+    return res;
+}
+
+size_t
+RoaringBitmap::memory_bytes() const {
+    size_t res = sizeof(RoaringBitmap) + (containers_.capacity() - containers_.size()) * sizeof(Container);
+    for (auto& container : containers_) {
+        res += container.memory_bytes();
+    }
+    return res;
+}
+
+Bitset
+RoaringBitmap::ToBitset() const {
+    Bitset res(num_bits_);
+    OrInto(res);
+    return res;
+}
+
+void
+RoaringBitmap::OrInto(Bitset& dense) const {
+    assert(dense.size() == num_bits_);
+    auto blocks = dense.blocks();
+    auto num_blocks = dense.num_blocks();
+    for (auto& container : containers_) {
+        auto first_block = size_t(container.key) * words_per_container;
+        if (container.is_bitmap()) {
+            // containers are block aligned, so whole words are or-ed in
+            auto n = std::min(container.words.size(), num_blocks - first_block);
+            for (size_t i = 0; i < n; ++i) {
+                blocks[first_block + i] |= container.words[i];
+            }
+        } else {
+            auto base = first_block * Bitset::bits_per_block;
+            for (auto low : container.array) {
+                dense.set(base + low);
+            }
+        }
+    }
+}
+
+bool
+RoaringBitmap::operator==(const RoaringBitmap& other) const {
+    if (num_bits_ != other.num_bits_ || containers_.size() != other.containers_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < containers_.size(); ++i) {
+        auto& lhs = containers_[i];
+        auto& rhs = other.containers_[i];
+        if (lhs.key != rhs.key || lhs.cardinality != rhs.cardinality || lhs.array != rhs.array ||
+            lhs.words != rhs.words) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace milvus
@@ -0,0 +1,154 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/Bitset.h"
+
+namespace milvus {
+
+// Compressed bitset of size() bits, in the style of Roaring bitmaps.
+// Bits are split into chunks of 65536 by the high bits of the position, and each non-empty chunk
+// is kept either as a sorted array of 16-bit low positions (2 bytes per set bit) or as a plain
+// bitmap (8KB, less for the last chunk), whichever is smaller; the representation is switched as
+// bits change.
+// Empty chunks take no memory, so sparse masks cost a few bytes per set bit instead of size() / 8.
+// Use ToBitset()/OrInto() to get the dense layout required by knowhere.
+class RoaringBitmap {
+ public:
+    static constexpr size_t bits_per_container = 1 << 16;
+
+    RoaringBitmap() = default;
+
+    explicit RoaringBitmap(size_t num_bits) : num_bits_(num_bits) {
+    }
+
+    static RoaringBitmap
+    FromBitset(const Bitset& bitset);
+
+    size_t
+    size() const {
+        return num_bits_;
+    }
+
+    // set bits at or past num_bits are dropped
+    void
+    resize(size_t num_bits);
+
+    bool
+    test(size_t pos) const;
+
+    void
+    set(size_t pos, bool value = true);
+
+    void
+    reset(size_t pos) {
+        set(pos, false);
+    }
+
+    void
+    clear() {
+        containers_.clear();
+        num_bits_ = 0;
+    }
+
+    size_t
+    count() const;
+
+    bool
+    none() const {
+        return containers_.empty();
+    }
+
+    size_t
+    memory_bytes() const;
+
+    Bitset
+    ToBitset() const;
+
+    // dense |= *this, both of size()
+    void
+    OrInto(Bitset& dense) const;
+
+    bool
+    operator==(const RoaringBitmap& other) const;
+
+    bool
+    operator!=(const RoaringBitmap& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    struct Container {
+        uint32_t key = 0;
+        uint32_t cardinality = 0;
+        // sorted low 16 bits of the set positions, used while cardinality <= max_array_cardinality()
+        std::vector<uint16_t> array;
+        // the bits of the chunk, used otherwise
+        std::vector<uint64_t> words;
+
+        bool
+        is_bitmap() const {
+            return !words.empty();
+        }
+
+        bool
+        test(uint16_t low) const;
+
+        // num_words is the bitmap length of this chunk
+        void
+        set(uint16_t low, bool value, size_t num_words);
+
+        void
+        to_bitmap(size_t num_words);
+
+        void
+        to_array();
+
+        size_t
+        memory_bytes() const {
+            return sizeof(Container) + array.capacity() * sizeof(uint16_t) + words.capacity() * sizeof(uint64_t);
+        }
+    };
+
+    static constexpr size_t words_per_container = bits_per_container / Bitset::bits_per_block;
+
+    // an array is smaller than a bitmap of num_words below this
+    static size_t
+    max_array_cardinality(size_t num_words) {
+        return num_words * sizeof(uint64_t) / sizeof(uint16_t);
+    }
+
+    // bitmap length of the chunk key, the last chunk only covers up to size()
+    size_t
+    container_words(uint32_t key) const {
+        auto first_bit = size_t(key) * bits_per_container;
+        return std::min(words_per_container, (num_bits_ - first_bit + Bitset::bits_per_block - 1) / Bitset::bits_per_block);
+    }
+
+    std::vector<Container>::iterator
+    lower_bound(uint32_t key);
+
+    std::vector<Container>::const_iterator
+    lower_bound(uint32_t key) const;
+
+ private:
+    // sorted by key, no empty container
+    std::vector<Container> containers_;
+    size_t num_bits_ = 0;
+};
+
+}  // namespace milvus
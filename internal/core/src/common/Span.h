@@ -19,6 +19,7 @@
 #include <cassert>
 #include <type_traits>
 #include <string>
+#include <string_view>
 
 #include "Types.h"
 #include "VectorTrait.h"
@@ -57,7 +58,8 @@ class Span;
 
 // TODO: refine Span to support T=FloatVector
 template <typename T>
-class Span<T, typename std::enable_if_t<IsScalar<T> || std::is_same_v<T, PkType>>> {
+class Span<T,
+           typename std::enable_if_t<IsScalar<T> || std::is_same_v<T, PkType> || std::is_same_v<T, std::string_view>>> {
  public:
     using embeded_type = T;
     explicit Span(const T* data, int64_t row_count) : data_(data), row_count_(row_count) {
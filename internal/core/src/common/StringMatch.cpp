@@ -0,0 +1,80 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/StringMatch.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus {
+
+void
+StringMatcher::Anchor::Init(std::string str, bool at_end) {
+    literal = std::move(str);
+    word = 0;
+    mask = 0;
+    if (literal.empty() || literal.size() > sizeof(uint64_t)) {
+        return;
+    }
+    // lay out the literal as it sits in the 8 bytes loaded at the start or the end of the string
+    char word_bytes[sizeof(uint64_t)] = {};
+    char mask_bytes[sizeof(uint64_t)] = {};
+    auto pos = at_end ? sizeof(uint64_t) - literal.size() : 0;
+    memcpy(word_bytes + pos, literal.data(), literal.size());
+    memset(mask_bytes + pos, 0xff, literal.size());
+    memcpy(&word, word_bytes, sizeof(word));
+    memcpy(&mask, mask_bytes, sizeof(mask));
+}
+
+StringMatcher::StringMatcher(OpType op, std::string_view operand) {
+    switch (op) {
+        case OpType::PrefixMatch: {
+            prefix_.Init(std::string(operand), false);
+            break;
+        }
+        case OpType::PostfixMatch: {
+            suffix_.Init(std::string(operand), true);
+            break;
+        }
+        case OpType::Match: {
+            std::vector<std::string> literals(1);
+            for (size_t i = 0; i < operand.size(); ++i) {
+                if (operand[i] == '\\' && i + 1 < operand.size()) {
+                    literals.back().push_back(operand[++i]);
+                } else if (operand[i] == '%') {
+                    literals.emplace_back();
+                } else {
+                    literals.back().push_back(operand[i]);
+                }
+            }
+            has_wildcard_ = literals.size() > 1;
+            if (!has_wildcard_) {
+                prefix_.literal = std::move(literals.front());
+                break;
+            }
+            prefix_.Init(std::move(literals.front()), false);
+            suffix_.Init(std::move(literals.back()), true);
+            for (size_t i = 1; i + 1 < literals.size(); ++i) {
+                if (!literals[i].empty()) {
+                    infixes_.push_back(std::move(literals[i]));
+                }
+            }
+            break;
+        }
+        default: {
+            PanicInfo("unsupported string match op: " + std::to_string(op));
+        }
+    }
+    min_size_ = prefix_.literal.size() + suffix_.literal.size();
+    for (auto& infix : infixes_) {
+        min_size_ += infix.size();
+    }
+}
+
+}  // namespace milvus
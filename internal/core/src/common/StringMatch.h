@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus {
+
+inline bool
+PrefixMatch(std::string_view str, std::string_view prefix) {
+    return str.size() >= prefix.size() && memcmp(str.data(), prefix.data(), prefix.size()) == 0;
+}
+
+inline bool
+PostfixMatch(std::string_view str, std::string_view postfix) {
+    return str.size() >= postfix.size() &&
+           memcmp(str.data() + str.size() - postfix.size(), postfix.data(), postfix.size()) == 0;
+}
+
+// Checks strings in place against the operand of a PrefixMatch, PostfixMatch or Match expr, the operand of
+// Match is a LIKE pattern where '%' matches any sequence of characters and '\' escapes the next character.
+// The operand is parsed once, so build one matcher per expr rather than per row.
+class StringMatcher {
+ public:
+    StringMatcher(OpType op, std::string_view operand);
+
+    bool
+    operator()(std::string_view str) const {
+        if (!has_wildcard_) {
+            return str == prefix_.literal;
+        }
+        if (str.size() < min_size_ || !prefix_.MatchPrefix(str) || !suffix_.MatchSuffix(str)) {
+            return false;
+        }
+        auto rest = str.substr(prefix_.literal.size(), str.size() - prefix_.literal.size() - suffix_.literal.size());
+        for (auto& infix : infixes_) {
+            auto pos = rest.find(infix);
+            if (pos == std::string_view::npos) {
+                return false;
+            }
+            rest.remove_prefix(pos + infix.size());
+        }
+        return true;
+    }
+
+ private:
+    // a literal anchored at the start or the end of the string. Literals of at most 8 bytes are checked
+    // with one masked 8-byte load when the string is long enough, which beats a memcmp call per row
+    struct Anchor {
+        std::string literal;
+        uint64_t word = 0;
+        uint64_t mask = 0;
+
+        void
+        Init(std::string str, bool at_end);
+
+        bool
+        MatchPrefix(std::string_view str) const {
+            if (mask != 0 && str.size() >= sizeof(uint64_t)) {
+                uint64_t loaded;
+                memcpy(&loaded, str.data(), sizeof(loaded));
+                return (loaded & mask) == word;
+            }
+            return PrefixMatch(str, literal);
+        }
+
+        bool
+        MatchSuffix(std::string_view str) const {
+            if (mask != 0 && str.size() >= sizeof(uint64_t)) {
+                uint64_t loaded;
+                memcpy(&loaded, str.data() + str.size() - sizeof(loaded), sizeof(loaded));
+                return (loaded & mask) == word;
+            }
+            return PostfixMatch(str, literal);
+        }
+    };
+
+    // pattern is prefix_ % infixes_[0] % ... % suffix_, or exactly prefix_ if it has no wildcard
+    bool has_wildcard_ = true;
+    Anchor prefix_;
+    Anchor suffix_;
+    std::vector<std::string> infixes_;
+    size_t min_size_ = 0;
+};
+
+}  // namespace milvus
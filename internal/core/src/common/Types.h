@@ -26,10 +26,10 @@
 #include <tbb/concurrent_unordered_set.h>
 #include <boost/align/aligned_allocator.hpp>
 #include <boost/container/vector.hpp>
-#include <boost/dynamic_bitset.hpp>
 #include <NamedType/named_type.hpp>
 #include <variant>
 
+#include "common/Bitset.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include <knowhere/index/IndexType.h>
 #include "knowhere/common/BinarySet.h"
@@ -105,15 +105,15 @@ using FieldName = fluent::NamedType<std::string, impl::FieldNameTag, fluent::Com
 // using FieldOffset = fluent::NamedType<int64_t, impl::FieldOffsetTag, fluent::Comparable, fluent::Hashable>;
 using SegOffset = fluent::NamedType<int64_t, impl::SegOffsetTag, fluent::Arithmetic>;
 
-using BitsetType = boost::dynamic_bitset<>;
-using BitsetTypePtr = std::shared_ptr<boost::dynamic_bitset<>>;
+using BitsetType = Bitset;
+using BitsetTypePtr = std::shared_ptr<BitsetType>;
 using BitsetTypeOpt = std::optional<BitsetType>;
 
 template <typename Type>
 using FixedVector = boost::container::vector<Type>;
 
 using Config = nlohmann::json;
-using TargetBitmap = boost::dynamic_bitset<>;
+using TargetBitmap = Bitset;
 using TargetBitmapPtr = std::unique_ptr<TargetBitmap>;
 
 using BinarySet = knowhere::BinarySet;
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "common/Consts.h"
+#include "common/StringMatch.h"
 #include "config/ConfigChunkManager.h"
 #include "exceptions/EasyAssert.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -52,38 +53,6 @@ GetDatasetDim(const DatasetPtr& dataset) {
     return knowhere::GetDatasetDim(dataset);
 }
 
-inline bool
-PrefixMatch(const std::string& str, const std::string& prefix) {
-    auto ret = strncmp(str.c_str(), prefix.c_str(), prefix.length());
-    if (ret != 0) {
-        return false;
-    }
-
-    return true;
-}
-
-inline bool
-PostfixMatch(const std::string& str, const std::string& postfix) {
-    if (postfix.length() > str.length()) {
-        return false;
-    }
-
-    int offset = str.length() - postfix.length();
-    auto ret = strncmp(str.c_str() + offset, postfix.c_str(), postfix.length());
-    if (ret != 0) {
-        return false;
-    }
-    //
-    //    int i = postfix.length() - 1;
-    //    int j = str.length() - 1;
-    //    for (; i >= 0; i--, j--) {
-    //        if (postfix[i] != str[j]) {
-    //            return false;
-    //        }
-    //    }
-    return true;
-}
-
 inline int64_t
 upper_align(int64_t value, int64_t align) {
     Assert(align > 0);
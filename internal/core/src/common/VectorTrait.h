@@ -17,6 +17,7 @@
 #pragma once
 #include "Types.h"
 #include <string>
+#include <string_view>
 
 namespace milvus {
 
@@ -80,4 +81,13 @@ struct TagDispatchTrait<std::string> {
     using Tag = StringTag;
 };
 
+template <>
+struct TagDispatchTrait<std::string_view> {
+    using Tag = StringTag;
+};
+
+// the type a column of T is read as in place, string columns are stored packed and read as string_view
+template <typename T>
+using ChunkViewType = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
 }  // namespace milvus
@@ -0,0 +1,264 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/StringMatch.h"
+#include "exceptions/EasyAssert.h"
+#include "index/Meta.h"
+
+namespace milvus::index {
+
+template <typename T>
+inline void
+BitmapIndex<T>::Build(size_t n, const T* values) {
+    if (is_built_) {
+        return;
+    }
+    values_.assign(values, values + n);
+    std::sort(values_.begin(), values_.end());
+    values_.erase(std::unique(values_.begin(), values_.end()), values_.end());
+    if (values_.size() > max_cardinality) {
+        throw std::invalid_argument("too many distinct values for bitmap index: " + std::to_string(values_.size()));
+    }
+    value_ids_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        value_ids_[i] = Find(values[i]);
+    }
+    BuildBitmaps();
+    is_built_ = true;
+}
+
+template <typename T>
+inline void
+BitmapIndex<T>::BuildBitmaps() {
+    bitmaps_.assign(values_.size(), RoaringBitmap(value_ids_.size()));
+    for (size_t i = 0; i < value_ids_.size(); ++i) {
+        bitmaps_[value_ids_[i]].set(i);
+    }
+}
+
+template <typename T>
+inline BinarySet
+BitmapIndex<T>::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    // the bitmaps are rebuilt from the value of each row on load
+    std::shared_ptr<uint8_t[]> values_data;
+    size_t values_size = 0;
+    if constexpr (std::is_same_v<T, std::string>) {
+        for (auto& value : values_) {
+            values_size += sizeof(uint32_t) + value.size();
+        }
+        values_data.reset(new uint8_t[values_size]);
+        auto ptr = values_data.get();
+        for (auto& value : values_) {
+            uint32_t length = value.size();
+            memcpy(ptr, &length, sizeof(length));
+            memcpy(ptr + sizeof(length), value.data(), length);
+            ptr += sizeof(length) + length;
+        }
+    } else {
+        values_size = values_.size() * sizeof(Value);
+        values_data.reset(new uint8_t[values_size]);
+        memcpy(values_data.get(), values_.data(), values_size);
+    }
+
+    auto ids_size = value_ids_.size() * sizeof(uint16_t);
+    std::shared_ptr<uint8_t[]> ids_data(new uint8_t[ids_size]);
+    memcpy(ids_data.get(), value_ids_.data(), ids_size);
+
+    BinarySet res_set;
+    res_set.Append(BITMAP_INDEX_VALUES, values_data, values_size);
+    res_set.Append(BITMAP_INDEX_IDS, ids_data, ids_size);
+    return res_set;
+}
+
+template <typename T>
+inline void
+BitmapIndex<T>::Load(const BinarySet& index_binary, const Config& config) {
+    auto values_data = index_binary.GetByName(BITMAP_INDEX_VALUES);
+    values_.clear();
+    if constexpr (std::is_same_v<T, std::string>) {
+        auto ptr = values_data->data.get();
+        auto end = ptr + values_data->size;
+        while (ptr < end) {
+            uint32_t length;
+            memcpy(&length, ptr, sizeof(length));
+            values_.emplace_back(reinterpret_cast<const char*>(ptr + sizeof(length)), length);
+            ptr += sizeof(length) + length;
+        }
+    } else {
+        values_.resize(values_data->size / sizeof(Value));
+        memcpy(values_.data(), values_data->data.get(), values_data->size);
+    }
+
+    auto ids_data = index_binary.GetByName(BITMAP_INDEX_IDS);
+    value_ids_.resize(ids_data->size / sizeof(uint16_t));
+    memcpy(value_ids_.data(), ids_data->data.get(), ids_data->size);
+    BuildBitmaps();
+    is_built_ = true;
+}
+
+template <typename T>
+inline size_t
+BitmapIndex<T>::Find(const T& value) const {
+    auto it = std::lower_bound(values_.begin(), values_.end(), value);
+    if (it == values_.end() || *it != value) {
+        return values_.size();
+    }
+    return it - values_.begin();
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+BitmapIndex<T>::RowsOf(size_t begin, size_t end) const {
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(value_ids_.size());
+    if (begin >= end) {
+        return bitset;
+    }
+    // OR the fewer bitmaps, those outside the range then flip when it covers most values
+    if ((end - begin) * 2 > values_.size()) {
+        for (size_t i = 0; i < begin; ++i) {
+            bitmaps_[i].OrInto(*bitset);
+        }
+        for (size_t i = end; i < values_.size(); ++i) {
+            bitmaps_[i].OrInto(*bitset);
+        }
+        bitset->flip();
+    } else {
+        for (size_t i = begin; i < end; ++i) {
+            bitmaps_[i].OrInto(*bitset);
+        }
+    }
+    return bitset;
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+BitmapIndex<T>::In(size_t n, const T* values) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(value_ids_.size());
+    for (size_t i = 0; i < n; ++i) {
+        auto pos = Find(values[i]);
+        if (pos < values_.size()) {
+            bitmaps_[pos].OrInto(*bitset);
+        }
+    }
+    return bitset;
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+BitmapIndex<T>::NotIn(size_t n, const T* values) {
+    auto bitset = In(n, values);
+    bitset->flip();
+    return bitset;
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+BitmapIndex<T>::Range(T value, OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    size_t begin = 0;
+    size_t end = values_.size();
+    switch (op) {
+        case OpType::LessThan:
+            end = std::lower_bound(values_.begin(), values_.end(), value) - values_.begin();
+            break;
+        case OpType::LessEqual:
+            end = std::upper_bound(values_.begin(), values_.end(), value) - values_.begin();
+            break;
+        case OpType::GreaterThan:
+            begin = std::upper_bound(values_.begin(), values_.end(), value) - values_.begin();
+            break;
+        case OpType::GreaterEqual:
+            begin = std::lower_bound(values_.begin(), values_.end(), value) - values_.begin();
+            break;
+        default:
+            throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
+    }
+    return RowsOf(begin, end);
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+BitmapIndex<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    if (lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
+        return std::make_unique<TargetBitmap>(value_ids_.size());
+    }
+    auto begin = lb_inclusive ? std::lower_bound(values_.begin(), values_.end(), lower_bound_value)
+                              : std::upper_bound(values_.begin(), values_.end(), lower_bound_value);
+    auto end = ub_inclusive ? std::upper_bound(values_.begin(), values_.end(), upper_bound_value)
+                            : std::lower_bound(values_.begin(), values_.end(), upper_bound_value);
+    return RowsOf(begin - values_.begin(), end - values_.begin());
+}
+
+template <typename T>
+inline T
+BitmapIndex<T>::Reverse_Lookup(size_t offset) const {
+    AssertInfo(offset < value_ids_.size(), "out of range of total count");
+    return values_[value_ids_[offset]];
+}
+
+template <typename T>
+inline void
+BitmapIndex<T>::ReverseLookup(const int64_t* offsets, int64_t n, T* out) const {
+    auto count = static_cast<int64_t>(value_ids_.size());
+    for (int64_t i = 0; i < n; ++i) {
+        AssertInfo(offsets[i] >= 0 && offsets[i] < count, "out of range of total count");
+        out[i] = values_[value_ids_[offsets[i]]];
+    }
+}
+
+template <typename T>
+inline void
+BitmapIndex<T>::ReverseLookupRange(int64_t begin, int64_t n, T* out) const {
+    AssertInfo(begin >= 0 && n >= 0 && begin + n <= static_cast<int64_t>(value_ids_.size()),
+               "out of range of total count");
+    auto ids = value_ids_.data() + begin;
+    for (int64_t i = 0; i < n; ++i) {
+        out[i] = values_[ids[i]];
+    }
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+BitmapIndex<T>::Query(const DatasetPtr& dataset) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        auto op = dataset->Get<OpType>(OPERATOR_TYPE);
+        if (op == OpType::PrefixMatch || op == OpType::PostfixMatch || op == OpType::Match) {
+            auto operand = dataset->Get<std::string>(op == OpType::PrefixMatch ? PREFIX_VALUE : MATCH_VALUE);
+            StringMatcher matcher(op, operand);
+            TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(value_ids_.size());
+            for (size_t i = 0; i < values_.size(); ++i) {
+                if (matcher(values_[i])) {
+                    bitmaps_[i].OrInto(*bitset);
+                }
+            }
+            return bitset;
+        }
+    }
+    return ScalarIndex<T>::Query(dataset);
+}
+
+}  // namespace milvus::index
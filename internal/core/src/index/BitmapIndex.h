@@ -0,0 +1,129 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "common/RoaringBitmap.h"
+#include "index/ScalarIndex.h"
+
+namespace milvus::index {
+
+// fields with at most this many distinct values get a bitmap index when no index type is asked for
+constexpr size_t DEFAULT_BITMAP_CARDINALITY_LIMIT = 256;
+
+// Index for low-cardinality fields (bool, status codes, categories): one compressed bitmap per distinct
+// value, so In/NotIn/Range are ORs of a few bitmaps instead of setting the matched rows one by one.
+template <typename T>
+class BitmapIndex : public ScalarIndex<T> {
+ public:
+    // the position of the value of each row is kept in 16 bits
+    static constexpr size_t max_cardinality = 1 << 16;
+
+    BitmapIndex() = default;
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    int64_t
+    Count() override {
+        return value_ids_.size();
+    }
+
+    void
+    Build(size_t n, const T* values) override;
+
+    const TargetBitmapPtr
+    In(size_t n, const T* values) override;
+
+    const TargetBitmapPtr
+    NotIn(size_t n, const T* values) override;
+
+    const TargetBitmapPtr
+    Range(T value, OpType op) override;
+
+    const TargetBitmapPtr
+    Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) override;
+
+    T
+    Reverse_Lookup(size_t offset) const override;
+
+    void
+    ReverseLookup(const int64_t* offsets, int64_t n, T* out) const override;
+
+    void
+    ReverseLookupRange(int64_t begin, int64_t n, T* out) const override;
+
+    // adds prefix, postfix and pattern match for strings, each distinct string is checked once
+    const TargetBitmapPtr
+    Query(const DatasetPtr& dataset) override;
+
+    int64_t
+    Size() override {
+        return Count();
+    }
+
+    size_t
+    Cardinality() const {
+        return values_.size();
+    }
+
+ private:
+    // bool is kept as uint8_t, std::vector<bool> has no contiguous storage
+    using Value = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+    // rows holding one of values_[begin, end)
+    const TargetBitmapPtr
+    RowsOf(size_t begin, size_t end) const;
+
+    // position of value in values_, values_.size() if absent
+    size_t
+    Find(const T& value) const;
+
+    void
+    BuildBitmaps();
+
+ private:
+    // sorted distinct values and the rows holding each of them
+    std::vector<Value> values_;
+    std::vector<RoaringBitmap> bitmaps_;
+    // position in values_ of the value of each row, for Reverse_Lookup
+    std::vector<uint16_t> value_ids_;
+    bool is_built_ = false;
+};
+
+template <typename T>
+using BitmapIndexPtr = std::unique_ptr<BitmapIndex<T>>;
+
+}  // namespace milvus::index
+
+#include "index/BitmapIndex-inl.h"
+
+namespace milvus::index {
+template <typename T>
+inline BitmapIndexPtr<T>
+CreateBitmapIndex() {
+    return std::make_unique<BitmapIndex<T>>();
+}
+}  // namespace milvus::index
@@ -18,12 +18,12 @@
 
 #include <vector>
 #include <memory>
-#include "index/ScalarIndexSort.h"
+#include "index/BitmapIndex.h"
 
 namespace milvus::index {
 
-//// TODO: optimize here.
-class BoolIndex : public ScalarIndexSort<bool> {};
+// a bool field has at most two distinct values, the bitmap of each is all the index needs
+class BoolIndex : public BitmapIndex<bool> {};
 using BoolIndexPtr = std::shared_ptr<BoolIndex>;
 
 inline BoolIndexPtr
@@ -17,7 +17,6 @@
 #pragma once
 
 #include <memory>
-#include <boost/dynamic_bitset.hpp>
 
 #include "common/Types.h"
 
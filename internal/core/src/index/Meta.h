@@ -27,9 +27,15 @@ constexpr const char* LOWER_BOUND_INCLUSIVE = "lower_bound_inclusive";
 constexpr const char* UPPER_BOUND_VALUE = "upper_bound_value";
 constexpr const char* UPPER_BOUND_INCLUSIVE = "upper_bound_inclusive";
 constexpr const char* PREFIX_VALUE = "prefix_value";
+// operand of PostfixMatch, or the LIKE pattern of Match
+constexpr const char* MATCH_VALUE = "match_value";
 // below configurations will be persistent, do not edit them.
 constexpr const char* MARISA_TRIE_INDEX = "marisa_trie_index";
 constexpr const char* MARISA_STR_IDS = "marisa_trie_str_ids";
+constexpr const char* BITMAP_INDEX_VALUES = "bitmap_index_values";
+constexpr const char* BITMAP_INDEX_IDS = "bitmap_index_ids";
+constexpr const char* SORT_INDEX_VALUES = "sort_index_values";
+constexpr const char* SORT_INDEX_ROW_IDS = "sort_index_row_ids";
 
 constexpr const char* INDEX_TYPE = "index_type";
 constexpr const char* INDEX_MODE = "index_mode";
@@ -38,6 +44,9 @@ constexpr const char* METRIC_TYPE = "metric_type";
 // scalar index type
 constexpr const char* ASCENDING_SORT = "STL_SORT";
 constexpr const char* MARISA_TRIE = "Trie";
+constexpr const char* BITMAP_INDEX = "BITMAP";
+// max number of distinct values of a field to pick a bitmap index for it automatically
+constexpr const char* BITMAP_CARDINALITY_LIMIT = "bitmap_cardinality_limit";
 
 // index meta
 constexpr const char* COLLECTION_ID = "collection_id";
@@ -62,6 +62,22 @@ ScalarIndex<T>::Query(const DatasetPtr& dataset) {
     }
 }
 
+template <typename T>
+void
+ScalarIndex<T>::ReverseLookup(const int64_t* offsets, int64_t n, T* out) const {
+    for (int64_t i = 0; i < n; ++i) {
+        out[i] = Reverse_Lookup(offsets[i]);
+    }
+}
+
+template <typename T>
+void
+ScalarIndex<T>::ReverseLookupRange(int64_t begin, int64_t n, T* out) const {
+    for (int64_t i = 0; i < n; ++i) {
+        out[i] = Reverse_Lookup(begin + i);
+    }
+}
+
 template <>
 inline void
 ScalarIndex<std::string>::BuildWithRawData(size_t n, const void* values, const Config& config) {
@@ -19,7 +19,6 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <boost/dynamic_bitset.hpp>
 #include "index/Index.h"
 #include "common/Types.h"
 #include "exceptions/EasyAssert.h"
@@ -56,6 +55,14 @@ class ScalarIndex : public IndexBase {
     virtual T
     Reverse_Lookup(size_t offset) const = 0;
 
+    // batch form of Reverse_Lookup, out[i] = Reverse_Lookup(offsets[i]) for i in [0, n)
+    virtual void
+    ReverseLookup(const int64_t* offsets, int64_t n, T* out) const;
+
+    // values of the rows [begin, begin + n) in row order, used to materialize a whole column
+    virtual void
+    ReverseLookupRange(int64_t begin, int64_t n, T* out) const;
+
     virtual const TargetBitmapPtr
     Query(const DatasetPtr& dataset);
 
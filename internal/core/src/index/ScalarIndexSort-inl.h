@@ -15,19 +15,25 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <pb/schema.pb.h>
 #include <vector>
 #include <string>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 #include "knowhere/common/Log.h"
 #include "Meta.h"
+#include "index/IndexStructure.h"
 #include "common/Utils.h"
 
 namespace milvus::index {
 
 template <typename T>
-inline ScalarIndexSort<T>::ScalarIndexSort() : is_built_(false), data_() {
+inline ScalarIndexSort<T>::ScalarIndexSort() : is_built_(false) {
 }
 
 template <typename T>
@@ -38,75 +44,184 @@ inline ScalarIndexSort<T>::ScalarIndexSort(const size_t n, const T* values) : is
 template <typename T>
 inline void
 ScalarIndexSort<T>::Build(const size_t n, const T* values) {
+    BuildFrom(n, values);
+}
+
+template <typename T>
+template <typename U>
+inline void
+ScalarIndexSort<T>::BuildFrom(const size_t n, const U* values) {
     if (is_built_)
         return;
     if (n == 0) {
         // todo: throw an exception
         throw std::invalid_argument("ScalarIndexSort cannot build null values!");
     }
-    data_.reserve(n);
-    idx_to_offsets_.resize(n);
-    T* p = const_cast<T*>(values);
-    for (size_t i = 0; i < n; ++i) {
-        data_.emplace_back(IndexStructure(*p++, i));
-    }
-    std::sort(data_.begin(), data_.end());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
+    AssertInfo(n <= std::numeric_limits<uint32_t>::max(), "too many rows for ScalarIndexSort");
+    // sealed segments have tens of millions of rows, so every pass over them runs in parallel
+    std::vector<std::pair<U, uint32_t>> data(n);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+            data[i] = std::make_pair(values[i], static_cast<uint32_t>(i));
+        }
+    });
+    tbb::parallel_sort(data.begin(), data.end());
+
+    std::shared_ptr<T[]> sorted_values(new T[n]);
+    std::shared_ptr<uint32_t[]> row_ids(new uint32_t[n]);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+            sorted_values[i] = T(std::move(data[i].first));
+            row_ids[i] = data[i].second;
+        }
+    });
+    values_ = std::move(sorted_values);
+    row_ids_ = std::move(row_ids);
+    count_ = n;
+    BuildPositions();
     is_built_ = true;
 }
 
+template <typename T>
+inline void
+ScalarIndexSort<T>::BuildPositions() {
+    positions_.resize(count_);
+    // row ids are a permutation, so each position is written once
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count_), [&](const tbb::blocked_range<size_t>& range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+            positions_[row_ids_[i]] = i;
+        }
+    });
+}
+
 template <typename T>
 inline BinarySet
 ScalarIndexSort<T>::Serialize(const Config& config) {
     AssertInfo(is_built_, "index has not been built");
 
-    auto index_data_size = data_.size() * sizeof(IndexStructure<T>);
-    std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
-    memcpy(index_data.get(), data_.data(), index_data_size);
+    std::shared_ptr<uint8_t[]> values_data;
+    size_t values_size = 0;
+    if constexpr (std::is_same_v<T, std::string>) {
+        for (size_t i = 0; i < count_; ++i) {
+            values_size += sizeof(uint32_t) + values_[i].size();
+        }
+        values_data.reset(new uint8_t[values_size]);
+        auto ptr = values_data.get();
+        for (size_t i = 0; i < count_; ++i) {
+            uint32_t length = values_[i].size();
+            memcpy(ptr, &length, sizeof(length));
+            memcpy(ptr + sizeof(length), values_[i].data(), length);
+            ptr += sizeof(length) + length;
+        }
+    } else {
+        values_size = count_ * sizeof(T);
+        values_data.reset(new uint8_t[values_size]);
+        memcpy(values_data.get(), values_.get(), values_size);
+    }
 
-    std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
-    auto index_size = data_.size();
-    memcpy(index_length.get(), &index_size, sizeof(size_t));
+    auto row_ids_size = count_ * sizeof(uint32_t);
+    std::shared_ptr<uint8_t[]> row_ids_data(new uint8_t[row_ids_size]);
+    memcpy(row_ids_data.get(), row_ids_.get(), row_ids_size);
 
     BinarySet res_set;
-    res_set.Append("index_data", index_data, index_data_size);
-    res_set.Append("index_length", index_length, sizeof(size_t));
+    res_set.Append(SORT_INDEX_VALUES, values_data, values_size);
+    res_set.Append(SORT_INDEX_ROW_IDS, row_ids_data, row_ids_size);
     return res_set;
 }
 
+// view the array of U in binary in place, or a copy of it if the buffer isn't aligned for U
+template <typename U>
+inline std::shared_ptr<const U[]>
+ViewBinaryAs(const knowhere::BinaryPtr& binary) {
+    auto data = binary->data.get();
+    if (reinterpret_cast<uintptr_t>(data) % alignof(U) == 0) {
+        return std::shared_ptr<const U[]>(binary->data, reinterpret_cast<const U*>(data));
+    }
+    std::shared_ptr<U[]> copy(new U[binary->size / sizeof(U)]);
+    memcpy(copy.get(), data, binary->size);
+    return copy;
+}
+
 template <typename T>
 inline void
 ScalarIndexSort<T>::Load(const BinarySet& index_binary, const Config& config) {
-    size_t index_size;
-    auto index_length = index_binary.GetByName("index_length");
-    memcpy(&index_size, index_length->data.get(), (size_t)index_length->size);
-
-    auto index_data = index_binary.GetByName("index_data");
-    data_.resize(index_size);
-    idx_to_offsets_.resize(index_size);
-    memcpy(data_.data(), index_data->data.get(), (size_t)index_data->size);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
+    if (!index_binary.Contains(SORT_INDEX_ROW_IDS)) {
+        LoadIndexStructures(index_binary);
+        return;
+    }
+    auto row_ids_data = index_binary.GetByName(SORT_INDEX_ROW_IDS);
+    count_ = row_ids_data->size / sizeof(uint32_t);
+    row_ids_ = ViewBinaryAs<uint32_t>(row_ids_data);
+
+    auto values_data = index_binary.GetByName(SORT_INDEX_VALUES);
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::shared_ptr<T[]> values(new T[count_]);
+        auto ptr = values_data->data.get();
+        for (size_t i = 0; i < count_; ++i) {
+            uint32_t length;
+            memcpy(&length, ptr, sizeof(length));
+            values[i].assign(reinterpret_cast<const char*>(ptr + sizeof(length)), length);
+            ptr += sizeof(length) + length;
+        }
+        values_ = std::move(values);
+    } else {
+        AssertInfo(values_data->size == count_ * sizeof(T), "size of values doesn't match the row count");
+        values_ = ViewBinaryAs<T>(values_data);
     }
+    BuildPositions();
     is_built_ = true;
 }
 
+template <typename T>
+inline void
+ScalarIndexSort<T>::LoadIndexStructures(const BinarySet& index_binary) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        PanicInfo("string values can't be loaded from an array of IndexStructure");
+    } else {
+        size_t index_size;
+        auto index_length = index_binary.GetByName("index_length");
+        memcpy(&index_size, index_length->data.get(), (size_t)index_length->size);
+
+        auto index_data = index_binary.GetByName("index_data");
+        std::vector<IndexStructure<T>> data(index_size);
+        memcpy(data.data(), index_data->data.get(), (size_t)index_data->size);
+
+        std::shared_ptr<T[]> values(new T[index_size]);
+        std::shared_ptr<uint32_t[]> row_ids(new uint32_t[index_size]);
+        for (size_t i = 0; i < index_size; ++i) {
+            values[i] = data[i].a_;
+            row_ids[i] = data[i].idx_;
+        }
+        values_ = std::move(values);
+        row_ids_ = std::move(row_ids);
+        count_ = index_size;
+        BuildPositions();
+        is_built_ = true;
+    }
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+ScalarIndexSort<T>::RowsOf(const T* begin, const T* end) const {
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    auto row_ids = row_ids_.get();
+    for (auto i = begin - values_.get(); i < end - values_.get(); ++i) {
+        bitset->set(row_ids[i]);
+    }
+    return bitset;
+}
+
 template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::In(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    auto begin = values_.get();
+    auto end = begin + count_;
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+        auto [lb, ub] = std::equal_range(begin, end, values[i]);
         for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                std::cout << "error happens in ScalarIndexSort<T>::In, experted value is: " << *(values + i)
-                          << ", but real value is: " << lb->a_;
-            }
-            bitset->set(lb->idx_);
+            bitset->set(row_ids_[lb - begin]);
         }
     }
     return bitset;
@@ -115,20 +230,8 @@ ScalarIndexSort<T>::In(const size_t n, const T* values) {
 template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::NotIn(const size_t n, const T* values) {
-    AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
-    bitset->set();
-    for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                std::cout << "error happens in ScalarIndexSort<T>::NotIn, experted value is: " << *(values + i)
-                          << ", but real value is: " << lb->a_;
-            }
-            bitset->reset(lb->idx_);
-        }
-    }
+    auto bitset = In(n, values);
+    bitset->flip();
     return bitset;
 }
 
@@ -136,65 +239,89 @@ template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::Range(const T value, const OpType op) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
-    auto lb = data_.begin();
-    auto ub = data_.end();
+    auto begin = values_.get();
+    auto end = begin + count_;
+    auto lb = begin;
+    auto ub = end;
     switch (op) {
         case OpType::LessThan:
-            ub = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = std::lower_bound(begin, end, value);
             break;
         case OpType::LessEqual:
-            ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = std::upper_bound(begin, end, value);
             break;
         case OpType::GreaterThan:
-            lb = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = std::upper_bound(begin, end, value);
             break;
         case OpType::GreaterEqual:
-            lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = std::lower_bound(begin, end, value);
             break;
         default:
             throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
     }
-    for (; lb < ub; ++lb) {
-        bitset->set(lb->idx_);
-    }
-    return bitset;
+    return RowsOf(lb, ub);
 }
 
 template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
     if (lower_bound_value > upper_bound_value ||
         (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
-        return bitset;
-    }
-    auto lb = data_.begin();
-    auto ub = data_.end();
-    if (lb_inclusive) {
-        lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
-    } else {
-        lb = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
-    }
-    if (ub_inclusive) {
-        ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
-    } else {
-        ub = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
-    }
-    for (; lb < ub; ++lb) {
-        bitset->set(lb->idx_);
+        return std::make_unique<TargetBitmap>(count_);
     }
-    return bitset;
+    auto begin = values_.get();
+    auto end = begin + count_;
+    auto lb = lb_inclusive ? std::lower_bound(begin, end, lower_bound_value)
+                           : std::upper_bound(begin, end, lower_bound_value);
+    auto ub = ub_inclusive ? std::upper_bound(begin, end, upper_bound_value)
+                           : std::lower_bound(begin, end, upper_bound_value);
+    return RowsOf(lb, ub);
 }
 
 template <typename T>
 inline T
 ScalarIndexSort<T>::Reverse_Lookup(size_t idx) const {
-    AssertInfo(idx < idx_to_offsets_.size(), "out of range of total count");
+    AssertInfo(idx < positions_.size(), "out of range of total count");
     AssertInfo(is_built_, "index has not been built");
 
-    auto offset = idx_to_offsets_[idx];
-    return data_[offset].a_;
+    return values_[positions_[idx]];
+}
+
+// rows are scattered over the sorted values_, so the lookups are cache misses, prefetch the value
+// a few rows ahead to overlap them
+constexpr int64_t REVERSE_LOOKUP_PREFETCH_DISTANCE = 16;
+
+template <typename T>
+inline void
+ScalarIndexSort<T>::ReverseLookup(const int64_t* offsets, int64_t n, T* out) const {
+    AssertInfo(is_built_, "index has not been built");
+    auto count = static_cast<int64_t>(positions_.size());
+    for (int64_t i = 0; i < n; ++i) {
+        AssertInfo(offsets[i] >= 0 && offsets[i] < count, "out of range of total count");
+    }
+    auto values = values_.get();
+    for (int64_t i = 0; i < n; ++i) {
+        if (i + REVERSE_LOOKUP_PREFETCH_DISTANCE < n) {
+            __builtin_prefetch(&values[positions_[offsets[i + REVERSE_LOOKUP_PREFETCH_DISTANCE]]]);
+        }
+        out[i] = values[positions_[offsets[i]]];
+    }
+}
+
+template <typename T>
+inline void
+ScalarIndexSort<T>::ReverseLookupRange(int64_t begin, int64_t n, T* out) const {
+    AssertInfo(is_built_, "index has not been built");
+    AssertInfo(begin >= 0 && n >= 0 && begin + n <= static_cast<int64_t>(positions_.size()),
+               "out of range of total count");
+    auto values = values_.get();
+    auto positions = positions_.data() + begin;
+    for (int64_t i = 0; i < n; ++i) {
+        if (i + REVERSE_LOOKUP_PREFETCH_DISTANCE < n) {
+            __builtin_prefetch(&values[positions[i + REVERSE_LOOKUP_PREFETCH_DISTANCE]]);
+        }
+        out[i] = values[positions[i]];
+    }
 }
 }  // namespace milvus::index
@@ -22,7 +22,6 @@
 #include <vector>
 #include <string>
 #include "knowhere/common/Exception.h"
-#include "index/IndexStructure.h"
 #include "index/ScalarIndex.h"
 
 namespace milvus::index {
@@ -41,7 +40,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Count() override {
-        return data_.size();
+        return count_;
     }
 
     void
@@ -62,15 +61,27 @@ class ScalarIndexSort : public ScalarIndex<T> {
     T
     Reverse_Lookup(size_t offset) const override;
 
+    void
+    ReverseLookup(const int64_t* offsets, int64_t n, T* out) const override;
+
+    void
+    ReverseLookupRange(int64_t begin, int64_t n, T* out) const override;
+
     int64_t
     Size() override {
-        return (int64_t)data_.size();
+        return (int64_t)count_;
     }
 
  public:
-    const std::vector<IndexStructure<T>>&
-    GetData() {
-        return data_;
+    // the values in ascending order, the row of GetValues()[i] is GetRowIds()[i]
+    const T*
+    GetValues() const {
+        return values_.get();
+    }
+
+    const uint32_t*
+    GetRowIds() const {
+        return row_ids_.get();
     }
 
     bool
@@ -78,11 +89,32 @@ class ScalarIndexSort : public ScalarIndex<T> {
         return is_built_;
     }
 
+ protected:
+    // build from values of a type convertible to T, sorted before they are converted
+    template <typename U>
+    void
+    BuildFrom(size_t n, const U* values);
+
+ private:
+    // load the format before the values and the row ids were split, an array of IndexStructure<T>
+    void
+    LoadIndexStructures(const BinarySet& index_binary);
+
+    void
+    BuildPositions();
+
+    const TargetBitmapPtr
+    RowsOf(const T* begin, const T* end) const;
+
  private:
     bool is_built_;
     Config config_;
-    std::vector<size_t> idx_to_offsets_;  // used to retrieve.
-    std::vector<IndexStructure<T>> data_;
+    size_t count_ = 0;
+    // struct of arrays with 32-bit row ids, a segment holds far fewer than 4G rows. A search only touches
+    // values_, and after Load both point into the BinarySet unless the values have to be parsed (strings)
+    std::shared_ptr<const T[]> values_;
+    std::shared_ptr<const uint32_t[]> row_ids_;
+    std::vector<uint32_t> positions_;  // position in values_ of each row, used to retrieve.
 };
 
 template <typename T>
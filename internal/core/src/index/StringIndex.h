@@ -34,11 +34,26 @@ class StringIndex : public ScalarIndex<std::string> {
             auto prefix = dataset->Get<std::string>(PREFIX_VALUE);
             return PrefixMatch(prefix);
         }
+        if (op == OpType::PostfixMatch) {
+            auto postfix = dataset->Get<std::string>(MATCH_VALUE);
+            return PostfixMatch(postfix);
+        }
+        if (op == OpType::Match) {
+            auto pattern = dataset->Get<std::string>(MATCH_VALUE);
+            return PatternMatch(pattern);
+        }
         return ScalarIndex<std::string>::Query(dataset);
     }
 
     virtual const TargetBitmapPtr
     PrefixMatch(std::string prefix) = 0;
+
+    virtual const TargetBitmapPtr
+    PostfixMatch(std::string postfix) = 0;
+
+    // pattern is a LIKE pattern, see StringMatcher
+    virtual const TargetBitmapPtr
+    PatternMatch(std::string pattern) = 0;
 };
 using StringIndexPtr = std::unique_ptr<StringIndex>;
 }  // namespace milvus::index
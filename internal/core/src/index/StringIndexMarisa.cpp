@@ -14,12 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_io.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <stdlib.h>
-#include <stdio.h>
-#include <fcntl.h>
+#include <algorithm>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 #include <knowhere/index/VecIndex.h>
 
 #include "index/StringIndexMarisa.h"
@@ -31,6 +32,16 @@ namespace milvus::index {
 
 #if defined(__linux__) || defined(__APPLE__)
 
+namespace {
+// stream over a preallocated buffer, so marisa can write the trie without a temp file or a string copy
+class MemoryStreamBuf : public std::streambuf {
+ public:
+    MemoryStreamBuf(char* data, size_t size) {
+        setp(data, data + size);
+    }
+};
+}  // namespace
+
 int64_t
 StringIndexMarisa::Size() {
     return trie_.size();
@@ -42,48 +53,38 @@ StringIndexMarisa::Build(size_t n, const std::string* values) {
         throw std::runtime_error("index has been built");
     }
 
+    // marisa builds the trie on one thread, so hand it the distinct keys only, which are found by a
+    // parallel sort
+    std::vector<std::string_view> keys(values, values + n);
+    tbb::parallel_sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
     marisa::Keyset keyset;
-    {
-        // fill key set.
-        for (size_t i = 0; i < n; i++) {
-            keyset.push_back(values[i].c_str());
-        }
+    for (auto& key : keys) {
+        keyset.push_back(key.data(), key.size());
     }
 
     trie_.build(keyset);
     fill_str_ids(n, values);
     fill_offsets();
+    fill_sorted_str_ids();
 
     built_ = true;
 }
 
 BinarySet
 StringIndexMarisa::Serialize(const Config& config) {
-    auto uuid = boost::uuids::random_generator()();
-    auto uuid_string = boost::uuids::to_string(uuid);
-    auto file = std::string("/tmp/") + uuid_string;
-
-    auto fd = open(file.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR | S_IXUSR);
-    trie_.write(fd);
-
-    auto size = get_file_size(fd);
-    auto buf = new uint8_t[size];
-
-    while (read(fd, buf, size) != size) {
-        lseek(fd, 0, SEEK_SET);
-    }
-    std::shared_ptr<uint8_t[]> index_data(buf);
-
-    close(fd);
-    remove(file.c_str());
-
-    auto str_ids_len = str_ids_.size() * sizeof(size_t);
-    std::shared_ptr<uint8_t[]> str_ids(new uint8_t[str_ids_len]);
-    memcpy(str_ids.get(), str_ids_.data(), str_ids_len);
-
+    // write the trie straight into the buffer handed to the BinarySet
+    auto size = trie_.io_size();
+    std::shared_ptr<uint8_t[]> index_data(new uint8_t[size]);
+    MemoryStreamBuf buf(reinterpret_cast<char*>(index_data.get()), size);
+    std::ostream os(&buf);
+    marisa::write(os, trie_);
+    AssertInfo(os.good(), "failed to serialize marisa trie");
+
+    // the index is immutable once built, so the str ids are shared rather than copied
     BinarySet res_set;
     res_set.Append(MARISA_TRIE_INDEX, index_data, size);
-    res_set.Append(MARISA_STR_IDS, str_ids, str_ids_len);
+    res_set.Append(MARISA_STR_IDS, str_ids_data_, count_ * sizeof(size_t));
 
     knowhere::Disassemble(res_set, config);
 
@@ -94,30 +95,23 @@ void
 StringIndexMarisa::Load(const BinarySet& set, const Config& config) {
     knowhere::Assemble(const_cast<BinarySet&>(set));
 
-    auto uuid = boost::uuids::random_generator()();
-    auto uuid_string = boost::uuids::to_string(uuid);
-    auto file = std::string("/tmp/") + uuid_string;
-
+    // the trie and the str ids are used in place, holding a reference to the buffers of the BinarySet
     auto index = set.GetByName(MARISA_TRIE_INDEX);
-    auto len = index->size;
-
-    auto fd = open(file.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR | S_IXUSR);
-    lseek(fd, 0, SEEK_SET);
-    while (write(fd, index->data.get(), len) != len) {
-        lseek(fd, 0, SEEK_SET);
-    }
-
-    lseek(fd, 0, SEEK_SET);
-    trie_.read(fd);
-    close(fd);
-    remove(file.c_str());
+    trie_data_ = index->data;
+    trie_.map(trie_data_.get(), index->size);
 
     auto str_ids = set.GetByName(MARISA_STR_IDS);
-    auto str_ids_len = str_ids->size;
-    str_ids_.resize(str_ids_len / sizeof(size_t));
-    memcpy(str_ids_.data(), str_ids->data.get(), str_ids_len);
+    count_ = str_ids->size / sizeof(size_t);
+    if (reinterpret_cast<uintptr_t>(str_ids->data.get()) % alignof(size_t) == 0) {
+        str_ids_data_ = str_ids->data;
+    } else {
+        str_ids_data_ = std::shared_ptr<uint8_t[]>(new uint8_t[str_ids->size]);
+        memcpy(str_ids_data_.get(), str_ids->data.get(), str_ids->size);
+    }
+    str_ids_ = reinterpret_cast<const size_t*>(str_ids_data_.get());
 
     fill_offsets();
+    fill_sorted_str_ids();
 }
 
 bool
@@ -127,7 +121,7 @@ valid_str_id(size_t str_id) {
 
 const TargetBitmapPtr
 StringIndexMarisa::In(size_t n, const std::string* values) {
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(str_ids_.size());
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
     for (size_t i = 0; i < n; i++) {
         auto str = values[i];
         auto str_id = lookup(str);
@@ -143,7 +137,7 @@ StringIndexMarisa::In(size_t n, const std::string* values) {
 
 const TargetBitmapPtr
 StringIndexMarisa::NotIn(size_t n, const std::string* values) {
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(str_ids_.size());
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
     bitset->set();
     for (size_t i = 0; i < n; i++) {
         auto str = values[i];
@@ -160,35 +154,18 @@ StringIndexMarisa::NotIn(size_t n, const std::string* values) {
 
 const TargetBitmapPtr
 StringIndexMarisa::Range(std::string value, OpType op) {
-    auto count = Count();
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count);
-    marisa::Agent agent;
-    for (size_t offset = 0; offset < count; ++offset) {
-        agent.set_query(str_ids_[offset]);
-        trie_.reverse_lookup(agent);
-        std::string raw_data(agent.key().ptr(), agent.key().length());
-        bool set = false;
-        switch (op) {
-            case OpType::LessThan:
-                set = raw_data.compare(value) < 0;
-                break;
-            case OpType::LessEqual:
-                set = raw_data.compare(value) <= 0;
-                break;
-            case OpType::GreaterThan:
-                set = raw_data.compare(value) > 0;
-                break;
-            case OpType::GreaterEqual:
-                set = raw_data.compare(value) >= 0;
-                break;
-            default:
-                throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
-        }
-        if (set) {
-            bitset->set(offset);
-        }
+    switch (op) {
+        case OpType::LessThan:
+            return sorted_keys_to_offsets(0, lower_bound(value, true));
+        case OpType::LessEqual:
+            return sorted_keys_to_offsets(0, lower_bound(value, false));
+        case OpType::GreaterThan:
+            return sorted_keys_to_offsets(lower_bound(value, false), sorted_str_ids_.size());
+        case OpType::GreaterEqual:
+            return sorted_keys_to_offsets(lower_bound(value, true), sorted_str_ids_.size());
+        default:
+            throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
     }
-    return bitset;
 }
 
 const TargetBitmapPtr
@@ -196,42 +173,45 @@ StringIndexMarisa::Range(std::string lower_bound_value,
                          bool lb_inclusive,
                          std::string upper_bound_value,
                          bool ub_inclusive) {
-    auto count = Count();
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count);
     if (lower_bound_value.compare(upper_bound_value) > 0 ||
         (lower_bound_value.compare(upper_bound_value) == 0 && !(lb_inclusive && ub_inclusive))) {
-        return bitset;
+        return std::make_unique<TargetBitmap>(Count());
     }
-    marisa::Agent agent;
-    for (size_t offset = 0; offset < count; ++offset) {
-        agent.set_query(str_ids_[offset]);
-        trie_.reverse_lookup(agent);
-        std::string raw_data(agent.key().ptr(), agent.key().length());
-        bool set = true;
-        if (lb_inclusive) {
-            set &= raw_data.compare(lower_bound_value) >= 0;
-        } else {
-            set &= raw_data.compare(lower_bound_value) > 0;
-        }
-        if (ub_inclusive) {
-            set &= raw_data.compare(upper_bound_value) <= 0;
-        } else {
-            set &= raw_data.compare(upper_bound_value) < 0;
-        }
-        if (set) {
-            bitset->set(offset);
-        }
-    }
-    return bitset;
+    return sorted_keys_to_offsets(lower_bound(lower_bound_value, lb_inclusive),
+                                  lower_bound(upper_bound_value, !ub_inclusive));
 }
 
 const TargetBitmapPtr
 StringIndexMarisa::PrefixMatch(std::string prefix) {
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(str_ids_.size());
-    auto matched = prefix_match(prefix);
-    for (const auto str_id : matched) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
+    // keys with the prefix follow the first key >= prefix
+    auto begin = lower_bound(prefix, true);
+    auto end = std::partition_point(sorted_str_ids_.begin() + begin, sorted_str_ids_.end(), [&](size_t str_id) {
+        return milvus::PrefixMatch(key_of(str_id), prefix);
+    });
+    return sorted_keys_to_offsets(begin, end - sorted_str_ids_.begin());
+}
+
+const TargetBitmapPtr
+StringIndexMarisa::PostfixMatch(std::string postfix) {
+    return match_keys(StringMatcher(OpType::PostfixMatch, postfix));
+}
+
+const TargetBitmapPtr
+StringIndexMarisa::PatternMatch(std::string pattern) {
+    return match_keys(StringMatcher(OpType::Match, pattern));
+}
+
+const TargetBitmapPtr
+StringIndexMarisa::match_keys(const StringMatcher& matcher) {
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    // an empty query enumerates all keys of the trie
+    marisa::Agent agent;
+    agent.set_query("");
+    while (trie_.predictive_search(agent)) {
+        if (!matcher(std::string_view(agent.key().ptr(), agent.key().length()))) {
+            continue;
+        }
+        for (auto offset : str_ids_to_offsets_[agent.key().id()]) {
             bitset->set(offset);
         }
     }
@@ -240,18 +220,69 @@ StringIndexMarisa::PrefixMatch(std::string prefix) {
 
 void
 StringIndexMarisa::fill_str_ids(size_t n, const std::string* values) {
-    str_ids_.resize(n);
-    for (size_t i = 0; i < n; i++) {
-        auto str = values[i];
-        auto str_id = lookup(str);
-        assert(valid_str_id(str_id));
-        str_ids_[i] = str_id;
+    str_ids_data_ = std::shared_ptr<uint8_t[]>(new uint8_t[n * sizeof(size_t)]);
+    auto str_ids = reinterpret_cast<size_t*>(str_ids_data_.get());
+    // lookups only read the trie, each one uses its own agent
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (auto i = range.begin(); i < range.end(); i++) {
+            auto str_id = lookup(values[i]);
+            AssertInfo(valid_str_id(str_id), "string not found in the marisa trie");
+            str_ids[i] = str_id;
+        }
+    });
+    str_ids_ = str_ids;
+    count_ = n;
+}
+
+void
+StringIndexMarisa::fill_sorted_str_ids() {
+    std::vector<std::pair<std::string, size_t>> keys;
+    keys.reserve(trie_.num_keys());
+    // an empty query enumerates all keys of the trie
+    marisa::Agent agent;
+    agent.set_query("");
+    while (trie_.predictive_search(agent)) {
+        keys.emplace_back(std::string(agent.key().ptr(), agent.key().length()), agent.key().id());
+    }
+    tbb::parallel_sort(keys.begin(), keys.end());
+    sorted_str_ids_.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        sorted_str_ids_[i] = keys[i].second;
+    }
+}
+
+std::string
+StringIndexMarisa::key_of(size_t str_id) const {
+    marisa::Agent agent;
+    agent.set_query(str_id);
+    trie_.reverse_lookup(agent);
+    return std::string(agent.key().ptr(), agent.key().length());
+}
+
+size_t
+StringIndexMarisa::lower_bound(const std::string& value, bool inclusive) const {
+    // only the O(log(num_keys)) probed keys are reconstructed
+    auto it = std::partition_point(sorted_str_ids_.begin(), sorted_str_ids_.end(), [&](size_t str_id) {
+        auto cmp = key_of(str_id).compare(value);
+        return inclusive ? cmp < 0 : cmp <= 0;
+    });
+    return it - sorted_str_ids_.begin();
+}
+
+const TargetBitmapPtr
+StringIndexMarisa::sorted_keys_to_offsets(size_t begin, size_t end) {
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    for (size_t i = begin; i < end; i++) {
+        for (auto offset : str_ids_to_offsets_[sorted_str_ids_[i]]) {
+            bitset->set(offset);
+        }
     }
+    return bitset;
 }
 
 void
 StringIndexMarisa::fill_offsets() {
-    for (size_t offset = 0; offset < str_ids_.size(); offset++) {
+    for (size_t offset = 0; offset < count_; offset++) {
         auto str_id = str_ids_[offset];
         if (str_ids_to_offsets_.find(str_id) == str_ids_to_offsets_.end()) {
             str_ids_to_offsets_[str_id] = std::vector<size_t>{};
@@ -263,7 +294,7 @@ StringIndexMarisa::fill_offsets() {
 size_t
 StringIndexMarisa::lookup(const std::string& str) {
     marisa::Agent agent;
-    agent.set_query(str.c_str());
+    agent.set_query(str.data(), str.size());
     if (trie_.lookup(agent)) {
         return agent.key().id();
     }
@@ -272,26 +303,38 @@ StringIndexMarisa::lookup(const std::string& str) {
     return MARISA_INVALID_KEY_ID;
 }
 
-std::vector<size_t>
-StringIndexMarisa::prefix_match(const std::string& prefix) {
-    std::vector<size_t> ret;
-    marisa::Agent agent;
-    agent.set_query(prefix.c_str());
-    while (trie_.predictive_search(agent)) {
-        ret.push_back(agent.key().id());
-    }
-    return ret;
-}
-
 std::string
 StringIndexMarisa::Reverse_Lookup(size_t offset) const {
-    AssertInfo(offset < str_ids_.size(), "out of range of total count");
+    AssertInfo(offset < count_, "out of range of total count");
     marisa::Agent agent;
     agent.set_query(str_ids_[offset]);
     trie_.reverse_lookup(agent);
     return std::string(agent.key().ptr(), agent.key().length());
 }
 
+void
+StringIndexMarisa::ReverseLookup(const int64_t* offsets, int64_t n, std::string* out) const {
+    // one agent for the whole batch, Reverse_Lookup sets up a new one per row
+    marisa::Agent agent;
+    for (int64_t i = 0; i < n; ++i) {
+        AssertInfo(offsets[i] >= 0 && offsets[i] < static_cast<int64_t>(count_), "out of range of total count");
+        agent.set_query(str_ids_[offsets[i]]);
+        trie_.reverse_lookup(agent);
+        out[i].assign(agent.key().ptr(), agent.key().length());
+    }
+}
+
+void
+StringIndexMarisa::ReverseLookupRange(int64_t begin, int64_t n, std::string* out) const {
+    AssertInfo(begin >= 0 && n >= 0 && begin + n <= static_cast<int64_t>(count_), "out of range of total count");
+    marisa::Agent agent;
+    for (int64_t i = 0; i < n; ++i) {
+        agent.set_query(str_ids_[begin + i]);
+        trie_.reverse_lookup(agent);
+        out[i].assign(agent.key().ptr(), agent.key().length());
+    }
+}
+
 #endif
 
 }  // namespace milvus::index
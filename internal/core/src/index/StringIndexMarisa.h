@@ -19,6 +19,7 @@
 #if defined(__linux__) || defined(__APPLE__)
 
 #include <marisa.h>
+#include "common/StringMatch.h"
 #include "index/StringIndex.h"
 #include <string>
 #include <vector>
@@ -42,7 +43,7 @@ class StringIndexMarisa : public StringIndex {
 
     int64_t
     Count() override {
-        return str_ids_.size();
+        return count_;
     }
 
     void
@@ -63,9 +64,21 @@ class StringIndexMarisa : public StringIndex {
     const TargetBitmapPtr
     PrefixMatch(std::string prefix) override;
 
+    const TargetBitmapPtr
+    PostfixMatch(std::string postfix) override;
+
+    const TargetBitmapPtr
+    PatternMatch(std::string pattern) override;
+
     std::string
     Reverse_Lookup(size_t offset) const override;
 
+    void
+    ReverseLookup(const int64_t* offsets, int64_t n, std::string* out) const override;
+
+    void
+    ReverseLookupRange(int64_t begin, int64_t n, std::string* out) const override;
+
  private:
     void
     fill_str_ids(size_t n, const std::string* values);
@@ -73,18 +86,41 @@ class StringIndexMarisa : public StringIndex {
     void
     fill_offsets();
 
+    // sort the key ids of the trie by their keys, marisa doesn't keep keys in lexicographic order
+    void
+    fill_sorted_str_ids();
+
+    std::string
+    key_of(size_t str_id) const;
+
+    // position in sorted_str_ids_ of the first key >= value, or > value if !inclusive
+    size_t
+    lower_bound(const std::string& value, bool inclusive) const;
+
+    // set the offsets of the keys in [begin, end) of sorted_str_ids_
+    const TargetBitmapPtr
+    sorted_keys_to_offsets(size_t begin, size_t end);
+
     // get str_id by str, if str not found, -1 was returned.
     size_t
     lookup(const std::string& str);
 
-    std::vector<size_t>
-    prefix_match(const std::string& prefix);
+    // set the offsets of all rows whose string passes matcher, each distinct string is checked once
+    const TargetBitmapPtr
+    match_keys(const StringMatcher& matcher);
 
  private:
     Config config_;
     marisa::Trie trie_;
-    std::vector<size_t> str_ids_;  // used to retrieve.
+    // buffer the trie is mapped from after Load, empty if the trie was built
+    std::shared_ptr<uint8_t[]> trie_data_;
+    // str id of each row, used to retrieve. str_ids_data_ owns it, and after Load it's the loaded buffer itself
+    std::shared_ptr<uint8_t[]> str_ids_data_;
+    const size_t* str_ids_ = nullptr;
+    size_t count_ = 0;
     std::map<size_t, std::vector<size_t>> str_ids_to_offsets_;
+    // str ids in lexicographic order of their keys, so ranges and prefixes of keys are intervals
+    std::vector<size_t> sorted_str_ids_;
     bool built_ = false;
 };
 
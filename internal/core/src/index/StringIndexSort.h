@@ -14,10 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 
+#include "common/StringMatch.h"
 #include "common/Utils.h"
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndex.h"
@@ -27,6 +30,14 @@ namespace milvus::index {
 // TODO: should inherit from StringIndex?
 class StringIndexSort : public ScalarIndexSort<std::string> {
  public:
+    using ScalarIndexSort<std::string>::Build;
+
+    // build from the views of a string column, the rows are sorted as views and each string is copied once
+    void
+    Build(size_t n, const std::string_view* values) {
+        BuildFrom(n, values);
+    }
+
     const TargetBitmapPtr
     Query(const DatasetPtr& dataset) override {
         auto op = dataset->Get<OpType>(OPERATOR_TYPE);
@@ -34,16 +45,52 @@ class StringIndexSort : public ScalarIndexSort<std::string> {
             auto prefix = dataset->Get<std::string>(PREFIX_VALUE);
             return PrefixMatch(prefix);
         }
+        if (op == OpType::PostfixMatch || op == OpType::Match) {
+            auto operand = dataset->Get<std::string>(MATCH_VALUE);
+            return MatchValues(StringMatcher(op, operand));
+        }
         return ScalarIndex<std::string>::Query(dataset);
     }
 
     const TargetBitmapPtr
     PrefixMatch(std::string prefix) {
-        auto data = GetData();
-        TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data.size());
-        for (size_t i = 0; i < data.size(); i++) {
-            if (milvus::PrefixMatch(data[i].a_, prefix)) {
-                bitset->set(data[i].idx_);
+        // strings sharing a prefix are adjacent in the sorted values
+        auto values = GetValues();
+        auto row_ids = GetRowIds();
+        auto count = Count();
+        TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count);
+        auto i = std::lower_bound(values, values + count, prefix) - values;
+        for (; i < count && milvus::PrefixMatch(values[i], prefix); ++i) {
+            bitset->set(row_ids[i]);
+        }
+        return bitset;
+    }
+
+    const TargetBitmapPtr
+    PostfixMatch(std::string postfix) {
+        return MatchValues(StringMatcher(OpType::PostfixMatch, postfix));
+    }
+
+    const TargetBitmapPtr
+    PatternMatch(std::string pattern) {
+        return MatchValues(StringMatcher(OpType::Match, pattern));
+    }
+
+ private:
+    // equal strings are adjacent in the sorted values, each distinct string is checked once
+    const TargetBitmapPtr
+    MatchValues(const StringMatcher& matcher) {
+        auto values = GetValues();
+        auto row_ids = GetRowIds();
+        auto count = Count();
+        TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count);
+        bool matched = false;
+        for (int64_t i = 0; i < count; i++) {
+            if (i == 0 || values[i] != values[i - 1]) {
+                matched = matcher(values[i]);
+            }
+            if (matched) {
+                bitset->set(row_ids[i]);
             }
         }
         return bitset;
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 #include <functional>
 
@@ -23,6 +24,7 @@
 #include "index/Meta.h"
 #include <google/protobuf/text_format.h>
 #include "exceptions/EasyAssert.h"
+#include "pb/schema.pb.h"
 
 namespace milvus::index {
 
@@ -201,4 +203,64 @@ ParseConfigFromIndexParams(const std::map<std::string, std::string>& index_param
     return config;
 }
 
+template <typename T, typename Iter>
+static bool
+HasAtMostDistinct(Iter begin, Iter end, size_t max_cardinality) {
+    std::unordered_set<T> distinct;
+    for (auto it = begin; it != end; ++it) {
+        if (distinct.insert(*it).second && distinct.size() > max_cardinality) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+static bool
+HasAtMostDistinct(size_t n, const void* values, size_t max_cardinality) {
+    auto data = reinterpret_cast<const T*>(values);
+    return HasAtMostDistinct<T>(data, data + n, max_cardinality);
+}
+
+bool
+IsLowCardinality(DataType data_type, size_t n, const void* values, size_t max_cardinality) {
+    switch (data_type) {
+        case DataType::BOOL:
+            return max_cardinality >= 2;
+        case DataType::INT8:
+            return HasAtMostDistinct<int8_t>(n, values, max_cardinality);
+        case DataType::INT16:
+            return HasAtMostDistinct<int16_t>(n, values, max_cardinality);
+        case DataType::INT32:
+            return HasAtMostDistinct<int32_t>(n, values, max_cardinality);
+        case DataType::INT64:
+            return HasAtMostDistinct<int64_t>(n, values, max_cardinality);
+        case DataType::FLOAT:
+            return HasAtMostDistinct<float>(n, values, max_cardinality);
+        case DataType::DOUBLE:
+            return HasAtMostDistinct<double>(n, values, max_cardinality);
+        case DataType::STRING:
+        case DataType::VARCHAR: {
+            // strings are passed serialized, as for ScalarIndex<std::string>::BuildWithRawData
+            proto::schema::StringArray arr;
+            arr.ParseFromArray(values, n);
+            return HasAtMostDistinct<std::string>(arr.data().begin(), arr.data().end(), max_cardinality);
+        }
+        default:
+            return false;
+    }
+}
+
+IndexType
+GetScalarIndexType(const BinarySet& binary_set, const IndexType& index_type) {
+    if (binary_set.Contains(BITMAP_INDEX_IDS)) {
+        return BITMAP_INDEX;
+    }
+    // serialized by ScalarIndexSort, "index_data" is its format before SORT_INDEX_ROW_IDS
+    if (binary_set.Contains(SORT_INDEX_ROW_IDS) || binary_set.Contains("index_data")) {
+        return ASCENDING_SORT;
+    }
+    return index_type;
+}
+
 }  // namespace milvus::index
@@ -123,4 +123,13 @@ GetIndexMetaFromConfig(const Config& config);
 Config
 ParseConfigFromIndexParams(const std::map<std::string, std::string>& index_params);
 
+// whether the raw data of a scalar field, as passed to BuildWithRawData, has at most max_cardinality distinct values
+bool
+IsLowCardinality(DataType data_type, size_t n, const void* values, size_t max_cardinality);
+
+// type of the scalar index serialized in binary_set, index_type if it can't be told from the binaries.
+// Bitmap indexes may be picked by cardinality at build time, and bool fields had sort indexes before
+IndexType
+GetScalarIndexType(const BinarySet& binary_set, const IndexType& index_type);
+
 }  // namespace milvus::index
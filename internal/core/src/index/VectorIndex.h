@@ -19,7 +19,6 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <boost/dynamic_bitset.hpp>
 
 #include "knowhere/index/VecIndex.h"
 #include "index/Index.h"
@@ -74,6 +73,12 @@ class VectorIndex : public IndexBase {
     CleanLocalData() {
     }
 
+    // copy the vectors at offsets into output, return false if the index doesn't keep the raw vectors
+    virtual bool
+    GetVectors(const int64_t* offsets, int64_t count, void* output) const {
+        return false;
+    }
+
  private:
     IndexType index_type_;
     IndexMode index_mode_;
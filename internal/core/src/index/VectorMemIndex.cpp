@@ -153,6 +153,23 @@ VectorMemIndex::Query(const DatasetPtr dataset, const SearchInfo& search_info, c
     return result;
 }
 
+bool
+VectorMemIndex::GetVectors(const int64_t* offsets, int64_t count, void* output) const {
+    // only the indexes in the nm list keep the raw vectors
+    if (raw_data_.empty()) {
+        return false;
+    }
+    auto dim = GetDim();
+    int64_t row_size = is_in_bin_list(GetIndexType()) ? dim / 8 : dim * sizeof(float);
+    int64_t num_rows = raw_data_.size() / row_size;
+    auto dst = static_cast<uint8_t*>(output);
+    for (int64_t i = 0; i < count; ++i) {
+        AssertInfo(offsets[i] >= 0 && offsets[i] < num_rows, "[VectorMemIndex]offset out of range");
+        memcpy(dst + i * row_size, raw_data_.data() + offsets[i] * row_size, row_size);
+    }
+    return true;
+}
+
 void
 VectorMemIndex::store_raw_data(const knowhere::DatasetPtr& dataset) {
     auto index_type = GetIndexType();
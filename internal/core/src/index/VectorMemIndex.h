@@ -20,7 +20,6 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <boost/dynamic_bitset.hpp>
 
 #include "index/VectorIndex.h"
 
@@ -47,6 +46,9 @@ class VectorMemIndex : public VectorIndex {
     std::unique_ptr<SearchResult>
     Query(const DatasetPtr dataset, const SearchInfo& search_info, const BitsetView& bitset) override;
 
+    bool
+    GetVectors(const int64_t* offsets, int64_t count, void* output) const override;
+
  private:
     void
     store_raw_data(const knowhere::DatasetPtr& dataset);
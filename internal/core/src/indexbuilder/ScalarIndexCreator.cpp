@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "indexbuilder/ScalarIndexCreator.h"
+#include "index/BitmapIndex.h"
 #include "index/IndexFactory.h"
 #include "index/IndexInfo.h"
 #include "index/Meta.h"
@@ -38,9 +39,14 @@ ScalarIndexCreator::ScalarIndexCreator(DataType dtype, const char* type_params,
         config_[param.key()] = param.value();
     }
 
+    create_index(index_type());
+}
+
+void
+ScalarIndexCreator::create_index(const std::string& index_type) {
     milvus::index::CreateIndexInfo index_info;
     index_info.field_type = dtype_;
-    index_info.index_type = index_type();
+    index_info.index_type = index_type;
     index_info.index_mode = IndexMode::MODE_CPU;
     index_ = index::IndexFactory::GetInstance().CreateIndex(index_info, nullptr);
 }
@@ -49,6 +55,15 @@ void
 ScalarIndexCreator::Build(const milvus::DatasetPtr& dataset) {
     auto size = knowhere::GetDatasetRows(dataset);
     auto data = knowhere::GetDatasetTensor(dataset);
+    // low-cardinality fields get a bitmap index, unless another index type is asked for
+    auto type = index_type();
+    if (type != index::ASCENDING_SORT && type != index::MARISA_TRIE && type != index::BITMAP_INDEX) {
+        auto limit = index::GetValueFromConfig<std::string>(config_, index::BITMAP_CARDINALITY_LIMIT);
+        auto max_cardinality = limit.has_value() ? std::stoul(limit.value()) : index::DEFAULT_BITMAP_CARDINALITY_LIMIT;
+        if (index::IsLowCardinality(dtype_, size, data, max_cardinality)) {
+            create_index(index::BITMAP_INDEX);
+        }
+    }
     index_->BuildWithRawData(size, data);
 }
 
@@ -59,13 +74,14 @@ ScalarIndexCreator::Serialize() {
 
 void
 ScalarIndexCreator::Load(const milvus::BinarySet& binary_set) {
+    create_index(index::GetScalarIndexType(binary_set, index_type()));
     index_->Load(binary_set);
 }
 
 std::string
 ScalarIndexCreator::index_type() {
-    // TODO
-    return "sort";
+    auto index_type = index::GetValueFromConfig<std::string>(config_, index::INDEX_TYPE);
+    return index_type.has_value() ? index_type.value() : "sort";
 }
 
 }  // namespace milvus::indexbuilder
@@ -37,6 +37,9 @@ class ScalarIndexCreator : public IndexCreatorBase {
     std::string
     index_type();
 
+    void
+    create_index(const std::string& index_type);
+
  private:
     index::IndexBasePtr index_ = nullptr;
     Config config_;
@@ -0,0 +1,542 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "query/ExprImpl.h"
+#include "query/LazyPredicate.h"
+#include "query/Relational.h"
+#include "query/Utils.h"
+#include "wasm/WasmFunctionManager.h"
+
+namespace milvus::query {
+
+LazyPredicate::LazyPredicate(const segcore::SegmentInternalInterface& segment, Expr& expr, int64_t row_count)
+    : segment_(segment),
+      expr_(expr),
+      row_count_(row_count),
+      size_per_chunk_(segment.size_per_chunk()),
+      evaluated_(row_count),
+      passed_(row_count) {
+    for (auto& [field_id, field_meta] : segment.get_schema().get_fields()) {
+        if (field_meta.get_data_type() == DataType::VARCHAR) {
+            if (auto string_dict = segment.get_string_dict(field_id)) {
+                string_dicts_.emplace(field_id, string_dict);
+            }
+        } else if (field_meta.get_data_type() == DataType::INT64) {
+            if (auto packed_int = segment.get_packed_int(field_id)) {
+                packed_ints_.emplace(field_id, packed_int);
+            }
+        }
+    }
+}
+
+bool
+LazyPredicate::operator()(int64_t offset) {
+    AssertInfo(offset >= 0 && offset < row_count_, "[LazyPredicate]offset out of range");
+    if (evaluated_[offset]) {
+        return passed_[offset];
+    }
+    offset_ = offset;
+    auto res = Eval(expr_);
+    evaluated_.set(offset);
+    passed_.set(offset, res);
+    ++num_evaluated_;
+    return res;
+}
+
+double
+LazyPredicate::EstimateSelectivity(int64_t sample_size) {
+    sample_size = std::min(sample_size, row_count_);
+    if (sample_size <= 0) {
+        return 0;
+    }
+    int64_t passed = 0;
+    for (int64_t i = 0; i < sample_size; ++i) {
+        passed += (*this)(i * row_count_ / sample_size);
+    }
+    return double(passed) / sample_size;
+}
+
+bool
+LazyPredicate::Eval(Expr& expr) {
+    expr.accept(*this);
+    return result_;
+}
+
+template <typename T>
+T
+LazyPredicate::GetValue(FieldId field_id) const {
+    auto chunk_id = offset_ / size_per_chunk_;
+    auto chunk_offset = offset_ % size_per_chunk_;
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (auto iter = string_dicts_.find(field_id); iter != string_dicts_.end()) {
+            return T(iter->second->Decode(offset_));
+        }
+    }
+    if constexpr (std::is_same_v<T, int64_t>) {
+        if (auto iter = packed_ints_.find(field_id); iter != packed_ints_.end()) {
+            return iter->second->Get(offset_);
+        }
+    }
+    if (chunk_id < segment_.num_chunk_data(field_id)) {
+        return T(segment_.chunk_data<ChunkViewType<T>>(field_id, chunk_id)[chunk_offset]);
+    }
+    // for case, sealed segment has loaded index for scalar field instead of raw data
+    auto& indexing = segment_.chunk_scalar_index<T>(field_id, chunk_id);
+    return indexing.Reverse_Lookup(chunk_offset);
+}
+
+void
+LazyPredicate::visit(LogicalUnaryExpr& expr) {
+    using OpType = LogicalUnaryExpr::OpType;
+    switch (expr.op_type_) {
+        case OpType::LogicalNot: {
+            result_ = !Eval(*expr.child_);
+            break;
+        }
+        default: {
+            PanicInfo("Invalid Unary Op");
+        }
+    }
+}
+
+void
+LazyPredicate::visit(LogicalBinaryExpr& expr) {
+    using OpType = LogicalBinaryExpr::OpType;
+    // and/or short circuit, the right side is often the expensive one
+    switch (expr.op_type_) {
+        case OpType::LogicalAnd: {
+            result_ = Eval(*expr.left_) && Eval(*expr.right_);
+            break;
+        }
+        case OpType::LogicalOr: {
+            result_ = Eval(*expr.left_) || Eval(*expr.right_);
+            break;
+        }
+        case OpType::LogicalXor: {
+            auto left = Eval(*expr.left_);
+            result_ = left != Eval(*expr.right_);
+            break;
+        }
+        case OpType::LogicalMinus: {
+            result_ = Eval(*expr.left_) && !Eval(*expr.right_);
+            break;
+        }
+        default: {
+            PanicInfo("Invalid Binary Op");
+        }
+    }
+}
+
+template <typename T>
+bool
+LazyPredicate::EvalUnaryRange(UnaryRangeExpr& expr_raw) {
+    auto& expr = static_cast<UnaryRangeExprImpl<T>&>(expr_raw);
+    auto& val = expr.value_;
+    auto x = GetValue<T>(expr.field_id_);
+    switch (expr.op_type_) {
+        case OpType::Equal:
+            return x == val;
+        case OpType::NotEqual:
+            return x != val;
+        case OpType::GreaterEqual:
+            return x >= val;
+        case OpType::GreaterThan:
+            return x > val;
+        case OpType::LessEqual:
+            return x <= val;
+        case OpType::LessThan:
+            return x < val;
+        case OpType::PrefixMatch:
+        case OpType::PostfixMatch:
+            return Match(x, val, expr.op_type_);
+        case OpType::Match: {
+            if constexpr (std::is_same_v<T, std::string>) {
+                auto iter = string_matchers_.find(&expr);
+                if (iter == string_matchers_.end()) {
+                    iter = string_matchers_.emplace(&expr, StringMatcher(OpType::Match, val)).first;
+                }
+                return iter->second(x);
+            } else {
+                PanicInfo("unsupported range node");
+            }
+        }
+        default: {
+            PanicInfo("unsupported range node");
+        }
+    }
+}
+
+template <typename T>
+bool
+LazyPredicate::EvalBinaryArithOpEvalRange(BinaryArithOpEvalRangeExpr& expr_raw) const {
+    auto& expr = static_cast<BinaryArithOpEvalRangeExprImpl<T>&>(expr_raw);
+    auto right_operand = expr.right_operand_;
+    auto val = expr.value_;
+    auto op = expr.op_type_;
+    auto x = GetValue<T>(expr.field_id_);
+    // same promotions as ExecExprVisitor, the arithmetic is not narrowed back to T
+    auto compare = [op, val](auto lhs) {
+        switch (op) {
+            case OpType::Equal:
+                return lhs == val;
+            case OpType::NotEqual:
+                return lhs != val;
+            default: {
+                PanicInfo("unsupported range node with arithmetic operation");
+            }
+        }
+    };
+    switch (expr.arith_op_) {
+        case ArithOpType::Add:
+            return compare(x + right_operand);
+        case ArithOpType::Sub:
+            return compare(x - right_operand);
+        case ArithOpType::Mul:
+            return compare(x * right_operand);
+        case ArithOpType::Div:
+            return compare(x / right_operand);
+        case ArithOpType::Mod:
+            return compare(static_cast<T>(fmod(x, right_operand)));
+        default: {
+            PanicInfo("unsupported arithmetic operation");
+        }
+    }
+}
+
+template <typename T>
+bool
+LazyPredicate::EvalBinaryRange(BinaryRangeExpr& expr_raw) const {
+    auto& expr = static_cast<BinaryRangeExprImpl<T>&>(expr_raw);
+    auto x = GetValue<T>(expr.field_id_);
+    auto& val1 = expr.lower_value_;
+    auto& val2 = expr.upper_value_;
+    auto lower = expr.lower_inclusive_ ? val1 <= x : val1 < x;
+    return lower && (expr.upper_inclusive_ ? x <= val2 : x < val2);
+}
+
+template <typename T>
+bool
+LazyPredicate::EvalTerm(TermExpr& expr_raw) const {
+    auto& expr = static_cast<TermExprImpl<T>&>(expr_raw);
+    // terms has already been sorted by the parser
+    return std::binary_search(expr.terms_.begin(), expr.terms_.end(), GetValue<T>(expr.field_id_));
+}
+
+void
+LazyPredicate::visit(UnaryRangeExpr& expr) {
+    switch (expr.data_type_) {
+        case DataType::BOOL:
+            result_ = EvalUnaryRange<bool>(expr);
+            break;
+        case DataType::INT8:
+            result_ = EvalUnaryRange<int8_t>(expr);
+            break;
+        case DataType::INT16:
+            result_ = EvalUnaryRange<int16_t>(expr);
+            break;
+        case DataType::INT32:
+            result_ = EvalUnaryRange<int32_t>(expr);
+            break;
+        case DataType::INT64:
+            result_ = EvalUnaryRange<int64_t>(expr);
+            break;
+        case DataType::FLOAT:
+            result_ = EvalUnaryRange<float>(expr);
+            break;
+        case DataType::DOUBLE:
+            result_ = EvalUnaryRange<double>(expr);
+            break;
+        case DataType::VARCHAR:
+            result_ = EvalUnaryRange<std::string>(expr);
+            break;
+        default:
+            PanicInfo("unsupported");
+    }
+}
+
+void
+LazyPredicate::visit(BinaryArithOpEvalRangeExpr& expr) {
+    switch (expr.data_type_) {
+        case DataType::INT8:
+            result_ = EvalBinaryArithOpEvalRange<int8_t>(expr);
+            break;
+        case DataType::INT16:
+            result_ = EvalBinaryArithOpEvalRange<int16_t>(expr);
+            break;
+        case DataType::INT32:
+            result_ = EvalBinaryArithOpEvalRange<int32_t>(expr);
+            break;
+        case DataType::INT64:
+            result_ = EvalBinaryArithOpEvalRange<int64_t>(expr);
+            break;
+        case DataType::FLOAT:
+            result_ = EvalBinaryArithOpEvalRange<float>(expr);
+            break;
+        case DataType::DOUBLE:
+            result_ = EvalBinaryArithOpEvalRange<double>(expr);
+            break;
+        default:
+            PanicInfo("unsupported");
+    }
+}
+
+void
+LazyPredicate::visit(BinaryRangeExpr& expr) {
+    switch (expr.data_type_) {
+        case DataType::BOOL:
+            result_ = EvalBinaryRange<bool>(expr);
+            break;
+        case DataType::INT8:
+            result_ = EvalBinaryRange<int8_t>(expr);
+            break;
+        case DataType::INT16:
+            result_ = EvalBinaryRange<int16_t>(expr);
+            break;
+        case DataType::INT32:
+            result_ = EvalBinaryRange<int32_t>(expr);
+            break;
+        case DataType::INT64:
+            result_ = EvalBinaryRange<int64_t>(expr);
+            break;
+        case DataType::FLOAT:
+            result_ = EvalBinaryRange<float>(expr);
+            break;
+        case DataType::DOUBLE:
+            result_ = EvalBinaryRange<double>(expr);
+            break;
+        case DataType::VARCHAR:
+            result_ = EvalBinaryRange<std::string>(expr);
+            break;
+        default:
+            PanicInfo("unsupported");
+    }
+}
+
+void
+LazyPredicate::visit(TermExpr& expr) {
+    switch (expr.data_type_) {
+        case DataType::BOOL:
+            result_ = EvalTerm<bool>(expr);
+            break;
+        case DataType::INT8:
+            result_ = EvalTerm<int8_t>(expr);
+            break;
+        case DataType::INT16:
+            result_ = EvalTerm<int16_t>(expr);
+            break;
+        case DataType::INT32:
+            result_ = EvalTerm<int32_t>(expr);
+            break;
+        case DataType::INT64:
+            result_ = EvalTerm<int64_t>(expr);
+            break;
+        case DataType::FLOAT:
+            result_ = EvalTerm<float>(expr);
+            break;
+        case DataType::DOUBLE:
+            result_ = EvalTerm<double>(expr);
+            break;
+        case DataType::VARCHAR:
+            result_ = EvalTerm<std::string>(expr);
+            break;
+        default:
+            PanicInfo("unsupported");
+    }
+}
+
+void
+LazyPredicate::visit(CompareExpr& expr) {
+    using number = boost::variant<bool, int8_t, int16_t, int32_t, int64_t, float, double, std::string>;
+    auto get_number = [this](DataType type, FieldId field_id) -> number {
+        switch (type) {
+            case DataType::BOOL:
+                return GetValue<bool>(field_id);
+            case DataType::INT8:
+                return GetValue<int8_t>(field_id);
+            case DataType::INT16:
+                return GetValue<int16_t>(field_id);
+            case DataType::INT32:
+                return GetValue<int32_t>(field_id);
+            case DataType::INT64:
+                return GetValue<int64_t>(field_id);
+            case DataType::FLOAT:
+                return GetValue<float>(field_id);
+            case DataType::DOUBLE:
+                return GetValue<double>(field_id);
+            case DataType::VARCHAR:
+                return GetValue<std::string>(field_id);
+            default:
+                PanicInfo("unsupported datatype");
+        }
+    };
+    auto left = get_number(expr.left_data_type_, expr.left_field_id_);
+    auto right = get_number(expr.right_data_type_, expr.right_field_id_);
+
+    switch (expr.op_type_) {
+        case OpType::Equal:
+            result_ = boost::apply_visitor(Relational<std::equal_to<>>{}, left, right);
+            break;
+        case OpType::NotEqual:
+            result_ = boost::apply_visitor(Relational<std::not_equal_to<>>{}, left, right);
+            break;
+        case OpType::GreaterEqual:
+            result_ = boost::apply_visitor(Relational<std::greater_equal<>>{}, left, right);
+            break;
+        case OpType::GreaterThan:
+            result_ = boost::apply_visitor(Relational<std::greater<>>{}, left, right);
+            break;
+        case OpType::LessEqual:
+            result_ = boost::apply_visitor(Relational<std::less_equal<>>{}, left, right);
+            break;
+        case OpType::LessThan:
+            result_ = boost::apply_visitor(Relational<std::less<>>{}, left, right);
+            break;
+        case OpType::PrefixMatch:
+            result_ = boost::apply_visitor(Relational<MatchOp<OpType::PrefixMatch>>{}, left, right);
+            break;
+        case OpType::PostfixMatch:
+            result_ = boost::apply_visitor(Relational<MatchOp<OpType::PostfixMatch>>{}, left, right);
+            break;
+        default: {
+            PanicInfo("unsupported optype");
+        }
+    }
+}
+
+void
+LazyPredicate::visit(UdfExpr& expr) {
+    auto& wasm_function_manager = WasmFunctionManager::getInstance();
+    if (registered_udfs_.insert(expr.func_name_).second) {
+        wasm_function_manager.RegisterFunction(expr.func_name_, expr.func_name_, expr.wasm_body_);
+    }
+
+    auto params_size = expr.values_.size();
+    std::vector<wasmtime::Val> params;
+    params.reserve(params_size);
+    for (int param_index = 0; param_index < params_size; ++param_index) {
+        auto& value = expr.values_[param_index];
+        auto is_field = expr.is_field_[param_index];
+        auto field_id = is_field ? boost::get<FieldId>(value) : FieldId(-1);
+        switch (expr.arg_types_[param_index]) {
+            case DataType::BOOL:
+                params.emplace_back(is_field ? GetValue<bool>(field_id) : boost::get<bool>(value));
+                break;
+            case DataType::INT8:
+                params.emplace_back(is_field ? GetValue<int8_t>(field_id) : boost::get<int8_t>(value));
+                break;
+            case DataType::INT16:
+                params.emplace_back(is_field ? GetValue<int16_t>(field_id) : boost::get<int16_t>(value));
+                break;
+            case DataType::INT32:
+                params.emplace_back(is_field ? GetValue<int32_t>(field_id) : boost::get<int32_t>(value));
+                break;
+            case DataType::INT64:
+                params.emplace_back(is_field ? GetValue<int64_t>(field_id) : boost::get<int64_t>(value));
+                break;
+            case DataType::FLOAT:
+                params.emplace_back(is_field ? GetValue<float>(field_id) : boost::get<float>(value));
+                break;
+            case DataType::DOUBLE:
+                params.emplace_back(is_field ? GetValue<double>(field_id) : boost::get<double>(value));
+                break;
+            default: {
+                PanicInfo("unsupported data type");
+            }
+        }
+    }
+    result_ = wasm_function_manager.runElemFunc(expr.func_name_, params);
+}
+
+// rough costs relative to comparing a raw numeric value in a sequential scan
+constexpr double kStringCompareCost = 8;
+// checking a candidate touches a random row instead of scanning
+constexpr double kRandomAccessCost = 2;
+// looking a row up in a scalar index, eager mode queries the index once for all rows instead
+constexpr double kReverseLookupCost = 16;
+// one call into the wasm runtime
+constexpr double kUdfCallCost = 64;
+
+static PredicateCost
+FieldCost(const segcore::SegmentInternalInterface& segment, FieldId field_id, DataType data_type) {
+    auto compare_cost = data_type == DataType::VARCHAR ? kStringCompareCost : 1;
+    if (segment.num_chunk_data(field_id) > 0) {
+        return {compare_cost, compare_cost + kRandomAccessCost};
+    }
+    return {1, compare_cost + kReverseLookupCost};
+}
+
+static PredicateCost
+operator+(const PredicateCost& left, const PredicateCost& right) {
+    return {left.eager + right.eager, left.lazy + right.lazy};
+}
+
+PredicateCost
+EstimatePredicateCost(const segcore::SegmentInternalInterface& segment, const Expr& expr) {
+    if (auto unary = dynamic_cast<const LogicalUnaryExpr*>(&expr)) {
+        return EstimatePredicateCost(segment, *unary->child_);
+    }
+    if (auto binary = dynamic_cast<const LogicalBinaryExpr*>(&expr)) {
+        // ignores short circuits of the lazy mode
+        return EstimatePredicateCost(segment, *binary->left_) + EstimatePredicateCost(segment, *binary->right_);
+    }
+    if (auto term = dynamic_cast<const TermExpr*>(&expr)) {
+        return FieldCost(segment, term->field_id_, term->data_type_);
+    }
+    if (auto unary_range = dynamic_cast<const UnaryRangeExpr*>(&expr)) {
+        return FieldCost(segment, unary_range->field_id_, unary_range->data_type_);
+    }
+    if (auto arith = dynamic_cast<const BinaryArithOpEvalRangeExpr*>(&expr)) {
+        return FieldCost(segment, arith->field_id_, arith->data_type_);
+    }
+    if (auto binary_range = dynamic_cast<const BinaryRangeExpr*>(&expr)) {
+        return FieldCost(segment, binary_range->field_id_, binary_range->data_type_);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&expr)) {
+        return FieldCost(segment, compare->left_field_id_, compare->left_data_type_) +
+               FieldCost(segment, compare->right_field_id_, compare->right_data_type_);
+    }
+    if (auto udf = dynamic_cast<const UdfExpr*>(&expr)) {
+        PredicateCost cost{kUdfCallCost, kUdfCallCost};
+        for (size_t i = 0; i < udf->values_.size(); ++i) {
+            if (udf->is_field_[i]) {
+                cost = cost + FieldCost(segment, boost::get<FieldId>(udf->values_[i]), udf->arg_types_[i]);
+            }
+        }
+        return cost;
+    }
+    PanicInfo("unsupported expr");
+}
+
+// below this per row cost, computing the bitset is cheap next to the vector search itself,
+// and an extra round of search when too many candidates fail would cost more than it saves
+constexpr double kMinLazyPredicateCost = kStringCompareCost;
+// lazy mode may need a few rounds of vector search, only take it with a clear margin
+constexpr double kLazyPredicateMargin = 4;
+
+bool
+PreferLazyPredicate(const PredicateCost& cost, int64_t row_count, int64_t num_candidates, double selectivity) {
+    if (cost.eager < kMinLazyPredicateCost || selectivity <= 0) {
+        return false;
+    }
+    // candidates failing the filter are replaced by further candidates
+    auto lazy_rows = num_candidates / selectivity;
+    if (lazy_rows >= row_count) {
+        return false;
+    }
+    return lazy_rows * cost.lazy * kLazyPredicateMargin < row_count * cost.eager;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,132 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/StringMatch.h"
+#include "common/Types.h"
+#include "query/Expr.h"
+#include "query/generated/ExprVisitor.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+// The filter of a search evaluated row by row on demand, instead of computing the bitset of all rows
+// up front as ExecExprVisitor does. Meant for expensive filters (udf, string matching) when the search
+// only checks a few candidates. Results are memoized, a row is evaluated at most once.
+class LazyPredicate : private ExprVisitor {
+ public:
+    LazyPredicate(const segcore::SegmentInternalInterface& segment, Expr& expr, int64_t row_count);
+
+    // whether the row at offset passes the filter
+    bool
+    operator()(int64_t offset);
+
+    // ratio of passing rows among sample_size rows spread over the segment, the samples stay memoized
+    double
+    EstimateSelectivity(int64_t sample_size);
+
+    int64_t
+    num_evaluated() const {
+        return num_evaluated_;
+    }
+
+ private:
+    void
+    visit(LogicalUnaryExpr& expr) override;
+
+    void
+    visit(LogicalBinaryExpr& expr) override;
+
+    void
+    visit(TermExpr& expr) override;
+
+    void
+    visit(UnaryRangeExpr& expr) override;
+
+    void
+    visit(BinaryArithOpEvalRangeExpr& expr) override;
+
+    void
+    visit(BinaryRangeExpr& expr) override;
+
+    void
+    visit(CompareExpr& expr) override;
+
+    void
+    visit(UdfExpr& expr) override;
+
+ private:
+    bool
+    Eval(Expr& expr);
+
+    // value of field at the current row, from raw data or the scalar index if raw data is not loaded
+    template <typename T>
+    T
+    GetValue(FieldId field_id) const;
+
+    template <typename T>
+    bool
+    EvalUnaryRange(UnaryRangeExpr& expr_raw);
+
+    template <typename T>
+    bool
+    EvalBinaryArithOpEvalRange(BinaryArithOpEvalRangeExpr& expr_raw) const;
+
+    template <typename T>
+    bool
+    EvalBinaryRange(BinaryRangeExpr& expr_raw) const;
+
+    template <typename T>
+    bool
+    EvalTerm(TermExpr& expr_raw) const;
+
+ private:
+    const segcore::SegmentInternalInterface& segment_;
+    Expr& expr_;
+    int64_t row_count_;
+    int64_t size_per_chunk_;
+
+    BitsetType evaluated_;
+    BitsetType passed_;
+    int64_t num_evaluated_ = 0;
+
+    // row being evaluated and the result of the last visit
+    int64_t offset_ = 0;
+    bool result_ = false;
+    std::unordered_set<std::string> registered_udfs_;
+    // dictionary encoded and packed columns of the segment, resolved once instead of once per row
+    std::unordered_map<FieldId, const segcore::StringDictColumn*> string_dicts_;
+    std::unordered_map<FieldId, const segcore::PackedIntColumn*> packed_ints_;
+    // matchers of the Match exprs, the pattern is parsed once per expr instead of once per row
+    std::unordered_map<const Expr*, StringMatcher> string_matchers_;
+};
+
+// per row cost of a filter, in units of comparing one raw numeric value
+struct PredicateCost {
+    // computing the bitset of all rows with ExecExprVisitor
+    double eager = 0;
+    // evaluating one candidate with LazyPredicate
+    double lazy = 0;
+};
+
+PredicateCost
+EstimatePredicateCost(const segcore::SegmentInternalInterface& segment, const Expr& expr);
+
+// whether evaluating the filter lazily on the candidates of a search beats computing it for all row_count rows,
+// num_candidates is nq * topk and selectivity the ratio of rows passing the filter
+bool
+PreferLazyPredicate(const PredicateCost& cost, int64_t row_count, int64_t num_candidates, double selectivity);
+
+}  // namespace milvus::query
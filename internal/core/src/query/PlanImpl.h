@@ -50,7 +50,8 @@ struct Plan {
 
  public:
     const Schema& schema_;
-    std::unique_ptr<VectorPlanNode> plan_node_;
+    // shared so that cached plans can hand out lightweight copies, see segcore/PlanCache.h
+    std::shared_ptr<VectorPlanNode> plan_node_;
     std::map<std::string, FieldId> tag2field_;  // PlaceholderName -> FieldId
     std::vector<FieldId> target_entries_;
     void
@@ -87,7 +88,7 @@ struct RetrievePlan {
 
  public:
     const Schema& schema_;
-    std::unique_ptr<RetrievePlanNode> plan_node_;
+    std::shared_ptr<RetrievePlanNode> plan_node_;
     std::vector<FieldId> field_ids_;
 };
 
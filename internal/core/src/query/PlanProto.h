@@ -11,7 +11,6 @@
 
 #pragma once
 
-#include <boost/dynamic_bitset.hpp>
 #include <memory>
 
 #include "Plan.h"
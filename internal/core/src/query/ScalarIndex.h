@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexSort.h"
 
@@ -29,9 +30,8 @@ generate_scalar_index(Span<T> data) {
     return indexing;
 }
 
-template <>
 inline index::ScalarIndexPtr<std::string>
-generate_scalar_index(Span<std::string> data) {
+generate_scalar_index(Span<std::string_view> data) {
     auto indexing = index::CreateStringIndexSort();
     indexing->Build(data.row_count(), data.data());
     return indexing;
@@ -56,7 +56,7 @@ generate_scalar_index(SpanBase data, DataType data_type) {
         case DataType::DOUBLE:
             return generate_scalar_index(Span<double>(data));
         case DataType::VARCHAR:
-            return generate_scalar_index(Span<std::string>(data));
+            return generate_scalar_index(Span<std::string_view>(data));
         default:
             PanicInfo("unsupported type");
     }
@@ -28,7 +28,8 @@ FloatIndexSearch(const segcore::SegmentGrowingImpl& segment,
                  int64_t num_queries,
                  int64_t ins_barrier,
                  const BitsetView& bitset,
-                 SubSearchResult& results) {
+                 SubSearchResult& results,
+                 std::vector<int64_t>& unindexed_chunks) {
     auto& schema = segment.get_schema();
     auto& indexing_record = segment.get_indexing_record();
     auto& record = segment.get_insert_record();
@@ -58,6 +59,12 @@ FloatIndexSearch(const segcore::SegmentGrowingImpl& segment,
             }
 
             auto indexing = field_indexing.get_chunk_indexing(chunk_id);
+            if (indexing == nullptr) {
+                // the build of the chunk failed, it is searched on raw data
+                unindexed_chunks.push_back(chunk_id);
+                current_chunk_id++;
+                continue;
+            }
             auto sub_view = bitset.subview(chunk_id * size_per_chunk, size_per_chunk);
             auto vec_index = (index::VectorIndex*)(indexing);
             auto sub_qr = SearchOnIndex(search_dataset, *vec_index, search_conf, sub_view);
@@ -106,16 +113,21 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
     dataset::SearchDataset search_dataset{metric_type, num_queries, topk, round_decimal, dim, query_data};
 
     int32_t current_chunk_id = 0;
+    std::vector<int64_t> unindexed_chunks;
     if (field.get_data_type() == DataType::VECTOR_FLOAT) {
-        current_chunk_id = FloatIndexSearch(segment, info, query_data, num_queries, active_count, bitset, final_qr);
+        current_chunk_id = FloatIndexSearch(segment, info, query_data, num_queries, active_count, bitset, final_qr,
+                                            unindexed_chunks);
     }
 
     // step 3: brute force search where small indexing is unavailable
     auto vec_ptr = record.get_field_data_base(vecfield_id);
     auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
     auto max_chunk = upper_div(active_count, vec_size_per_chunk);
-
     for (int chunk_id = current_chunk_id; chunk_id < max_chunk; ++chunk_id) {
+        unindexed_chunks.push_back(chunk_id);
+    }
+
+    for (auto chunk_id : unindexed_chunks) {
         auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
 
         auto element_begin = chunk_id * vec_size_per_chunk;
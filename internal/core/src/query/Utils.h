@@ -12,7 +12,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <type_traits>
+
 #include "query/Expr.h"
+#include "common/StringMatch.h"
 #include "common/Utils.h"
 
 namespace milvus::query {
@@ -20,19 +24,18 @@ namespace milvus::query {
 template <typename T, typename U>
 inline bool
 Match(const T& x, const U& y, OpType op) {
-    PanicInfo("not supported");
-}
-
-template <>
-inline bool
-Match<std::string>(const std::string& str, const std::string& val, OpType op) {
-    switch (op) {
-        case OpType::PrefixMatch:
-            return PrefixMatch(str, val);
-        case OpType::PostfixMatch:
-            return PostfixMatch(str, val);
-        default:
-            PanicInfo("not supported");
+    if constexpr (std::is_convertible_v<const T&, std::string_view> &&
+                  std::is_convertible_v<const U&, std::string_view>) {
+        switch (op) {
+            case OpType::PrefixMatch:
+                return PrefixMatch(x, y);
+            case OpType::PostfixMatch:
+                return PostfixMatch(x, y);
+            default:
+                PanicInfo("not supported");
+        }
+    } else {
+        PanicInfo("not supported");
     }
 }
 }  // namespace milvus::query
@@ -16,6 +16,7 @@
 #include <boost/variant.hpp>
 #include <utility>
 #include <deque>
+#include "common/QueryProfile.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/ExprImpl.h"
 #include "ExprVisitor.h"
@@ -52,9 +53,18 @@ class ExecExprVisitor : public ExprVisitor {
         : segment_(segment), row_count_(row_count), timestamp_(timestamp) {
     }
 
+    // collect per expr node stats, profile must outlive the visitor
+    void
+    set_profile(QueryProfile* profile) {
+        profile_ = profile;
+    }
+
     BitsetType
     call_child(Expr& expr) {
         Assert(!bitset_opt_.has_value());
+        if (profile_ != nullptr) {
+            return profiled_call_child(expr);
+        }
         expr.accept(*this);
         Assert(bitset_opt_.has_value());
         auto res = std::move(bitset_opt_);
@@ -67,9 +77,9 @@ class ExecExprVisitor : public ExprVisitor {
     auto
     ExecRangeVisitorImpl(FieldId field_id, IndexFunc func, ElementFunc element_func) -> BitsetType;
 
-    template <typename T, typename IndexFunc, typename ElementFunc>
+    template <typename T, typename ElementFunc>
     auto
-    ExecDataRangeVisitorImpl(FieldId field_id, IndexFunc index_func, ElementFunc element_func) -> BitsetType;
+    ExecDataRangeVisitorImpl(FieldId field_id, ElementFunc element_func) -> BitsetType;
 
     template <typename T>
     auto
@@ -94,11 +104,25 @@ class ExecExprVisitor : public ExprVisitor {
     auto
     ExecUdfVisitorDispatcher(UdfExpr& expr_raw) -> BitsetType;
 
+ private:
+    BitsetType
+    profiled_call_child(Expr& expr);
+
+    // record how the expr node being profiled was evaluated
+    void
+    mark_chunks(int64_t index_chunks, int64_t raw_data_chunks);
+
+    void
+    mark_udf();
+
  private:
     const segcore::SegmentInternalInterface& segment_;
     Timestamp timestamp_;
     int64_t row_count_;
 
     BitsetTypeOpt bitset_opt_;
+    QueryProfile* profile_ = nullptr;
+    // the expr node being profiled, -1 if none
+    int64_t profile_id_ = -1;
 };
 }  // namespace milvus::query
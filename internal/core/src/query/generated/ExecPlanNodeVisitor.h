@@ -13,6 +13,7 @@
 // Generated File
 // DO NOT EDIT
 #include "utils/Json.h"
+#include "common/QueryProfile.h"
 #include "query/PlanImpl.h"
 #include "segcore/SegmentGrowing.h"
 #include <utility>
@@ -42,6 +43,12 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
         placeholder_group_ = nullptr;
     }
 
+    // time the execution phases and the filter into profile, profile must outlive the visitor
+    void
+    set_profile(QueryProfile* profile) {
+        profile_ = profile;
+    }
+
     SearchResult
     get_moved_result(PlanNode& node) {
         assert(!search_result_opt_.has_value());
@@ -77,5 +84,6 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
 
     SearchResultOpt search_result_opt_;
     RetrieveResultOpt retrieve_result_opt_;
+    QueryProfile* profile_ = nullptr;
 };
 }  // namespace milvus::query
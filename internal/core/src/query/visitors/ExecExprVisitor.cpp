@@ -9,8 +9,11 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <chrono>
 #include <deque>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <boost/variant.hpp>
@@ -32,9 +35,17 @@ class ExecExprVisitor : ExprVisitor {
         : segment_(segment), row_count_(row_count), timestamp_(timestamp) {
     }
 
+    void
+    set_profile(QueryProfile* profile) {
+        profile_ = profile;
+    }
+
     BitsetType
     call_child(Expr& expr) {
         AssertInfo(!bitset_opt_.has_value(), "[ExecExprVisitor]Bitset already has value before accept");
+        if (profile_ != nullptr) {
+            return profiled_call_child(expr);
+        }
         expr.accept(*this);
         AssertInfo(bitset_opt_.has_value(), "[ExecExprVisitor]Bitset doesn't have value after accept");
         auto res = std::move(bitset_opt_);
@@ -75,14 +86,90 @@ class ExecExprVisitor : ExprVisitor {
     auto
     ExecUdfVisitorDispatcher(UdfExpr& expr_raw) -> BitsetType;
 
+ private:
+    BitsetType
+    profiled_call_child(Expr& expr);
+
+    void
+    mark_chunks(int64_t index_chunks, int64_t raw_data_chunks);
+
+    void
+    mark_udf();
+
  private:
     const segcore::SegmentInternalInterface& segment_;
     int64_t row_count_;
     Timestamp timestamp_;
     BitsetTypeOpt bitset_opt_;
+    QueryProfile* profile_ = nullptr;
+    int64_t profile_id_ = -1;
 };
 }  // namespace impl
 
+static std::string
+ExprName(const Expr& expr) {
+    if (dynamic_cast<const LogicalUnaryExpr*>(&expr)) {
+        return "LogicalUnaryExpr";
+    } else if (dynamic_cast<const LogicalBinaryExpr*>(&expr)) {
+        return "LogicalBinaryExpr";
+    } else if (auto term = dynamic_cast<const TermExpr*>(&expr)) {
+        return "TermExpr(field_id=" + std::to_string(term->field_id_.get()) + ")";
+    } else if (auto range = dynamic_cast<const UnaryRangeExpr*>(&expr)) {
+        return "UnaryRangeExpr(field_id=" + std::to_string(range->field_id_.get()) + ")";
+    } else if (auto arith = dynamic_cast<const BinaryArithOpEvalRangeExpr*>(&expr)) {
+        return "BinaryArithOpEvalRangeExpr(field_id=" + std::to_string(arith->field_id_.get()) + ")";
+    } else if (auto range = dynamic_cast<const BinaryRangeExpr*>(&expr)) {
+        return "BinaryRangeExpr(field_id=" + std::to_string(range->field_id_.get()) + ")";
+    } else if (auto compare = dynamic_cast<const CompareExpr*>(&expr)) {
+        return "CompareExpr(left_field_id=" + std::to_string(compare->left_field_id_.get()) +
+               ", right_field_id=" + std::to_string(compare->right_field_id_.get()) + ")";
+    } else if (auto udf = dynamic_cast<const UdfExpr*>(&expr)) {
+        return "UdfExpr(func_name=" + udf->func_name_ + ")";
+    }
+    return "Expr";
+}
+
+BitsetType
+ExecExprVisitor::profiled_call_child(Expr& expr) {
+    auto parent_id = profile_id_;
+    ExprProfile node;
+    node.expr = ExprName(expr);
+    node.depth = parent_id < 0 ? 0 : profile_->exprs[parent_id].depth + 1;
+    profile_id_ = profile_->exprs.size();
+    profile_->exprs.push_back(std::move(node));
+
+    auto start = std::chrono::steady_clock::now();
+    expr.accept(*this);
+    auto duration = std::chrono::steady_clock::now() - start;
+    AssertInfo(bitset_opt_.has_value(), "[ExecExprVisitor]Bitset doesn't have value after accept");
+    auto res = std::move(bitset_opt_.value());
+    bitset_opt_ = std::nullopt;
+
+    // time of a node includes its children
+    auto& profile = profile_->exprs[profile_id_];
+    profile.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    profile.rows_out = res.count();
+    profile_id_ = parent_id;
+    return res;
+}
+
+void
+ExecExprVisitor::mark_chunks(int64_t index_chunks, int64_t raw_data_chunks) {
+    if (profile_id_ < 0) {
+        return;
+    }
+    auto& profile = profile_->exprs[profile_id_];
+    profile.index_chunks += index_chunks;
+    profile.raw_data_chunks += raw_data_chunks;
+}
+
+void
+ExecExprVisitor::mark_udf() {
+    if (profile_id_ >= 0) {
+        profile_->exprs[profile_id_].udf = true;
+    }
+}
+
 void
 ExecExprVisitor::visit(LogicalUnaryExpr& expr) {
     using OpType = LogicalUnaryExpr::OpType;
@@ -134,21 +221,19 @@ ExecExprVisitor::visit(LogicalBinaryExpr& expr) {
 }
 
 static auto
-Assemble(const std::deque<BitsetType>& srcs) -> BitsetType {
-    BitsetType res;
+Assemble(std::deque<BitsetType>& srcs) -> BitsetType {
+    if (srcs.size() == 1) {
+        return std::move(srcs.front());
+    }
 
+    BitsetType res;
     int64_t total_size = 0;
     for (auto& chunk : srcs) {
         total_size += chunk.size();
     }
-    res.resize(total_size);
-
-    int64_t counter = 0;
+    res.reserve(total_size);
     for (auto& chunk : srcs) {
-        for (int64_t i = 0; i < chunk.size(); ++i) {
-            res[counter + i] = chunk[i];
-        }
-        counter += chunk.size();
+        res.append(chunk);
     }
     return res;
 }
@@ -163,35 +248,62 @@ ExecExprVisitor::ExecRangeVisitorImpl(FieldId field_id, IndexFunc index_func, El
     auto num_chunk = upper_div(row_count_, size_per_chunk);
     std::deque<BitsetType> results;
 
+    if constexpr (std::is_same_v<T, std::string>) {
+        // each distinct value of a dictionary encoded column is checked once, then the rows by their codes
+        if (auto string_dict = segment_.get_string_dict(field_id)) {
+            mark_chunks(0, num_chunk);
+            return string_dict->Match(row_count_, element_func);
+        }
+    }
+    if constexpr (std::is_same_v<T, int64_t>) {
+        // a packed column is decoded a word of the bitset at a time, or checked once per run
+        if (auto packed_int = segment_.get_packed_int(field_id)) {
+            mark_chunks(0, num_chunk);
+            return packed_int->Match(row_count_, element_func);
+        }
+    }
+
+    auto scan_chunk = [&](int64_t chunk_id) {
+        auto this_size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
+        BitsetType result(this_size);
+        // string columns are read as views, without copying the strings
+        auto chunk = segment_.chunk_data<ChunkViewType<T>>(field_id, chunk_id);
+        const ChunkViewType<T>* data = chunk.data();
+        for (int index = 0; index < this_size; ++index) {
+            result.set(index, element_func(data[index]));
+        }
+        AssertInfo(result.size() == this_size, "");
+        results.emplace_back(std::move(result));
+    };
+
     using Index = index::ScalarIndex<T>;
+    int64_t index_chunks = 0;
     for (auto chunk_id = 0; chunk_id < indexing_barrier; ++chunk_id) {
+        // a growing segment has no small index for the chunks whose build failed
+        if (!segment_.has_chunk_index(field_id, chunk_id)) {
+            scan_chunk(chunk_id);
+            continue;
+        }
         const Index& indexing = segment_.chunk_scalar_index<T>(field_id, chunk_id);
         // NOTE: knowhere is not const-ready
         // This is a dirty workaround
         auto data = index_func(const_cast<Index*>(&indexing));
         AssertInfo(data->size() == size_per_chunk, "[ExecExprVisitor]Data size not equal to size_per_chunk");
         results.emplace_back(std::move(*data));
+        ++index_chunks;
     }
     for (auto chunk_id = indexing_barrier; chunk_id < num_chunk; ++chunk_id) {
-        auto this_size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
-        BitsetType result(this_size);
-        auto chunk = segment_.chunk_data<T>(field_id, chunk_id);
-        const T* data = chunk.data();
-        for (int index = 0; index < this_size; ++index) {
-            result[index] = element_func(data[index]);
-        }
-        AssertInfo(result.size() == this_size, "");
-        results.emplace_back(std::move(result));
+        scan_chunk(chunk_id);
     }
+    mark_chunks(index_chunks, num_chunk - index_chunks);
     auto final_result = Assemble(results);
     AssertInfo(final_result.size() == row_count_, "[ExecExprVisitor]Final result size not equal to row count");
     return final_result;
 }
 
-template <typename T, typename IndexFunc, typename ElementFunc>
+template <typename T, typename ElementFunc>
 auto
-ExecExprVisitor::ExecDataRangeVisitorImpl(FieldId field_id, IndexFunc index_func, ElementFunc element_func)
-    -> BitsetType {
+ExecExprVisitor::ExecDataRangeVisitorImpl(FieldId field_id, ElementFunc element_func) -> BitsetType {
     auto& schema = segment_.get_schema();
     auto& field_meta = schema[field_id];
     auto size_per_chunk = segment_.size_per_chunk();
@@ -202,6 +314,13 @@ ExecExprVisitor::ExecDataRangeVisitorImpl(FieldId field_id, IndexFunc index_func
                "max(data_barrier, index_barrier) not equal to num_chunk");
     std::deque<BitsetType> results;
 
+    if constexpr (std::is_same_v<T, int64_t>) {
+        if (auto packed_int = segment_.get_packed_int(field_id)) {
+            mark_chunks(0, num_chunk);
+            return packed_int->Match(row_count_, element_func);
+        }
+    }
+
     // for growing segment, indexing_barrier will always less than data_barrier
     // so growing segment will always execute expr plan using raw data
     // if sealed segment has loaded raw data on this field, then index_barrier = 0 and data_barrier = 1
@@ -212,24 +331,28 @@ ExecExprVisitor::ExecDataRangeVisitorImpl(FieldId field_id, IndexFunc index_func
         auto chunk = segment_.chunk_data<T>(field_id, chunk_id);
         const T* data = chunk.data();
         for (int index = 0; index < this_size; ++index) {
-            result[index] = element_func(data[index]);
+            result.set(index, element_func(data[index]));
         }
         AssertInfo(result.size() == this_size, "[ExecExprVisitor]Chunk result size not equal to expected size");
         results.emplace_back(std::move(result));
     }
 
     // if sealed segment has loaded scalar index for this field, then index_barrier = 1 and data_barrier = 0
-    // in this case, sealed segment execute expr plan using scalar index
+    // in this case, sealed segment execute expr plan using scalar index, the values are reversed from
+    // the index in one batch and then checked like raw data
     using Index = index::ScalarIndex<T>;
     for (auto chunk_id = data_barrier; chunk_id < indexing_barrier; ++chunk_id) {
         auto& indexing = segment_.chunk_scalar_index<T>(field_id, chunk_id);
         auto this_size = const_cast<Index*>(&indexing)->Count();
+        std::vector<T> data(this_size);
+        indexing.ReverseLookupRange(0, this_size, data.data());
         BitsetType result(this_size);
         for (int offset = 0; offset < this_size; ++offset) {
-            result[offset] = index_func(const_cast<Index*>(&indexing), offset);
+            result.set(offset, element_func(data[offset]));
         }
         results.emplace_back(std::move(result));
     }
+    mark_chunks(indexing_barrier - data_barrier, data_barrier);
 
     auto final_result = Assemble(results);
     AssertInfo(final_result.size() == row_count_, "[ExecExprVisitor]Final result size not equal to row count");
@@ -243,50 +366,74 @@ auto
 ExecExprVisitor::ExecUnaryRangeVisitorDispatcher(UnaryRangeExpr& expr_raw) -> BitsetType {
     auto& expr = static_cast<UnaryRangeExprImpl<T>&>(expr_raw);
     using Index = index::ScalarIndex<T>;
+    using View = ChunkViewType<T>;
     auto op = expr.op_type_;
     auto val = expr.value_;
+    if constexpr (std::is_same_v<T, std::string>) {
+        // on a dictionary encoded column, equality, ranges and prefixes select a range of the codes
+        auto string_dict = segment_.get_string_dict(expr.field_id_);
+        if (string_dict != nullptr && op != OpType::PostfixMatch && op != OpType::Match) {
+            mark_chunks(0, upper_div(row_count_, segment_.size_per_chunk()));
+            return string_dict->Range(row_count_, op, val);
+        }
+    }
+    if constexpr (std::is_same_v<T, int64_t>) {
+        // on a packed column, equality and ranges are one unsigned compare per packed code
+        if (auto packed_int = segment_.get_packed_int(expr.field_id_)) {
+            mark_chunks(0, upper_div(row_count_, segment_.size_per_chunk()));
+            return packed_int->Range(row_count_, op, val);
+        }
+    }
     switch (op) {
         case OpType::Equal: {
             auto index_func = [val](Index* index) { return index->In(1, &val); };
-            auto elem_func = [val](T x) { return (x == val); };
+            auto elem_func = [val](const View& x) { return (x == val); };
             return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
         }
         case OpType::NotEqual: {
             auto index_func = [val](Index* index) { return index->NotIn(1, &val); };
-            auto elem_func = [val](T x) { return (x != val); };
+            auto elem_func = [val](const View& x) { return (x != val); };
             return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
         }
         case OpType::GreaterEqual: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::GreaterEqual); };
-            auto elem_func = [val](T x) { return (x >= val); };
+            auto elem_func = [val](const View& x) { return (x >= val); };
             return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
         }
         case OpType::GreaterThan: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::GreaterThan); };
-            auto elem_func = [val](T x) { return (x > val); };
+            auto elem_func = [val](const View& x) { return (x > val); };
             return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
         }
         case OpType::LessEqual: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::LessEqual); };
-            auto elem_func = [val](T x) { return (x <= val); };
+            auto elem_func = [val](const View& x) { return (x <= val); };
             return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
         }
         case OpType::LessThan: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::LessThan); };
-            auto elem_func = [val](T x) { return (x < val); };
+            auto elem_func = [val](const View& x) { return (x < val); };
             return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
         }
-        case OpType::PrefixMatch: {
-            auto index_func = [val](Index* index) {
-                auto dataset = std::make_unique<knowhere::Dataset>();
-                dataset->Set(milvus::index::OPERATOR_TYPE, OpType::PrefixMatch);
-                dataset->Set(milvus::index::PREFIX_VALUE, val);
-                return index->Query(std::move(dataset));
-            };
-            auto elem_func = [val, op](T x) { return Match(x, val, op); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+        case OpType::PrefixMatch:
+        case OpType::PostfixMatch:
+        case OpType::Match: {
+            if constexpr (std::is_same_v<T, std::string>) {
+                auto index_func = [val, op](Index* index) {
+                    auto dataset = std::make_unique<knowhere::Dataset>();
+                    dataset->Set(milvus::index::OPERATOR_TYPE, op);
+                    dataset->Set(op == OpType::PrefixMatch ? milvus::index::PREFIX_VALUE : milvus::index::MATCH_VALUE,
+                                 val);
+                    return index->Query(std::move(dataset));
+                };
+                // rows are matched in place, without copying the strings out of the column
+                StringMatcher matcher(op, val);
+                auto elem_func = [&matcher](std::string_view x) { return matcher(x); };
+                return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            } else {
+                PanicInfo("string match on non-string field");
+            }
         }
-        // TODO: PostfixMatch
         default: {
             PanicInfo("unsupported range node");
         }
@@ -300,7 +447,6 @@ template <typename T>
 auto
 ExecExprVisitor::ExecBinaryArithOpEvalRangeVisitorDispatcher(BinaryArithOpEvalRangeExpr& expr_raw) -> BitsetType {
     auto& expr = static_cast<BinaryArithOpEvalRangeExprImpl<T>&>(expr_raw);
-    using Index = index::ScalarIndex<T>;
     auto arith_op = expr.arith_op_;
     auto right_operand = expr.right_operand_;
     auto op = expr.op_type_;
@@ -310,46 +456,26 @@ ExecExprVisitor::ExecBinaryArithOpEvalRangeVisitorDispatcher(BinaryArithOpEvalRa
         case OpType::Equal: {
             switch (arith_op) {
                 case ArithOpType::Add: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x + right_operand) == val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x + right_operand) == val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Sub: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x - right_operand) == val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x - right_operand) == val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Mul: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x * right_operand) == val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x * right_operand) == val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Div: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x / right_operand) == val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x / right_operand) == val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Mod: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return static_cast<T>(fmod(x, right_operand)) == val;
-                    };
                     auto elem_func = [val, right_operand](T x) {
                         return (static_cast<T>(fmod(x, right_operand)) == val);
                     };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 default: {
                     PanicInfo("unsupported arithmetic operation");
@@ -359,46 +485,26 @@ ExecExprVisitor::ExecBinaryArithOpEvalRangeVisitorDispatcher(BinaryArithOpEvalRa
         case OpType::NotEqual: {
             switch (arith_op) {
                 case ArithOpType::Add: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x + right_operand) != val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x + right_operand) != val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Sub: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x - right_operand) != val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x - right_operand) != val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Mul: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x * right_operand) != val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x * right_operand) != val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Div: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return (x / right_operand) != val;
-                    };
                     auto elem_func = [val, right_operand](T x) { return ((x / right_operand) != val); };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 case ArithOpType::Mod: {
-                    auto index_func = [val, right_operand](Index* index, size_t offset) {
-                        auto x = index->Reverse_Lookup(offset);
-                        return static_cast<T>(fmod(x, right_operand)) != val;
-                    };
                     auto elem_func = [val, right_operand](T x) {
                         return (static_cast<T>(fmod(x, right_operand)) != val);
                     };
-                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+                    return ExecDataRangeVisitorImpl<T>(expr.field_id_, elem_func);
                 }
                 default: {
                     PanicInfo("unsupported arithmetic operation");
@@ -419,23 +525,36 @@ auto
 ExecExprVisitor::ExecBinaryRangeVisitorDispatcher(BinaryRangeExpr& expr_raw) -> BitsetType {
     auto& expr = static_cast<BinaryRangeExprImpl<T>&>(expr_raw);
     using Index = index::ScalarIndex<T>;
+    using View = ChunkViewType<T>;
     bool lower_inclusive = expr.lower_inclusive_;
     bool upper_inclusive = expr.upper_inclusive_;
     T val1 = expr.lower_value_;
     T val2 = expr.upper_value_;
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (auto string_dict = segment_.get_string_dict(expr.field_id_)) {
+            mark_chunks(0, upper_div(row_count_, segment_.size_per_chunk()));
+            return string_dict->Range(row_count_, val1, lower_inclusive, val2, upper_inclusive);
+        }
+    }
+    if constexpr (std::is_same_v<T, int64_t>) {
+        if (auto packed_int = segment_.get_packed_int(expr.field_id_)) {
+            mark_chunks(0, upper_div(row_count_, segment_.size_per_chunk()));
+            return packed_int->Range(row_count_, val1, lower_inclusive, val2, upper_inclusive);
+        }
+    }
 
     auto index_func = [=](Index* index) { return index->Range(val1, lower_inclusive, val2, upper_inclusive); };
     if (lower_inclusive && upper_inclusive) {
-        auto elem_func = [val1, val2](T x) { return (val1 <= x && x <= val2); };
+        auto elem_func = [val1, val2](const View& x) { return (val1 <= x && x <= val2); };
         return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
     } else if (lower_inclusive && !upper_inclusive) {
-        auto elem_func = [val1, val2](T x) { return (val1 <= x && x < val2); };
+        auto elem_func = [val1, val2](const View& x) { return (val1 <= x && x < val2); };
         return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
     } else if (!lower_inclusive && upper_inclusive) {
-        auto elem_func = [val1, val2](T x) { return (val1 < x && x <= val2); };
+        auto elem_func = [val1, val2](const View& x) { return (val1 < x && x <= val2); };
         return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
     } else {
-        auto elem_func = [val1, val2](T x) { return (val1 < x && x < val2); };
+        auto elem_func = [val1, val2](const View& x) { return (val1 < x && x < val2); };
         return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
     }
 }
@@ -588,7 +707,9 @@ struct relational {
 template <typename Op>
 auto
 ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetType {
-    using number = boost::variant<bool, int8_t, int16_t, int32_t, int64_t, float, double, std::string>;
+    // strings are viewed in place, in the raw data or in the values reversed from an index
+    using number =
+        boost::variant<bool, int8_t, int16_t, int32_t, int64_t, float, double, std::string, std::string_view>;
     auto size_per_chunk = segment_.size_per_chunk();
     auto num_chunk = upper_div(row_count_, size_per_chunk);
     std::deque<BitsetType> bitsets;
@@ -606,6 +727,19 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
 
     for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
         auto size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
+        // reverse a whole index chunk in one batch instead of looking up the index row by row
+        auto reverseChunk = [&, chunk_id](auto type_tag, FieldId field_id) -> std::function<const number(int)> {
+            using T = decltype(type_tag);
+            auto& indexing = segment_.chunk_scalar_index<T>(field_id, chunk_id);
+            auto count = const_cast<index::ScalarIndex<T>&>(indexing).Count();
+            std::shared_ptr<T[]> values(new T[count]);
+            indexing.ReverseLookupRange(0, count, values.get());
+            if constexpr (std::is_same_v<T, std::string>) {
+                return [values](int i) -> const number { return std::string_view(values[i]); };
+            } else {
+                return [values](int i) -> const number { return values[i]; };
+            }
+        };
         auto getChunkData = [&, chunk_id](DataType type, FieldId field_id,
                                           int64_t data_barrier) -> std::function<const number(int)> {
             switch (type) {
@@ -615,8 +749,7 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<bool>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(bool{}, field_id);
                     }
                 }
                 case DataType::INT8: {
@@ -625,8 +758,7 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<int8_t>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(int8_t{}, field_id);
                     }
                 }
                 case DataType::INT16: {
@@ -635,8 +767,7 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<int16_t>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(int16_t{}, field_id);
                     }
                 }
                 case DataType::INT32: {
@@ -645,18 +776,18 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<int32_t>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(int32_t{}, field_id);
                     }
                 }
                 case DataType::INT64: {
-                    if (chunk_id < data_barrier) {
+                    if (auto packed_int = segment_.get_packed_int(field_id)) {
+                        return [packed_int](int i) -> const number { return packed_int->Get(i); };
+                    } else if (chunk_id < data_barrier) {
                         auto chunk_data = segment_.chunk_data<int64_t>(field_id, chunk_id).data();
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<int64_t>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(int64_t{}, field_id);
                     }
                 }
                 case DataType::FLOAT: {
@@ -665,8 +796,7 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<float>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(float{}, field_id);
                     }
                 }
                 case DataType::DOUBLE: {
@@ -675,18 +805,18 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<double>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(double{}, field_id);
                     }
                 }
                 case DataType::VARCHAR: {
-                    if (chunk_id < data_barrier) {
-                        auto chunk_data = segment_.chunk_data<std::string>(field_id, chunk_id).data();
+                    if (auto string_dict = segment_.get_string_dict(field_id)) {
+                        return [string_dict](int i) -> const number { return string_dict->Decode(i); };
+                    } else if (chunk_id < data_barrier) {
+                        auto chunk_data = segment_.chunk_data<std::string_view>(field_id, chunk_id).data();
                         return [chunk_data](int i) -> const number { return chunk_data[i]; };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
-                        auto& indexing = segment_.chunk_scalar_index<std::string>(field_id, chunk_id);
-                        return [&indexing](int i) -> const number { return indexing.Reverse_Lookup(i); };
+                        return reverseChunk(std::string{}, field_id);
                     }
                 }
                 default:
@@ -699,10 +829,12 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
         BitsetType bitset(size);
         for (int i = 0; i < size; ++i) {
             bool is_in = boost::apply_visitor(Relational<decltype(op)>{}, left(i), right(i));
-            bitset[i] = is_in;
+            bitset.set(i, is_in);
         }
         bitsets.emplace_back(std::move(bitset));
     }
+    auto raw_data_chunks = std::min(left_data_barrier, right_data_barrier);
+    mark_chunks(num_chunk - raw_data_chunks, raw_data_chunks);
     auto final_result = Assemble(bitsets);
     AssertInfo(final_result.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
     return final_result;
@@ -748,8 +880,10 @@ ExecExprVisitor::visit(CompareExpr& expr) {
             res = ExecCompareExprDispatcher(expr, MatchOp<OpType::PrefixMatch>{});
             break;
         }
-            // case OpType::PostfixMatch: {
-            // }
+        case OpType::PostfixMatch: {
+            res = ExecCompareExprDispatcher(expr, MatchOp<OpType::PostfixMatch>{});
+            break;
+        }
         default: {
             PanicInfo("unsupported optype");
         }
@@ -798,9 +932,10 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> BitsetType {
         BitsetType bitset(row_count_);
         for (const auto& offset : seg_offsets) {
             auto _offset = (int64_t)offset.get();
-            bitset[_offset] = true;
+            bitset.set(_offset);
         }
         AssertInfo(bitset.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
+        mark_chunks(upper_div(row_count_, segment_.size_per_chunk()), 0);
         return bitset;
     }
 
@@ -808,6 +943,12 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> BitsetType {
     std::deque<BitsetType> bitsets;
     auto size_per_chunk = segment_.size_per_chunk();
     auto num_chunk = upper_div(row_count_, size_per_chunk);
+    if constexpr (std::is_same_v<T, int64_t>) {
+        if (auto packed_int = segment_.get_packed_int(field_id)) {
+            mark_chunks(0, num_chunk);
+            return packed_int->In(row_count_, expr.terms_.size(), expr.terms_.data());
+        }
+    }
     std::unordered_set<T> term_set(expr.terms_.begin(), expr.terms_.end());
     for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
         Span<T> chunk = segment_.chunk_data<T>(field_id, chunk_id);
@@ -815,10 +956,11 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> BitsetType {
         auto size = (chunk_id == num_chunk - 1) ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
         BitsetType bitset(size);
         for (int i = 0; i < size; ++i) {
-            bitset[i] = (term_set.find(chunk_data[i]) != term_set.end());
+            bitset.set(i, term_set.find(chunk_data[i]) != term_set.end());
         }
         bitsets.emplace_back(std::move(bitset));
     }
+    mark_chunks(0, num_chunk);
     auto final_result = Assemble(bitsets);
     AssertInfo(final_result.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
     return final_result;
@@ -836,10 +978,15 @@ ExecExprVisitor::ExecTermVisitorImpl<std::string>(TermExpr& expr_raw) -> BitsetT
     using Index = index::ScalarIndex<T>;
     const auto& terms = expr.terms_;
     auto n = terms.size();
-    std::unordered_set<T> term_set(expr.terms_.begin(), expr.terms_.end());
+    if (auto string_dict = segment_.get_string_dict(expr.field_id_)) {
+        mark_chunks(0, upper_div(row_count_, segment_.size_per_chunk()));
+        return string_dict->In(row_count_, n, terms.data());
+    }
+    // views of the terms, the rows are looked up in place
+    std::unordered_set<std::string_view> term_set(expr.terms_.begin(), expr.terms_.end());
 
     auto index_func = [&terms, n](Index* index) { return index->In(n, terms.data()); };
-    auto elem_func = [&terms, &term_set](T x) {
+    auto elem_func = [&terms, &term_set](std::string_view x) {
         //// terms has already been sorted.
         // return std::binary_search(terms.begin(), terms.end(), x);
         return term_set.find(x) != term_set.end();
@@ -945,6 +1092,9 @@ ExecExprVisitor::ExecUdfVisitorDispatcher(UdfExpr& expr) -> BitsetType {
                     return [chunk_data](int i) -> const number { return chunk_data[i]; };
                 }
                 case DataType::INT64: {
+                    if (auto packed_int = segment_.get_packed_int(field_id)) {
+                        return [packed_int](int i) -> const number { return packed_int->Get(i); };
+                    }
                     auto chunk_data = segment_.chunk_data<int64_t>(field_id, chunk_id).data();
                     return [chunk_data](int i) -> const number { return chunk_data[i]; };
                 }
@@ -1026,7 +1176,7 @@ ExecExprVisitor::ExecUdfVisitorDispatcher(UdfExpr& expr) -> BitsetType {
                 }
             }
             bool is_in = wasmFunctionManager.runElemFunc(func_name, params);
-            bitset[i] = is_in;
+            bitset.set(i, is_in);
             params.clear();
         }
 
@@ -1054,6 +1204,7 @@ ExecExprVisitor::visit(UdfExpr& expr) {
         }
     }
     BitsetType res;
+    mark_udf();
     res = ExecUdfVisitorDispatcher(expr);
     AssertInfo(res.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
     bitset_opt_ = std::move(res);
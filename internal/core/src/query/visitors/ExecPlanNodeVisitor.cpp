@@ -9,12 +9,17 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <cmath>
 #include <utility>
 
+#include "query/LazyPredicate.h"
 #include "query/PlanImpl.h"
+#include "query/SearchBruteForce.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
 #include "query/generated/ExecExprVisitor.h"
+#include "query/generated/ShowExprVisitor.h"
 #include "query/SubSearchResult.h"
+#include "segcore/SegcoreConfig.h"
 #include "segcore/SegmentGrowing.h"
 #include "utils/Json.h"
 
@@ -31,6 +36,11 @@ class ExecPlanNodeVisitor : PlanNodeVisitor {
         : segment_(segment), timestamp_(timestamp), placeholder_group_(placeholder_group) {
     }
 
+    void
+    set_profile(QueryProfile* profile) {
+        profile_ = profile;
+    }
+
     SearchResult
     get_moved_result(PlanNode& node) {
         assert(!search_result_opt_.has_value());
@@ -52,6 +62,7 @@ class ExecPlanNodeVisitor : PlanNodeVisitor {
     const PlaceholderGroup& placeholder_group_;
 
     SearchResultOpt search_result_opt_;
+    QueryProfile* profile_ = nullptr;
 };
 }  // namespace impl
 
@@ -66,6 +77,177 @@ empty_search_result(int64_t num_queries, SearchInfo& search_info) {
     return final_result;
 }
 
+// evaluate the filter, reusing the result cached by the segment if any
+static BitsetType
+ExecPredicate(const segcore::SegmentInternalInterface& segment,
+              Expr& predicate,
+              int64_t active_count,
+              Timestamp timestamp,
+              QueryProfile* profile) {
+    ProfilePhase phase(profile, "predicate");
+    auto exec = [&] {
+        ExecExprVisitor visitor(segment, active_count, timestamp);
+        visitor.set_profile(profile);
+        return visitor.call_child(predicate);
+    };
+
+    auto cache = segment.get_predicate_cache(timestamp);
+    if (cache == nullptr) {
+        return exec();
+    }
+
+    auto fingerprint = ShowExprVisitor().call_child(predicate).dump();
+    auto cached = cache->Get(fingerprint, active_count);
+    if (cached.has_value()) {
+        if (profile != nullptr) {
+            profile->predicate_cache_hit = true;
+        }
+        return std::move(cached.value());
+    }
+    auto bitset = exec();
+    cache->Put(fingerprint, bitset);
+    return bitset;
+}
+
+// rows sampled by the planner to estimate the selectivity of a filter
+constexpr int64_t kSelectivitySamples = 256;
+// rounds of lazy search before falling back to the bitset of all rows
+constexpr int kLazySearchRounds = 3;
+// topk limit of the vector search
+constexpr int64_t kMaxLazyCandidates = 16384;
+
+// choose between computing the filter for all rows (eager) and checking it on the candidates of the search
+// only (lazy) by the estimated cost of both, return the lazy filter if that is the cheaper one
+static std::unique_ptr<LazyPredicate>
+PlanLazyPredicate(const segcore::SegmentInternalInterface& segment,
+                  Expr& predicate,
+                  int64_t active_count,
+                  Timestamp timestamp,
+                  int64_t num_candidates,
+                  double& selectivity) {
+    // a cached bitset is shared by later queries, keep computing it
+    if (!segcore::SegcoreConfig::default_config().get_lazy_predicate_enabled() ||
+        segment.get_predicate_cache(timestamp) != nullptr) {
+        return nullptr;
+    }
+    auto cost = EstimatePredicateCost(segment, predicate);
+    // not even worth sampling if lazy mode loses when all rows pass
+    if (!PreferLazyPredicate(cost, active_count, num_candidates, 1)) {
+        return nullptr;
+    }
+    auto lazy_predicate = std::make_unique<LazyPredicate>(segment, predicate, active_count);
+    selectivity = lazy_predicate->EstimateSelectivity(kSelectivitySamples);
+    if (!PreferLazyPredicate(cost, active_count, num_candidates, selectivity)) {
+        return nullptr;
+    }
+    return lazy_predicate;
+}
+
+// search with the filter only checked on the candidates, in distance order.
+// candidates failing the filter are masked out in bitset, and the search is repeated with more candidates
+// until every query got topk results or all rows have been candidates.
+// return false if that didn't happen within kLazySearchRounds
+static bool
+LazyVectorSearch(const segcore::SegmentInternalInterface& segment,
+                 SearchInfo& search_info,
+                 const void* src_data,
+                 int64_t num_queries,
+                 Timestamp timestamp,
+                 LazyPredicate& predicate,
+                 double selectivity,
+                 BitsetType& bitset,
+                 SearchResult& search_result) {
+    auto topk = search_info.topk_;
+    SubSearchResult result(num_queries, topk, search_info.metric_type_, search_info.round_decimal_);
+    auto init_value = SubSearchResult::init_value(search_info.metric_type_);
+    auto num_candidates = static_cast<int64_t>(std::ceil(topk / selectivity * 2));
+
+    for (int round = 0; round < kLazySearchRounds; ++round) {
+        auto num_valid = static_cast<int64_t>(bitset.size() - bitset.count());
+        num_candidates = std::min(num_candidates, num_valid);
+        if (num_candidates == 0 || num_candidates > kMaxLazyCandidates) {
+            break;
+        }
+        auto candidate_info = search_info;
+        candidate_info.topk_ = num_candidates;
+        SearchResult candidates;
+        segment.vector_search(candidate_info, src_data, num_queries, timestamp, bitset, candidates);
+        AssertInfo(candidates.seg_offsets_.size() == num_queries * num_candidates,
+                   "[ExecPlanNodeVisitor]Size of candidates not equal to nq * topk");
+
+        auto& seg_offsets = result.mutable_seg_offsets();
+        auto& distances = result.mutable_distances();
+        std::fill(seg_offsets.begin(), seg_offsets.end(), -1);
+        std::fill(distances.begin(), distances.end(), init_value);
+        bool complete = true;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            int64_t found = 0;
+            for (int64_t i = 0; i < num_candidates && found < topk; ++i) {
+                auto pos = q * num_candidates + i;
+                auto offset = candidates.seg_offsets_[pos];
+                if (offset < 0) {
+                    continue;
+                }
+                if (predicate(offset)) {
+                    seg_offsets[q * topk + found] = offset;
+                    distances[q * topk + found] = candidates.distances_[pos];
+                    ++found;
+                } else {
+                    bitset.set(offset);
+                }
+            }
+            complete = complete && found == topk;
+        }
+        if (complete || num_candidates == num_valid) {
+            search_result.total_nq_ = num_queries;
+            search_result.unity_topK_ = topk;
+            search_result.seg_offsets_ = std::move(seg_offsets);
+            search_result.distances_ = std::move(distances);
+            return true;
+        }
+        num_candidates *= 4;
+    }
+    return false;
+}
+
+// brute force over just the rows passing the filter, used when they are few: an index search would visit
+// mostly filtered rows and lose recall. return false if the segment can't provide their vectors
+static bool
+ExactSearchOnSurvivors(const segcore::SegmentInternalInterface& segment,
+                       const SearchInfo& search_info,
+                       const void* src_data,
+                       int64_t num_queries,
+                       const BitsetType& bitset,
+                       SearchResult& search_result) {
+    auto survivors = ~bitset;
+    std::vector<int64_t> seg_offsets;
+    seg_offsets.reserve(survivors.count());
+    for (auto offset = survivors.find_first(); offset != BitsetType::npos; offset = survivors.find_next(offset)) {
+        seg_offsets.push_back(offset);
+    }
+
+    auto& field_meta = segment.get_schema()[search_info.field_id_];
+    aligned_vector<char> vectors(field_meta.get_sizeof() * seg_offsets.size());
+    if (!segment.get_vectors(search_info.field_id_, seg_offsets.data(), seg_offsets.size(), vectors.data())) {
+        return false;
+    }
+
+    dataset::SearchDataset dataset{search_info.metric_type_,   num_queries,         search_info.topk_,
+                                   search_info.round_decimal_, field_meta.get_dim(), src_data};
+    auto sub_result = BruteForceSearch(dataset, vectors.data(), seg_offsets.size(), nullptr);
+    // convert survivor index to segment offset
+    for (auto& x : sub_result.mutable_seg_offsets()) {
+        if (x != -1) {
+            x = seg_offsets[x];
+        }
+    }
+    search_result.total_nq_ = num_queries;
+    search_result.unity_topK_ = search_info.topk_;
+    search_result.seg_offsets_ = std::move(sub_result.mutable_seg_offsets());
+    search_result.distances_ = std::move(sub_result.mutable_distances());
+    return true;
+}
+
 template <typename VectorType>
 void
 ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
@@ -88,23 +270,81 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
         return;
     }
 
-    BitsetType bitset_holder;
+    std::unique_ptr<LazyPredicate> lazy_predicate;
+    double selectivity = 1;
     if (node.predicate_.has_value()) {
-        bitset_holder = ExecExprVisitor(*segment, active_count, timestamp_).call_child(*node.predicate_.value());
+        lazy_predicate = PlanLazyPredicate(*segment, *node.predicate_.value(), active_count, timestamp_,
+                                           num_queries * node.search_info_.topk_, selectivity);
+    }
+
+    BitsetType bitset_holder;
+    if (node.predicate_.has_value() && lazy_predicate == nullptr) {
+        bitset_holder = ExecPredicate(*segment, *node.predicate_.value(), active_count, timestamp_, profile_);
         bitset_holder.flip();
     } else {
         bitset_holder.resize(active_count, false);
     }
-    segment->mask_with_timestamps(bitset_holder, timestamp_);
-
-    segment->mask_with_delete(bitset_holder, active_count, timestamp_);
+    {
+        ProfilePhase phase(profile_, "mask_with_timestamps");
+        segment->mask_with_timestamps(bitset_holder, timestamp_);
+    }
+    {
+        ProfilePhase phase(profile_, "mask_with_delete");
+        segment->mask_with_delete(bitset_holder, active_count, timestamp_);
+    }
     // if bitset_holder is all 1's, we got empty result
     if (bitset_holder.count() == bitset_holder.size()) {
         search_result_opt_ = empty_search_result(num_queries, node.search_info_);
         return;
     }
+
+    if (lazy_predicate != nullptr) {
+        bool done;
+        {
+            ProfilePhase phase(profile_, "lazy_vector_search");
+            done = LazyVectorSearch(*segment, node.search_info_, src_data, num_queries, timestamp_, *lazy_predicate,
+                                    selectivity, bitset_holder, search_result);
+        }
+        if (profile_ != nullptr) {
+            profile_->lazy_predicate = true;
+            profile_->lazy_predicate_rows = lazy_predicate->num_evaluated();
+        }
+        if (done) {
+            if (profile_ != nullptr) {
+                profile_->search_strategy = "lazy_predicate";
+            }
+            search_result_opt_ = std::move(search_result);
+            return;
+        }
+        // too few candidates passed, fall back to the bitset of all rows,
+        // the candidates known to fail are masked out already
+        bitset_holder |= ~ExecPredicate(*segment, *node.predicate_.value(), active_count, timestamp_, profile_);
+        if (bitset_holder.count() == bitset_holder.size()) {
+            search_result_opt_ = empty_search_result(num_queries, node.search_info_);
+            return;
+        }
+    }
+
+    auto num_survivors = static_cast<int64_t>(bitset_holder.size() - bitset_holder.count());
+    if (num_survivors <= segcore::SegcoreConfig::default_config().get_exact_search_threshold()) {
+        ProfilePhase phase(profile_, "exact_search");
+        if (ExactSearchOnSurvivors(*segment, node.search_info_, src_data, num_queries, bitset_holder, search_result)) {
+            if (profile_ != nullptr) {
+                profile_->search_strategy = "exact_on_survivors";
+            }
+            search_result_opt_ = std::move(search_result);
+            return;
+        }
+    }
+
     BitsetView final_view = bitset_holder;
-    segment->vector_search(node.search_info_, src_data, num_queries, timestamp_, final_view, search_result);
+    {
+        ProfilePhase phase(profile_, "vector_search");
+        segment->vector_search(node.search_info_, src_data, num_queries, timestamp_, final_view, search_result);
+    }
+    if (profile_ != nullptr) {
+        profile_->search_strategy = "vector_search";
+    }
 
     search_result_opt_ = std::move(search_result);
 }
@@ -125,13 +365,17 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
 
     BitsetType bitset_holder;
     if (node.predicate_ != nullptr) {
-        bitset_holder = ExecExprVisitor(*segment, active_count, timestamp_).call_child(*(node.predicate_));
+        bitset_holder = ExecPredicate(*segment, *node.predicate_, active_count, timestamp_, profile_);
         bitset_holder.flip();
     }
-
-    segment->mask_with_timestamps(bitset_holder, timestamp_);
-
-    segment->mask_with_delete(bitset_holder, active_count, timestamp_);
+    {
+        ProfilePhase phase(profile_, "mask_with_timestamps");
+        segment->mask_with_timestamps(bitset_holder, timestamp_);
+    }
+    {
+        ProfilePhase phase(profile_, "mask_with_delete");
+        segment->mask_with_delete(bitset_holder, active_count, timestamp_);
+    }
     // if bitset_holder is all 1's, we got empty result
     if (bitset_holder.count() == bitset_holder.size()) {
         retrieve_result_opt_ = std::move(retrieve_result);
@@ -139,6 +383,7 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
     }
 
     BitsetView final_view = bitset_holder;
+    ProfilePhase phase(profile_, "search_ids");
     auto seg_offsets = segment->search_ids(final_view, timestamp_);
     retrieve_result.result_offsets_.assign((int64_t*)seg_offsets.data(),
                                            (int64_t*)seg_offsets.data() + seg_offsets.size());
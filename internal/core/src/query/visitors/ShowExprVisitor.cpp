@@ -86,6 +86,8 @@ ShowExprVisitor::visit(LogicalBinaryExpr& expr) {
                 return "LogicalOr";
             case OpType::LogicalXor:
                 return "LogicalXor";
+            case OpType::LogicalMinus:
+                return "LogicalMinus";
             default:
                 PanicInfo("unsupported op");
         }
@@ -126,6 +128,8 @@ ShowExprVisitor::visit(TermExpr& expr) {
                 return TermExtract<double>(expr);
             case DataType::FLOAT:
                 return TermExtract<float>(expr);
+            case DataType::VARCHAR:
+                return TermExtract<std::string>(expr);
             default:
                 PanicInfo("unsupported type");
         }
@@ -180,6 +184,9 @@ ShowExprVisitor::visit(UnaryRangeExpr& expr) {
         case DataType::FLOAT:
             json_opt_ = UnaryRangeExtract<float>(expr);
             return;
+        case DataType::VARCHAR:
+            json_opt_ = UnaryRangeExtract<std::string>(expr);
+            return;
         default:
             PanicInfo("unsupported type");
     }
@@ -228,6 +235,9 @@ ShowExprVisitor::visit(BinaryRangeExpr& expr) {
         case DataType::FLOAT:
             json_opt_ = BinaryRangeExtract<float>(expr);
             return;
+        case DataType::VARCHAR:
+            json_opt_ = BinaryRangeExtract<std::string>(expr);
+            return;
         default:
             PanicInfo("unsupported type");
     }
@@ -299,6 +309,32 @@ ShowExprVisitor::visit(BinaryArithOpEvalRangeExpr& expr) {
 
 void
 ShowExprVisitor::visit(UdfExpr& expr) {
-    // TODO
+    AssertInfo(!json_opt_.has_value(), "[ShowExprVisitor]Ret json already has value before visit");
+    Json values = Json::array();
+    for (auto& value : expr.values_) {
+        values.push_back(boost::apply_visitor(
+            [](auto&& arg) -> Json {
+                using T = std::decay_t<decltype(arg)>;
+                if constexpr (std::is_same_v<T, FieldId>) {
+                    return Json{{"field_id", arg.get()}};
+                } else {
+                    return Json(arg);
+                }
+            },
+            value));
+    }
+    Json arg_types = Json::array();
+    for (auto data_type : expr.arg_types_) {
+        arg_types.push_back(datatype_name(data_type));
+    }
+
+    // the whole wasm body is shown, since the output identifies the predicate in the predicate cache.
+    // It is a proto3 string, so it is valid UTF-8 and can be dumped
+    Json res{{"expr_type", "Udf"},
+             {"func_name", expr.func_name_},
+             {"values", std::move(values)},
+             {"arg_types", std::move(arg_types)},
+             {"wasm_body", expr.wasm_body_}};
+    json_opt_ = res;
 }
 }  // namespace milvus::query
@@ -11,10 +11,10 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <map>
 #include <mutex>
-#include <set>
-#include <shared_mutex>
 
 namespace milvus::segcore {
 
@@ -40,41 +40,127 @@ example() {
 }
 #endif
 
+// Lock free in the common case: a segment starting at ack moves ack forward with one CAS, other segments
+// are parked in a fixed ring of slots, where whoever moves ack to a parked segment's begin picks it up.
+// A segment is parked at the first free slot from begin % NUM_SLOTS on, and only goes to a mutex protected
+// map when the ring is full.
 class AckResponder {
  public:
     // specify that segment [seg_begin, seg_end) has been processed
     // WARN: segments shouldn't overlap
     void
     AddSegment(int64_t seg_begin, int64_t seg_end) {
-        std::lock_guard lck(mutex_);
-        fetch_and_flip(seg_end);
-        auto old_begin = fetch_and_flip(seg_begin);
-        if (old_begin) {
-            minimum_ = *acks_.begin();
+        if (seg_begin == seg_end) {
+            return;
+        }
+        auto expected = seg_begin;
+        if (!ack_.compare_exchange_strong(expected, seg_end)) {
+            park(seg_begin, seg_end);
         }
+        // ack may have reached a parked segment, either just now or while this one was being parked
+        advance();
     }
 
     // return ack
     int64_t
     GetAck() const {
-        return minimum_;
+        return ack_.load(std::memory_order_acquire);
     }
 
  private:
-    bool
-    fetch_and_flip(int64_t endpoint) {
-        if (acks_.count(endpoint)) {
-            acks_.erase(endpoint);
-            return true;
-        } else {
-            acks_.insert(endpoint);
-            return false;
+    static constexpr int64_t EMPTY = -1;
+    // taken by a thread filling or emptying the slot, no segment starts at it
+    static constexpr int64_t CLAIMED = -2;
+    static constexpr size_t NUM_SLOTS = 256;
+
+    struct Slot {
+        // begin is published after end, and reset to EMPTY by the thread moving ack past the segment
+        std::atomic<int64_t> begin = EMPTY;
+        std::atomic<int64_t> end = 0;
+    };
+
+    void
+    park(int64_t seg_begin, int64_t seg_end) {
+        for (size_t i = 0; i < NUM_SLOTS; ++i) {
+            auto& slot = slots_[(seg_begin + i) % NUM_SLOTS];
+            if (slot.begin.load(std::memory_order_relaxed) != EMPTY) {
+                continue;
+            }
+            // claim first, so that no one takes the slot before end is set
+            auto expected = EMPTY;
+            if (slot.begin.compare_exchange_strong(expected, CLAIMED)) {
+                auto max_probe = max_probe_.load();
+                while (max_probe < i && !max_probe_.compare_exchange_weak(max_probe, i)) {
+                }
+                slot.end.store(seg_end, std::memory_order_relaxed);
+                slot.begin.store(seg_begin);
+                parked_.fetch_add(1);
+                return;
+            }
         }
+        std::lock_guard lck(mutex_);
+        overflow_.emplace(seg_begin, seg_end);
+        overflow_size_.fetch_add(1);
+        parked_.fetch_add(1);
+    }
+
+    // move ack over the parked segments starting at it, until there is a gap
+    void
+    advance() {
+        while (true) {
+            auto ack = ack_.load();
+            auto end = take(ack);
+            if (end == EMPTY) {
+                return;
+            }
+            // begins are unique and ack only grows, so only one thread can find the segment starting at ack
+            ack_.store(end);
+        }
+    }
+
+    // end of the parked segment starting at begin, which is removed, or EMPTY if there is none
+    int64_t
+    take(int64_t begin) {
+        // segments arriving in order never look at the ring
+        if (parked_.load() == 0) {
+            return EMPTY;
+        }
+        // a segment is parked at most max_probe_ slots after its home slot
+        auto max_probe = max_probe_.load();
+        for (size_t i = 0; i <= max_probe; ++i) {
+            auto& slot = slots_[(begin + i) % NUM_SLOTS];
+            auto expected = begin;
+            if (slot.begin.load() == begin && slot.begin.compare_exchange_strong(expected, CLAIMED)) {
+                auto end = slot.end.load(std::memory_order_relaxed);
+                slot.begin.store(EMPTY);
+                parked_.fetch_sub(1);
+                return end;
+            }
+        }
+        if (overflow_size_.load() > 0) {
+            std::lock_guard lck(mutex_);
+            auto iter = overflow_.find(begin);
+            if (iter != overflow_.end()) {
+                auto end = iter->second;
+                overflow_.erase(iter);
+                overflow_size_.fetch_sub(1);
+                parked_.fetch_sub(1);
+                return end;
+            }
+        }
+        return EMPTY;
     }
 
  private:
-    std::shared_mutex mutex_;
-    std::set<int64_t> acks_ = {0};
-    std::atomic<int64_t> minimum_ = 0;
+    std::atomic<int64_t> ack_ = 0;
+    std::array<Slot, NUM_SLOTS> slots_;
+    // segments in the ring or in overflow_
+    std::atomic<int64_t> parked_ = 0;
+    // the farthest a segment was parked from its home slot, begin % NUM_SLOTS
+    std::atomic<size_t> max_probe_ = 0;
+
+    std::mutex mutex_;
+    std::map<int64_t, int64_t> overflow_;
+    std::atomic<int64_t> overflow_size_ = 0;
 };
 }  // namespace milvus::segcore
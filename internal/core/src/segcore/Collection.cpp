@@ -13,11 +13,15 @@
 
 #include "pb/schema.pb.h"
 #include "segcore/Collection.h"
+#include "segcore/SegcoreConfig.h"
 
 namespace milvus::segcore {
 
 Collection::Collection(const std::string& collection_proto) : schema_proto_(collection_proto) {
     parse();
+    // the plan cache config is read once here, so changing it only affects the collections created afterwards
+    auto& config = SegcoreConfig::default_config();
+    plan_cache_ = std::make_unique<PlanCache>(config.get_plan_cache_capacity(), config.get_plan_cache_memory_limit());
 }
 
 void
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "common/Schema.h"
+#include "segcore/PlanCache.h"
 
 namespace milvus::segcore {
 
@@ -36,10 +37,16 @@ class Collection {
         return collection_name_;
     }
 
+    PlanCache&
+    get_plan_cache() {
+        return *plan_cache_;
+    }
+
  private:
     std::string collection_name_;
     std::string schema_proto_;
     SchemaPtr schema_;
+    std::unique_ptr<PlanCache> plan_cache_;
 };
 
 using CollectionPtr = std::unique_ptr<Collection>;
@@ -13,6 +13,25 @@
 
 namespace milvus::segcore {
 
+char*
+StringArena::Allocate(size_t size) {
+    std::lock_guard lck(mutex_);
+    byte_size_ += size;
+    if (size > remaining_) {
+        if (size >= BLOCK_SIZE) {
+            blocks_.emplace_back(new char[size]);
+            return blocks_.back().get();
+        }
+        blocks_.emplace_back(new char[BLOCK_SIZE]);
+        cursor_ = blocks_.back().get();
+        remaining_ = BLOCK_SIZE;
+    }
+    auto ptr = cursor_;
+    cursor_ += size;
+    remaining_ -= size;
+    return ptr;
+}
+
 void
 VectorBase::set_data_raw(ssize_t element_offset,
                          ssize_t element_count,
@@ -57,10 +76,10 @@ VectorBase::set_data_raw(ssize_t element_offset,
             return set_data_raw(element_offset, data->scalars().double_data().data().data(), element_count);
         }
         case DataType::VARCHAR: {
-            auto begin = data->scalars().string_data().data().begin();
-            auto end = data->scalars().string_data().data().end();
-            std::vector<std::string> data_raw(begin, end);
-            return set_data_raw(element_offset, data_raw.data(), element_count);
+            // copy the strings straight from the message into the arena
+            auto vec = dynamic_cast<ConcurrentVector<std::string>*>(this);
+            AssertInfo(vec != nullptr, "VARCHAR field data is not a string column");
+            return vec->set_data(element_offset, data->scalars().string_data().data().begin(), element_count);
         }
         default: {
             PanicInfo("unsupported");
@@ -109,10 +128,9 @@ VectorBase::fill_chunk_data(ssize_t element_count, const DataArray* data, const
             return fill_chunk_data(data->scalars().double_data().data().data(), element_count);
         }
         case DataType::VARCHAR: {
-            auto begin = data->scalars().string_data().data().begin();
-            auto end = data->scalars().string_data().data().end();
-            std::vector<std::string> data_raw(begin, end);
-            return fill_chunk_data(data_raw.data(), element_count);
+            auto vec = dynamic_cast<ConcurrentVector<std::string>*>(this);
+            AssertInfo(vec != nullptr, "VARCHAR field data is not a string column");
+            return vec->fill_chunk_data(data->scalars().string_data().data().begin(), element_count);
         }
         default: {
             PanicInfo("unsupported");
@@ -11,11 +11,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cstring>
 #include <deque>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <memory>
 #include <unordered_map>
 #include <shared_mutex>
 #include <utility>
@@ -31,9 +35,21 @@
 
 namespace milvus::segcore {
 
+// Append-only vector whose elements never move. Elements live in blocks of doubling size, found through a
+// fixed directory of atomically published block pointers, so readers never lock and writers only lock
+// each other out to grow it
 template <typename Type>
 class ThreadSafeVector {
  public:
+    ThreadSafeVector() = default;
+    ThreadSafeVector(const ThreadSafeVector&) = delete;
+    ThreadSafeVector&
+    operator=(const ThreadSafeVector&) = delete;
+
+    ~ThreadSafeVector() {
+        clear();
+    }
+
     template <typename... Args>
     void
     emplace_to_at_least(int64_t size, Args... args) {
@@ -41,23 +57,31 @@ class ThreadSafeVector {
             return;
         }
         std::lock_guard lck(mutex_);
-        while (vec_.size() < size) {
-            vec_.emplace_back(std::forward<Args...>(args...));
-            ++size_;
+        for (auto index = size_.load(std::memory_order_relaxed); index < size; ++index) {
+            auto [block, offset] = locate(index);
+            auto ptr = blocks_[block].load(std::memory_order_relaxed);
+            if (ptr == nullptr) {
+                ptr = std::allocator<Type>().allocate(block_size(block));
+                blocks_[block].store(ptr, std::memory_order_release);
+            }
+            new (ptr + offset) Type(args...);
+            // publish the element, readers check the index against size_ first
+            size_.store(index + 1, std::memory_order_release);
         }
     }
+
     const Type&
     operator[](int64_t index) const {
         Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        auto [block, offset] = locate(index);
+        return blocks_[block].load(std::memory_order_acquire)[offset];
     }
 
     Type&
     operator[](int64_t index) {
         Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        auto [block, offset] = locate(index);
+        return blocks_[block].load(std::memory_order_acquire)[offset];
     }
 
     int64_t
@@ -65,17 +89,43 @@ class ThreadSafeVector {
         return size_;
     }
 
+    // not safe against concurrent readers
     void
     clear() {
         std::lock_guard lck(mutex_);
+        auto size = size_.load(std::memory_order_relaxed);
+        for (int64_t index = 0; index < size; ++index) {
+            auto [block, offset] = locate(index);
+            blocks_[block].load(std::memory_order_relaxed)[offset].~Type();
+        }
+        for (int block = 0; block < MAX_BLOCKS; ++block) {
+            auto ptr = blocks_[block].exchange(nullptr, std::memory_order_relaxed);
+            if (ptr != nullptr) {
+                std::allocator<Type>().deallocate(ptr, block_size(block));
+            }
+        }
         size_ = 0;
-        vec_.clear();
+    }
+
+ private:
+    // block b holds the elements [2^b - 1, 2^(b+1) - 1)
+    static constexpr int MAX_BLOCKS = 63;
+
+    static int64_t
+    block_size(int block) {
+        return int64_t(1) << block;
+    }
+
+    static std::pair<int, int64_t>
+    locate(int64_t index) {
+        int block = 63 - __builtin_clzll(index + 1);
+        return {block, index + 1 - block_size(block)};
     }
 
  private:
     std::atomic<int64_t> size_ = 0;
-    std::deque<Type> vec_;
-    mutable std::shared_mutex mutex_;
+    std::atomic<Type*> blocks_[MAX_BLOCKS] = {};
+    std::mutex mutex_;
 };
 
 class VectorBase {
@@ -286,6 +336,46 @@ class ConcurrentVectorImpl : public VectorBase {
     ThreadSafeVector<Chunk> chunks_;
 };
 
+// Bytes of the strings in one chunk of a string column. Strings are copied in one contiguous range per batch,
+// taken from blocks which never move, so views into the arena stay valid while the chunk is filled
+class StringArena {
+ public:
+    StringArena() = default;
+    StringArena(const StringArena&) = delete;
+    StringArena&
+    operator=(const StringArena&) = delete;
+
+    // size contiguous bytes, safe to call concurrently
+    char*
+    Allocate(size_t size);
+
+    size_t
+    ByteSize() const {
+        return byte_size_;
+    }
+
+ private:
+    // batches smaller than a block share blocks, larger ones get a block of their own
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_ = nullptr;
+    size_t remaining_ = 0;
+    std::atomic<size_t> byte_size_ = 0;
+};
+
+// Arrow-like chunk of a string column: a view per row into the bytes packed in the arena, instead of a
+// std::string per row. Rows of a growing segment are filled out of order, so the offsets are kept per row
+// as views rather than as a prefix sum, which also lets the column be read as a Span<std::string_view>
+struct StringChunk {
+    explicit StringChunk(int64_t size) : views(size) {
+    }
+
+    FixedVector<std::string_view> views;
+    StringArena arena;
+};
+
 template <typename Type>
 class ConcurrentVector : public ConcurrentVectorImpl<Type, true> {
  public:
@@ -315,4 +405,131 @@ class ConcurrentVector<BinaryVector> : public ConcurrentVectorImpl<uint8_t, fals
     int64_t binary_dim_;
 };
 
+// VARCHAR column, the raw source of set_data_raw and fill_chunk_data is an array of std::string
+template <>
+class ConcurrentVector<std::string> : public VectorBase {
+ public:
+    using Chunk = StringChunk;
+
+    explicit ConcurrentVector(int64_t size_per_chunk) : VectorBase(size_per_chunk) {
+    }
+
+    void
+    grow_to_at_least(int64_t element_count) override {
+        auto chunk_count = upper_div(element_count, size_per_chunk_);
+        chunks_.emplace_to_at_least(chunk_count, size_per_chunk_);
+    }
+
+    Span<std::string_view>
+    get_span(int64_t chunk_id) const {
+        auto& chunk = get_chunk(chunk_id);
+        return Span<std::string_view>(chunk.views.data(), chunk.views.size());
+    }
+
+    SpanBase
+    get_span_base(int64_t chunk_id) const override {
+        return get_span(chunk_id);
+    }
+
+    void
+    fill_chunk_data(const void* source, ssize_t element_count) override {
+        fill_chunk_data(static_cast<const std::string*>(source), element_count);
+    }
+
+    // source is a random access iterator of anything convertible to std::string_view
+    template <typename Iterator>
+    void
+    fill_chunk_data(Iterator source, ssize_t element_count) {
+        if (element_count == 0) {
+            return;
+        }
+        AssertInfo(chunks_.size() == 0, "no empty concurrent vector");
+        // a single chunk, so all the bytes of a sealed column are in one contiguous block
+        chunks_.emplace_to_at_least(1, element_count);
+        fill_chunk(0, 0, element_count, source);
+    }
+
+    void
+    set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) override {
+        set_data(element_offset, static_cast<const std::string*>(source), element_count);
+    }
+
+    template <typename Iterator>
+    void
+    set_data(ssize_t element_offset, Iterator source, ssize_t element_count) {
+        if (element_count == 0) {
+            return;
+        }
+        this->grow_to_at_least(element_offset + element_count);
+        auto chunk_id = element_offset / size_per_chunk_;
+        auto chunk_offset = element_offset % size_per_chunk_;
+        while (element_count > 0) {
+            auto size = std::min<ssize_t>(element_count, size_per_chunk_ - chunk_offset);
+            fill_chunk(chunk_id, chunk_offset, size, source);
+            source += size;
+            element_count -= size;
+            chunk_offset = 0;
+            ++chunk_id;
+        }
+    }
+
+    const Chunk&
+    get_chunk(ssize_t chunk_index) const {
+        return chunks_[chunk_index];
+    }
+
+    const void*
+    get_chunk_data(ssize_t chunk_index) const override {
+        return chunks_[chunk_index].views.data();
+    }
+
+    std::string_view
+    operator[](ssize_t element_index) const {
+        auto chunk_id = element_index / size_per_chunk_;
+        auto chunk_offset = element_index % size_per_chunk_;
+        return get_chunk(chunk_id).views[chunk_offset];
+    }
+
+    ssize_t
+    num_chunk() const override {
+        return chunks_.size();
+    }
+
+    bool
+    empty() override {
+        return chunks_.size() == 0;
+    }
+
+    void
+    clear() {
+        chunks_.clear();
+    }
+
+ private:
+    template <typename Iterator>
+    void
+    fill_chunk(ssize_t chunk_id, ssize_t chunk_offset, ssize_t element_count, Iterator source) {
+        Assert(chunk_id < chunks_.size());
+        auto& chunk = chunks_[chunk_id];
+        size_t byte_size = 0;
+        for (ssize_t i = 0; i < element_count; ++i) {
+            byte_size += std::string_view(source[i]).size();
+        }
+        // one arena allocation per batch, the strings of a batch are packed back to back
+        auto bytes = byte_size == 0 ? nullptr : chunk.arena.Allocate(byte_size);
+        auto views = chunk.views.data() + chunk_offset;
+        for (ssize_t i = 0; i < element_count; ++i) {
+            std::string_view str(source[i]);
+            if (!str.empty()) {
+                memcpy(bytes, str.data(), str.size());
+            }
+            views[i] = std::string_view(bytes, str.size());
+            bytes += str.size();
+        }
+    }
+
+ private:
+    ThreadSafeVector<Chunk> chunks_;
+};
+
 }  // namespace milvus::segcore
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/DeletedRecord.h"
+
+#include <algorithm>
+
+namespace milvus::segcore {
+
+namespace {
+using block_type = BitsetType::block_type;
+constexpr size_t bits_per_block = BitsetType::bits_per_block;
+
+// blocks[b] |= bits of deleted_at[64 * b, 64 * b + 64) <= timestamp, the compares vectorize into mask registers
+__attribute__((target_clones("avx512f", "avx2", "default"))) void
+mask_deleted_blocks(block_type* __restrict blocks,
+                    const Timestamp* __restrict deleted_at,
+                    size_t num_blocks,
+                    Timestamp timestamp) {
+    for (size_t b = 0; b < num_blocks; ++b) {
+        block_type block = 0;
+        for (size_t j = 0; j < bits_per_block; ++j) {
+            block |= block_type(deleted_at[b * bits_per_block + j] <= timestamp) << j;
+        }
+        blocks[b] |= block;
+    }
+}
+}  // namespace
+
+void
+DeletedRecord::set_deleted_at(const std::vector<std::pair<int64_t, Timestamp>>& rows) {
+    if (rows.empty()) {
+        return;
+    }
+    std::lock_guard lck(shared_mutex_);
+    for (auto [offset, timestamp] : rows) {
+        if (offset >= int64_t(deleted_at_.size())) {
+            deleted_at_.resize(std::max<size_t>(offset + 1, deleted_at_.size() * 2), MAX_TIMESTAMP);
+        }
+        if (deleted_at_[offset] == MAX_TIMESTAMP) {
+            ++num_deleted_rows_;
+        }
+        deleted_at_[offset] = std::min(deleted_at_[offset], timestamp);
+    }
+}
+
+void
+DeletedRecord::index_deletes(const std::vector<PkType>& pks, const Timestamp* timestamps) {
+    std::lock_guard lck(shared_mutex_);
+    for (size_t i = 0; i < pks.size(); ++i) {
+        auto& pk_timestamps = deletes_by_pk_[pks[i]];
+        pk_timestamps.insert(std::upper_bound(pk_timestamps.begin(), pk_timestamps.end(), timestamps[i]),
+                             timestamps[i]);
+    }
+}
+
+void
+DeletedRecord::mark_inserted_rows(const std::vector<PkType>& pks, const Timestamp* timestamps, int64_t first_offset) {
+    std::vector<std::pair<int64_t, Timestamp>> rows;
+    {
+        std::shared_lock lck(shared_mutex_);
+        if (deletes_by_pk_.empty()) {
+            return;
+        }
+        for (size_t i = 0; i < pks.size(); ++i) {
+            auto iter = deletes_by_pk_.find(pks[i]);
+            if (iter == deletes_by_pk_.end()) {
+                continue;
+            }
+            // the earliest delete not before the insert
+            auto& pk_timestamps = iter->second;
+            auto first = std::lower_bound(pk_timestamps.begin(), pk_timestamps.end(), timestamps[i]);
+            if (first != pk_timestamps.end()) {
+                rows.emplace_back(first_offset + i, *first);
+            }
+        }
+    }
+    set_deleted_at(rows);
+}
+
+void
+DeletedRecord::mask_deleted(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const {
+    std::shared_lock lck(shared_mutex_);
+    if (num_deleted_rows_ == 0) {
+        return;
+    }
+    // MAX_TIMESTAMP marks rows which are not deleted, no delete happens at it
+    timestamp = std::min(timestamp, MAX_TIMESTAMP - 1);
+    auto n = std::min({size_t(ins_barrier), bitset.size(), deleted_at_.size()});
+    auto num_blocks = n / bits_per_block;
+    mask_deleted_blocks(bitset.blocks(), deleted_at_.data(), num_blocks, timestamp);
+    for (auto i = num_blocks * bits_per_block; i < n; ++i) {
+        if (deleted_at_[i] <= timestamp) {
+            bitset.set(i);
+        }
+    }
+}
+
+}  // namespace milvus::segcore
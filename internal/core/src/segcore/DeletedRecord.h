@@ -12,82 +12,63 @@
 #pragma once
 
 #include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "AckResponder.h"
 #include "common/Schema.h"
+#include "common/Types.h"
 #include "segcore/Record.h"
 #include "ConcurrentVector.h"
 
 namespace milvus::segcore {
 
 struct DeletedRecord {
-    struct TmpBitmap {
-        // Just for query
-        int64_t del_barrier = 0;
-        BitsetTypePtr bitmap_ptr;
-
-        std::shared_ptr<TmpBitmap>
-        clone(int64_t capacity);
-    };
     static constexpr int64_t deprecated_size_per_chunk = 32 * 1024;
-    DeletedRecord()
-        : lru_(std::make_shared<TmpBitmap>()), timestamps_(deprecated_size_per_chunk), pks_(deprecated_size_per_chunk) {
-        lru_->bitmap_ptr = std::make_shared<BitsetType>();
-    }
-
-    auto
-    get_lru_entry() {
-        std::shared_lock lck(shared_mutex_);
-        return lru_;
+    DeletedRecord() : timestamps_(deprecated_size_per_chunk), pks_(deprecated_size_per_chunk) {
     }
 
-    std::shared_ptr<TmpBitmap>
-    clone_lru_entry(int64_t insert_barrier, int64_t del_barrier, int64_t& old_del_barrier, bool& hit_cache) {
-        std::shared_lock lck(shared_mutex_);
-        auto res = lru_->clone(insert_barrier);
-        old_del_barrier = lru_->del_barrier;
+    // mark row rows[i].first deleted at rows[i].second, a row keeps the earliest timestamp it is deleted at
+    void
+    set_deleted_at(const std::vector<std::pair<int64_t, Timestamp>>& rows);
 
-        if (lru_->bitmap_ptr->size() == insert_barrier && lru_->del_barrier == del_barrier) {
-            hit_cache = true;
-        } else {
-            res->del_barrier = del_barrier;
-        }
+    // set bitset[i] for the rows i < ins_barrier deleted at or before timestamp
+    void
+    mask_deleted(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const;
 
-        return res;
-    }
+    // index the deletes of pks[i] at timestamps[i] by pk, for mark_inserted_rows
+    void
+    index_deletes(const std::vector<PkType>& pks, const Timestamp* timestamps);
 
+    // mark the rows first_offset + i, of pks[i] inserted at timestamps[i], deleted by the indexed deletes
+    // of their pk. Growing segments call it on insert, so that rows arriving after a delete which applies
+    // to them (e.g. deletes loaded before the insert stream is replayed) are deleted as well
     void
-    insert_lru_entry(std::shared_ptr<TmpBitmap> new_entry, bool force = false) {
-        std::lock_guard lck(shared_mutex_);
-        if (new_entry->del_barrier <= lru_->del_barrier) {
-            if (!force || new_entry->bitmap_ptr->size() <= lru_->bitmap_ptr->size()) {
-                // DO NOTHING
-                return;
-            }
-        }
-        lru_ = std::move(new_entry);
+    mark_inserted_rows(const std::vector<PkType>& pks, const Timestamp* timestamps, int64_t first_offset);
+
+    int64_t
+    num_deleted_rows() const {
+        std::shared_lock lck(shared_mutex_);
+        return num_deleted_rows_;
     }
 
  public:
     std::atomic<int64_t> reserved = 0;
     AckResponder ack_responder_;
+    // the delete log, in the order deletes were applied
     ConcurrentVector<Timestamp> timestamps_;
     ConcurrentVector<PkType> pks_;
 
  private:
-    std::shared_ptr<TmpBitmap> lru_;
-    std::shared_mutex shared_mutex_;
+    // per row timestamp the row is deleted at, MAX_TIMESTAMP if it is not deleted, rows past the end are not
+    // deleted. Deletes are applied to it eagerly, so masking deleted rows is one compare per row for a query
+    std::vector<Timestamp> deleted_at_;
+    int64_t num_deleted_rows_ = 0;
+    // sorted delete timestamps of every deleted pk
+    std::unordered_map<PkType, std::vector<Timestamp>> deletes_by_pk_;
+    mutable std::shared_mutex shared_mutex_;
 };
 
-inline auto
-DeletedRecord::TmpBitmap::clone(int64_t capacity) -> std::shared_ptr<TmpBitmap> {
-    auto res = std::make_shared<TmpBitmap>();
-    res->del_barrier = this->del_barrier;
-    res->bitmap_ptr = std::make_shared<BitsetType>();
-    *(res->bitmap_ptr) = *(this->bitmap_ptr);
-    res->bitmap_ptr->resize(capacity, false);
-    return res;
-}
-
 }  // namespace milvus::segcore
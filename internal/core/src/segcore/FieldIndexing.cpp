@@ -87,7 +87,7 @@ ScalarFieldIndexing<T>::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const
         // TODO
         if constexpr (std::is_same_v<T, std::string>) {
             auto indexing = index::CreateStringIndexSort();
-            indexing->Build(vec_base->get_size_per_chunk(), chunk.data());
+            indexing->Build(vec_base->get_size_per_chunk(), chunk.views.data());
             data_[chunk_id] = std::move(indexing);
         } else {
             auto indexing = index::CreateScalarIndexSort<T>();
@@ -11,9 +11,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <exception>
 #include <optional>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include <tbb/concurrent_vector.h>
 #include <index/Index.h>
@@ -22,7 +25,9 @@
 #include "AckResponder.h"
 #include "InsertRecord.h"
 #include "common/Schema.h"
+#include "log/Log.h"
 #include "segcore/SegcoreConfig.h"
+#include "segcore/SmallIndexExecutor.h"
 #include "index/VectorIndex.h"
 
 namespace milvus::segcore {
@@ -53,6 +58,7 @@ class FieldIndexing {
         return segcore_config_.get_chunk_rows();
     }
 
+    // nullptr if the build of the chunk failed
     virtual index::IndexBase*
     get_chunk_indexing(int64_t chunk_id) const = 0;
 
@@ -74,7 +80,7 @@ class ScalarFieldIndexing : public FieldIndexing {
     index::ScalarIndex<T>*
     get_chunk_indexing(int64_t chunk_id) const override {
         Assert(!field_meta_.is_vector());
-        return data_.at(chunk_id).get();
+        return chunk_id < data_.size() ? data_[chunk_id].get() : nullptr;
     }
 
  private:
@@ -92,7 +98,7 @@ class VectorFieldIndexing : public FieldIndexing {
     index::IndexBase*
     get_chunk_indexing(int64_t chunk_id) const override {
         Assert(field_meta_.is_vector());
-        return data_.at(chunk_id).get();
+        return chunk_id < data_.size() ? data_[chunk_id].get() : nullptr;
     }
 
     knowhere::Config
@@ -115,12 +121,20 @@ class IndexingRecord {
         Initialize();
     }
 
+    ~IndexingRecord() {
+        WaitForBuilds();
+    }
+
     void
     Initialize() {
         int offset_id = 0;
         for (auto& [field_id, field_meta] : schema_.get_fields()) {
             ++offset_id;
 
+            if (field_meta.is_vector() ? !segcore_config_.get_vector_small_index_enabled()
+                                       : !segcore_config_.get_scalar_small_index_enabled()) {
+                continue;
+            }
             if (field_meta.is_vector()) {
                 // TODO: skip binary small index now, reenable after config.yaml is ready
                 if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
@@ -137,7 +151,11 @@ class IndexingRecord {
         assert(offset_id == schema_.size());
     }
 
-    // concurrent, reentrant
+    // concurrent, reentrant. Builds the indexes of the chunks [resource_ack_, chunk_ack) on the SmallIndexExecutor
+    // if small indexes are async, blocking only while the executor's queue is full. Searches keep using raw data
+    // for the chunks past get_finished_ack(), so a build in flight is invisible to them, and for the chunks below
+    // it whose build failed, which have no index.
+    // The record must outlive the build, see WaitForBuilds
     template <bool is_sealed>
     void
     UpdateResourceAck(int64_t chunk_ack, const InsertRecord<is_sealed>& record) {
@@ -153,13 +171,34 @@ class IndexingRecord {
         resource_ack_ = chunk_ack;
         lck.unlock();
 
-        //    std::thread([this, old_ack, chunk_ack, &record] {
-        for (auto& [field_offset, entry] : field_indexings_) {
-            auto vec_base = record.get_field_data_base(field_offset);
-            entry->BuildIndexRange(old_ack, chunk_ack, vec_base);
+        if (!segcore_config_.get_small_index_async()) {
+            BuildIndexRange(old_ack, chunk_ack, record);
+            return;
+        }
+        {
+            std::lock_guard build_lck(build_mutex_);
+            ++builds_in_flight_;
         }
-        finished_ack_.AddSegment(old_ack, chunk_ack);
-        //    }).detach();
+        SmallIndexExecutor::GetInstance().Submit([this, old_ack, chunk_ack, &record] {
+            try {
+                BuildIndexRange(old_ack, chunk_ack, record);
+            } catch (std::exception& e) {
+                // the chunks left without index are searched on raw data
+                LOG_SEGCORE_ERROR_ << "failed to build small index of chunks [" << old_ack << ", " << chunk_ack
+                                   << "): " << e.what();
+            }
+            std::lock_guard build_lck(build_mutex_);
+            if (--builds_in_flight_ == 0) {
+                builds_done_.notify_all();
+            }
+        });
+    }
+
+    // wait for the builds submitted by UpdateResourceAck
+    void
+    WaitForBuilds() const {
+        std::unique_lock build_lck(build_mutex_);
+        builds_done_.wait(build_lck, [this] { return builds_in_flight_ == 0; });
     }
 
     // concurrent
@@ -168,6 +207,25 @@ class IndexingRecord {
         return finished_ack_.GetAck();
     }
 
+ private:
+    template <bool is_sealed>
+    void
+    BuildIndexRange(int64_t ack_beg, int64_t ack_end, const InsertRecord<is_sealed>& record) {
+        // the ack moves past the chunks even if a build fails, or the indexes of all the later chunks
+        // would stay invisible too
+        try {
+            for (auto& [field_offset, entry] : field_indexings_) {
+                auto vec_base = record.get_field_data_base(field_offset);
+                entry->BuildIndexRange(ack_beg, ack_end, vec_base);
+            }
+        } catch (...) {
+            finished_ack_.AddSegment(ack_beg, ack_end);
+            throw;
+        }
+        finished_ack_.AddSegment(ack_beg, ack_end);
+    }
+
+ public:
     const FieldIndexing&
     get_field_indexing(FieldId field_id) const {
         Assert(field_indexings_.count(field_id));
@@ -203,10 +261,13 @@ class IndexingRecord {
  private:
     // control info
     std::atomic<int64_t> resource_ack_ = 0;
-    //    std::atomic<int64_t> finished_ack_ = 0;
     AckResponder finished_ack_;
     std::mutex mutex_;
 
+    mutable std::mutex build_mutex_;
+    mutable std::condition_variable builds_done_;
+    int64_t builds_in_flight_ = 0;
+
  private:
     // field_offset => indexing
     std::map<FieldId, std::unique_ptr<FieldIndexing>> field_indexings_;
@@ -11,13 +11,22 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <memory>
+#include <numeric>
+#include <shared_mutex>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <algorithm>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
+#include <tbb/parallel_sort.h>
+
 #include "common/Schema.h"
 #include "segcore/AckResponder.h"
 #include "segcore/ConcurrentVector.h"
@@ -36,6 +45,24 @@ class OffsetMap {
     virtual void
     insert(const PkType pk, int64_t offset) = 0;
 
+    // map pks[i] to first_offset + i for i in [0, n), the pks of one insert batch
+    virtual void
+    insert(const PkType* pks, int64_t n, int64_t first_offset) {
+        for (int64_t i = 0; i < n; ++i) {
+            insert(pks[i], first_offset + i);
+        }
+    }
+
+    // appends (i, offset) to hits for every offset of pks[i], i in [0, n)
+    virtual void
+    find(const PkType* pks, int64_t n, std::vector<std::pair<int64_t, int64_t>>& hits) const {
+        for (int64_t i = 0; i < n; ++i) {
+            for (auto offset : find(pks[i])) {
+                hits.emplace_back(i, offset);
+            }
+        }
+    }
+
     virtual void
     seal() = 0;
 
@@ -43,18 +70,60 @@ class OffsetMap {
     empty() const = 0;
 };
 
+// pk to offsets map of growing segments, safe for concurrent inserts and finds. Keys are spread over
+// shards with a lock each, and a shard is an open addressing table keeping the first offset of a key
+// inline, further offsets of a duplicated pk are chained in a side array
 template <typename T>
 class OffsetHashMap : public OffsetMap {
  public:
     std::vector<int64_t>
     find(const PkType pk) const {
-        auto offset_vector = map_.find(std::get<T>(pk));
-        return offset_vector != map_.end() ? offset_vector->second : std::vector<int64_t>();
+        auto& key = std::get<T>(pk);
+        auto hash = hash_of(key);
+        auto& shard = shards_[shard_of(hash)];
+        std::shared_lock lck(shard.mutex);
+        return shard.find(key, hash);
     }
 
     void
     insert(const PkType pk, int64_t offset) {
-        map_[std::get<T>(pk)].emplace_back(offset);
+        auto& key = std::get<T>(pk);
+        auto hash = hash_of(key);
+        auto& shard = shards_[shard_of(hash)];
+        std::lock_guard lck(shard.mutex);
+        shard.insert(key, hash, offset);
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // groups the batch by shard, so each shard is locked once per batch
+    void
+    insert(const PkType* pks, int64_t n, int64_t first_offset) {
+        std::vector<size_t> hashes(n);
+        std::vector<int64_t> shard_begin(NUM_SHARDS + 1, 0);
+        for (int64_t i = 0; i < n; ++i) {
+            hashes[i] = hash_of(std::get<T>(pks[i]));
+            ++shard_begin[shard_of(hashes[i]) + 1];
+        }
+        for (size_t i = 0; i < NUM_SHARDS; ++i) {
+            shard_begin[i + 1] += shard_begin[i];
+        }
+        std::vector<int64_t> rows(n);
+        auto next = shard_begin;
+        for (int64_t i = 0; i < n; ++i) {
+            rows[next[shard_of(hashes[i])]++] = i;
+        }
+        for (size_t s = 0; s < NUM_SHARDS; ++s) {
+            if (shard_begin[s] == shard_begin[s + 1]) {
+                continue;
+            }
+            auto& shard = shards_[s];
+            std::lock_guard lck(shard.mutex);
+            for (auto j = shard_begin[s]; j < shard_begin[s + 1]; ++j) {
+                auto row = rows[j];
+                shard.insert(std::get<T>(pks[row]), hashes[row], first_offset + row);
+            }
+        }
+        size_.fetch_add(n, std::memory_order_relaxed);
     }
 
     void
@@ -64,62 +133,321 @@ class OffsetHashMap : public OffsetMap {
 
     bool
     empty() const {
-        return map_.empty();
+        return size_.load(std::memory_order_relaxed) == 0;
+    }
+
+    // longest distance of a key from its home slot over all shards, a lookup probes at most one more slot
+    int64_t
+    max_probe_length() const {
+        int64_t res = 0;
+        for (auto& shard : shards_) {
+            std::shared_lock lck(shard.mutex);
+            res = std::max(res, shard.max_probe_length());
+        }
+        return res;
     }
 
  private:
-    std::unordered_map<T, std::vector<int64_t>> map_;
+    static constexpr size_t SHARD_BITS = 6;
+    static constexpr size_t NUM_SHARDS = size_t(1) << SHARD_BITS;
+
+    // std::hash of integers is the identity, mix all its bits into both the shard bits (the top ones) and the
+    // slot bits (the low ones) with the murmur3 finalizer. A multiply alone leaves the low bits depending on the
+    // low bits of the key only, so strided pks such as i << 20 would all probe from the same slot
+    static size_t
+    hash_of(const T& key) {
+        uint64_t hash = std::hash<T>{}(key);
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    static size_t
+    shard_of(size_t hash) {
+        return hash >> (64 - SHARD_BITS);
+    }
+
+    struct Slot {
+        T key;
+        int64_t offset = -1;  // -1 if the slot is empty
+        int32_t duplicates = -1;
+    };
+
+    // an offset of a duplicated pk, chained to the previous one
+    struct Duplicate {
+        int64_t offset;
+        int32_t next;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::vector<Slot> slots;
+        std::vector<Duplicate> duplicates;
+        size_t num_keys = 0;
+
+        std::vector<int64_t>
+        find(const T& key, size_t hash) const {
+            std::vector<int64_t> offsets;
+            if (slots.empty()) {
+                return offsets;
+            }
+            auto mask = slots.size() - 1;
+            for (auto i = hash & mask; slots[i].offset >= 0; i = (i + 1) & mask) {
+                if (slots[i].key == key) {
+                    offsets.push_back(slots[i].offset);
+                    // duplicates are chained newest first, report them in insert order
+                    auto first = offsets.size();
+                    for (auto d = slots[i].duplicates; d >= 0; d = duplicates[d].next) {
+                        offsets.push_back(duplicates[d].offset);
+                    }
+                    std::reverse(offsets.begin() + first, offsets.end());
+                    break;
+                }
+            }
+            return offsets;
+        }
+
+        void
+        insert(const T& key, size_t hash, int64_t offset) {
+            // keep the load factor under 0.7, probes stay short
+            if ((num_keys + 1) * 10 > slots.size() * 7) {
+                grow();
+            }
+            auto mask = slots.size() - 1;
+            auto i = hash & mask;
+            for (; slots[i].offset >= 0; i = (i + 1) & mask) {
+                if (slots[i].key == key) {
+                    duplicates.push_back({offset, slots[i].duplicates});
+                    slots[i].duplicates = duplicates.size() - 1;
+                    return;
+                }
+            }
+            slots[i].key = key;
+            slots[i].offset = offset;
+            ++num_keys;
+        }
+
+        int64_t
+        max_probe_length() const {
+            int64_t res = 0;
+            auto mask = slots.size() - 1;
+            for (size_t i = 0; i < slots.size(); ++i) {
+                if (slots[i].offset >= 0) {
+                    res = std::max<int64_t>(res, (i - hash_of(slots[i].key)) & mask);
+                }
+            }
+            return res;
+        }
+
+        void
+        grow() {
+            std::vector<Slot> old(std::max<size_t>(slots.size() * 2, 16));
+            old.swap(slots);
+            auto mask = slots.size() - 1;
+            for (auto& slot : old) {
+                if (slot.offset < 0) {
+                    continue;
+                }
+                auto i = hash_of(slot.key) & mask;
+                while (slots[i].offset >= 0) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = std::move(slot);
+            }
+        }
+    };
+
+    std::array<Shard, NUM_SHARDS> shards_;
+    std::atomic<int64_t> size_ = 0;
 };
 
+// static pk to offsets index of sealed segments, pks are only inserted before seal. Distinct pks are laid
+// out in Eytzinger (BFS) order, so a lookup walks down a complete binary tree whose top levels share a few
+// cache lines and the next levels can be prefetched. String pks live in one arena and are compared by an
+// 8-byte prefix first, so most steps of a lookup do not touch the arena at all
 template <typename T>
-class OffsetOrderedArray : public OffsetMap {
+class OffsetEytzingerArray : public OffsetMap {
  public:
     std::vector<int64_t>
     find(const PkType pk) const {
-        int left = 0, right = array_.size() - 1;
-        T target = std::get<T>(pk);
-        if (!is_sealed)
-            PanicInfo("OffsetOrderedArray could not search before seal");
-
-        while (left < right) {
-            int mid = (left + right) >> 1;
-            if (array_[mid].first < target)
-                left = mid + 1;
-            else
-                right = mid;
+        AssertInfo(is_sealed_, "OffsetEytzingerArray could not search before seal");
+        auto k = lower_bound(std::get<T>(pk));
+        if (k == 0) {
+            return {};
         }
+        auto [begin, end] = ranges_[k];
+        return std::vector<int64_t>(offsets_.begin() + begin, offsets_.begin() + end);
+    }
 
-        std::vector<int64_t> offset_vector;
-        for (int offset_id = right; offset_id < array_.size(); offset_id++) {
-            if (offset_id < 0 || array_[offset_id].first != target)
-                break;
-            offset_vector.push_back(array_[offset_id].second);
+    void
+    find(const PkType* pks, int64_t n, std::vector<std::pair<int64_t, int64_t>>& hits) const {
+        AssertInfo(is_sealed_, "OffsetEytzingerArray could not search before seal");
+        for (int64_t i = 0; i < n; ++i) {
+            auto k = lower_bound(std::get<T>(pks[i]));
+            if (k == 0) {
+                continue;
+            }
+            for (auto j = ranges_[k].first; j < ranges_[k].second; ++j) {
+                hits.emplace_back(i, offsets_[j]);
+            }
         }
-
-        return offset_vector;
     }
 
     void
     insert(const PkType pk, int64_t offset) {
-        if (is_sealed)
-            PanicInfo("OffsetOrderedArray could not insert after seal");
-        array_.push_back(std::make_pair(std::get<T>(pk), offset));
+        AssertInfo(!is_sealed_, "OffsetEytzingerArray could not insert after seal");
+        pending_pks_.push_back(std::get<T>(pk));
+        pending_offsets_.push_back(offset);
     }
 
     void
     seal() {
-        sort(array_.begin(), array_.end());
-        is_sealed = true;
+        auto n = pending_pks_.size();
+        std::vector<int64_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        tbb::parallel_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+            if (pending_pks_[a] != pending_pks_[b]) {
+                return pending_pks_[a] < pending_pks_[b];
+            }
+            return pending_offsets_[a] < pending_offsets_[b];
+        });
+
+        // distinct pks in sorted order, the offsets of the i-th one are offsets_[sorted_starts[i], sorted_starts[i + 1])
+        std::vector<int64_t> distinct;
+        std::vector<int64_t> sorted_starts;
+        offsets_.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (i == 0 || pending_pks_[order[i]] != pending_pks_[order[i - 1]]) {
+                distinct.push_back(order[i]);
+                sorted_starts.push_back(i);
+            }
+            offsets_[i] = pending_offsets_[order[i]];
+        }
+        sorted_starts.push_back(n);
+
+        num_keys_ = distinct.size();
+        keys_.resize(num_keys_ + 1);
+        ranges_.resize(num_keys_ + 1);
+        if constexpr (std::is_same_v<T, std::string>) {
+            size_t arena_size = 0;
+            for (auto row : distinct) {
+                arena_size += pending_pks_[row].size();
+            }
+            arena_.reserve(arena_size);
+        }
+        size_t rank = 0;
+        layout(1, rank, distinct, sorted_starts);
+
+        pending_pks_ = {};
+        pending_offsets_ = {};
+        is_sealed_ = true;
     }
 
     bool
     empty() const {
-        return array_.empty();
+        return is_sealed_ ? offsets_.empty() : pending_pks_.empty();
     }
 
  private:
-    bool is_sealed = false;
-    std::vector<std::pair<T, int64_t>> array_;
+    struct StringKey {
+        // first 8 bytes of the string, zero padded, in big endian so that integer order is string order
+        uint64_t prefix;
+        uint64_t pos;
+        uint64_t size;
+    };
+    using Key = std::conditional_t<std::is_same_v<T, std::string>, StringKey, T>;
+    using Probe = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+    // keys per cache line, the subtree this many levels down is prefetched while comparing
+    static constexpr size_t PREFETCH_STRIDE = 64 / sizeof(Key);
+
+    static uint64_t
+    prefix_of(std::string_view str) {
+        uint64_t prefix = 0;
+        memcpy(&prefix, str.data(), std::min(str.size(), sizeof(prefix)));
+        return __builtin_bswap64(prefix);
+    }
+
+    std::string_view
+    string_of(const StringKey& key) const {
+        return std::string_view(arena_.data() + key.pos, key.size);
+    }
+
+    // in-order walk of the tree rooted at node k, assigning distinct pks in sorted order
+    void
+    layout(size_t k, size_t& rank, const std::vector<int64_t>& distinct, const std::vector<int64_t>& sorted_starts) {
+        if (k > num_keys_) {
+            return;
+        }
+        layout(2 * k, rank, distinct, sorted_starts);
+        auto& pk = pending_pks_[distinct[rank]];
+        if constexpr (std::is_same_v<T, std::string>) {
+            keys_[k] = StringKey{prefix_of(pk), arena_.size(), pk.size()};
+            arena_.insert(arena_.end(), pk.begin(), pk.end());
+        } else {
+            keys_[k] = pk;
+        }
+        ranges_[k] = {sorted_starts[rank], sorted_starts[rank + 1]};
+        ++rank;
+        layout(2 * k + 1, rank, distinct, sorted_starts);
+    }
+
+    // node of the tree holding value, 0 if it is absent
+    size_t
+    lower_bound(const T& value) const {
+        Probe probe = value;
+        uint64_t probe_prefix = 0;
+        if constexpr (std::is_same_v<T, std::string>) {
+            probe_prefix = prefix_of(probe);
+        }
+        size_t k = 1;
+        while (k <= num_keys_) {
+            __builtin_prefetch(keys_.data() + std::min(k * PREFETCH_STRIDE, num_keys_));
+            k = 2 * k + less(keys_[k], probe, probe_prefix);
+        }
+        // strip the trailing right turns and the final left turn, what is left is the last node not less than probe
+        k >>= __builtin_ffsll(~k);
+        if (k == 0 || !equal(keys_[k], probe, probe_prefix)) {
+            return 0;
+        }
+        return k;
+    }
+
+    bool
+    less(const Key& key, const Probe& probe, uint64_t probe_prefix) const {
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (key.prefix != probe_prefix) {
+                return key.prefix < probe_prefix;
+            }
+            return string_of(key) < probe;
+        } else {
+            return key < probe;
+        }
+    }
+
+    bool
+    equal(const Key& key, const Probe& probe, uint64_t probe_prefix) const {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return key.prefix == probe_prefix && string_of(key) == probe;
+        } else {
+            return key == probe;
+        }
+    }
+
+    bool is_sealed_ = false;
+    std::vector<T> pending_pks_;
+    std::vector<int64_t> pending_offsets_;
+
+    size_t num_keys_ = 0;
+    // tree nodes, 1-based with keys_[0] unused. The offsets of the pk at node k are
+    // offsets_[ranges_[k].first, ranges_[k].second), in insert order
+    std::vector<Key> keys_;
+    std::vector<std::pair<int64_t, int64_t>> ranges_;
+    std::vector<int64_t> offsets_;
+    std::vector<char> arena_;
 };
 
 template <bool is_sealed = false>
@@ -147,14 +475,14 @@ struct InsertRecord {
                 switch (field_meta.get_data_type()) {
                     case DataType::INT64: {
                         if (is_sealed)
-                            pk2offset_ = std::make_unique<OffsetOrderedArray<int64_t>>();
+                            pk2offset_ = std::make_unique<OffsetEytzingerArray<int64_t>>();
                         else
                             pk2offset_ = std::make_unique<OffsetHashMap<int64_t>>();
                         break;
                     }
                     case DataType::VARCHAR: {
                         if (is_sealed)
-                            pk2offset_ = std::make_unique<OffsetOrderedArray<std::string>>();
+                            pk2offset_ = std::make_unique<OffsetEytzingerArray<std::string>>();
                         else
                             pk2offset_ = std::make_unique<OffsetHashMap<std::string>>();
                         break;
@@ -215,9 +543,11 @@ struct InsertRecord {
         }
     }
 
+    // OffsetHashMap is safe for concurrent inserts and searches. OffsetEytzingerArray is filled and sealed
+    // while the sealed segment holds its unique lock, and only searched through Search and Retrieve, which
+    // hold the shared one, search_ids itself takes no lock
     std::vector<SegOffset>
     search_pk(const PkType pk, Timestamp timestamp) const {
-        std::shared_lock lck(shared_mutex_);
         std::vector<SegOffset> res_offsets;
         auto offset_iter = pk2offset_->find(pk);
         for (auto offset : offset_iter) {
@@ -230,7 +560,6 @@ struct InsertRecord {
 
     std::vector<SegOffset>
     search_pk(const PkType pk, int64_t insert_barrier) const {
-        std::shared_lock lck(shared_mutex_);
         std::vector<SegOffset> res_offsets;
         auto offset_iter = pk2offset_->find(pk);
         for (auto offset : offset_iter) {
@@ -241,15 +570,48 @@ struct InsertRecord {
         return res_offsets;
     }
 
+    // (index in pks, offset) of every row of pks inserted no later than timestamp, without allocating per pk
+    std::vector<std::pair<int64_t, SegOffset>>
+    search_pks(const std::vector<PkType>& pks, Timestamp timestamp) const {
+        std::vector<std::pair<int64_t, int64_t>> hits;
+        pk2offset_->find(pks.data(), pks.size(), hits);
+        std::vector<std::pair<int64_t, SegOffset>> res;
+        res.reserve(hits.size());
+        for (auto [i, offset] : hits) {
+            if (timestamps_[offset] <= timestamp) {
+                res.emplace_back(i, SegOffset(offset));
+            }
+        }
+        return res;
+    }
+
+    std::vector<std::pair<int64_t, SegOffset>>
+    search_pks(const std::vector<PkType>& pks, int64_t insert_barrier) const {
+        std::vector<std::pair<int64_t, int64_t>> hits;
+        pk2offset_->find(pks.data(), pks.size(), hits);
+        std::vector<std::pair<int64_t, SegOffset>> res;
+        res.reserve(hits.size());
+        for (auto [i, offset] : hits) {
+            if (offset <= insert_barrier) {
+                res.emplace_back(i, SegOffset(offset));
+            }
+        }
+        return res;
+    }
+
     void
     insert_pk(const PkType pk, int64_t offset) {
-        std::lock_guard lck(shared_mutex_);
         pk2offset_->insert(pk, offset);
     }
 
+    // map pks[i] to first_offset + i
+    void
+    insert_pks(const std::vector<PkType>& pks, int64_t first_offset) {
+        pk2offset_->insert(pks.data(), pks.size(), first_offset);
+    }
+
     bool
     empty_pks() const {
-        std::shared_lock lck(shared_mutex_);
         return pk2offset_->empty();
     }
 
@@ -303,6 +665,12 @@ struct InsertRecord {
         fields_data_.emplace(field_id, std::make_unique<ConcurrentVector<VectorType>>(dim, size_per_chunk));
     }
 
+    // replace the column of a field, e.g. by a column read from somewhere else than the heap
+    void
+    set_field_data(FieldId field_id, std::unique_ptr<VectorBase> field_data) {
+        fields_data_[field_id] = std::move(field_data);
+    }
+
     void
     drop_field_data(FieldId field_id) {
         fields_data_.erase(field_id);
@@ -311,7 +679,6 @@ struct InsertRecord {
  private:
     //    std::vector<std::unique_ptr<VectorBase>> fields_data_;
     std::unordered_map<FieldId, std::unique_ptr<VectorBase>> fields_data_;
-    mutable std::shared_mutex shared_mutex_;
 };
 
 }  // namespace milvus::segcore
@@ -0,0 +1,223 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/MmapVector.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <iterator>
+#include <vector>
+
+namespace milvus::segcore {
+
+namespace {
+// strings and narrowed integers are staged in a buffer of this size before they are written
+constexpr size_t kWriteBufferSize = 1 << 20;
+
+std::string
+ErrorString() {
+    return std::strerror(errno);
+}
+
+// create dir and its parents, like mkdir -p
+void
+CreateDirs(const std::string& dir) {
+    for (size_t pos = dir.find('/', 1);; pos = dir.find('/', pos + 1)) {
+        auto parent = dir.substr(0, pos);
+        AssertInfo(mkdir(parent.c_str(), 0755) == 0 || errno == EEXIST,
+                   "failed to create mmap dir " + parent + ": " + ErrorString());
+        if (pos == std::string::npos) {
+            return;
+        }
+    }
+}
+
+class FileWriter {
+ public:
+    explicit FileWriter(int fd) : fd_(fd) {
+        buffer_.reserve(kWriteBufferSize);
+    }
+
+    // write size bytes through the buffer
+    void
+    Append(const void* data, size_t size) {
+        if (buffer_.size() + size > kWriteBufferSize) {
+            Flush();
+        }
+        if (size >= kWriteBufferSize) {
+            Write(data, size);
+            return;
+        }
+        auto bytes = static_cast<const char*>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    // write size bytes as they are, the buffer must have been flushed
+    void
+    Write(const void* data, size_t size) {
+        auto bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            auto written = write(fd_, bytes, size);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            AssertInfo(written > 0, "failed to write mmap file: " + ErrorString());
+            bytes += written;
+            size -= written;
+            size_ += written;
+        }
+    }
+
+    void
+    Flush() {
+        Write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+    size_t
+    size() const {
+        return size_ + buffer_.size();
+    }
+
+ private:
+    int fd_;
+    size_t size_ = 0;
+    std::vector<char> buffer_;
+};
+
+// INT8 and INT16 arrive widened to int32
+template <typename T>
+void
+AppendNarrowed(FileWriter& writer, const int32_t* source, int64_t element_count) {
+    T values[4096];
+    for (int64_t begin = 0; begin < element_count; begin += std::size(values)) {
+        auto count = std::min<int64_t>(element_count - begin, std::size(values));
+        std::copy_n(source + begin, count, values);
+        writer.Append(values, count * sizeof(T));
+    }
+}
+
+// closes the file and unlinks it once it is mapped, or on errors
+struct FileGuard {
+    int fd;
+    std::string path;
+
+    ~FileGuard() {
+        if (fd >= 0) {
+            close(fd);
+            unlink(path.c_str());
+        }
+    }
+};
+}  // namespace
+
+MmapVector::MmapVector(const std::string& dir,
+                       const std::string& name,
+                       const FieldMeta& field_meta,
+                       int64_t size_per_chunk,
+                       int64_t element_count,
+                       const DataArray* data,
+                       Access access)
+    : VectorBase(size_per_chunk),
+      element_count_(element_count),
+      element_sizeof_(field_meta.is_string() ? sizeof(std::string_view) : field_meta.get_sizeof()) {
+    CreateDirs(dir);
+    auto path = dir + "/" + name + "_XXXXXX";
+    FileGuard file{mkstemp(path.data()), path};
+    AssertInfo(file.fd >= 0, "failed to create mmap file " + path + ": " + ErrorString());
+
+    // the column is written straight from the message, without a copy on the heap
+    FileWriter writer(file.fd);
+    std::vector<int64_t> string_offsets;
+    switch (field_meta.get_data_type()) {
+        case DataType::BOOL: {
+            writer.Write(data->scalars().bool_data().data().data(), element_count * sizeof(bool));
+            break;
+        }
+        case DataType::INT8: {
+            AppendNarrowed<int8_t>(writer, data->scalars().int_data().data().data(), element_count);
+            break;
+        }
+        case DataType::INT16: {
+            AppendNarrowed<int16_t>(writer, data->scalars().int_data().data().data(), element_count);
+            break;
+        }
+        case DataType::INT32: {
+            writer.Write(data->scalars().int_data().data().data(), element_count * sizeof(int32_t));
+            break;
+        }
+        case DataType::INT64: {
+            writer.Write(data->scalars().long_data().data().data(), element_count * sizeof(int64_t));
+            break;
+        }
+        case DataType::FLOAT: {
+            writer.Write(data->scalars().float_data().data().data(), element_count * sizeof(float));
+            break;
+        }
+        case DataType::DOUBLE: {
+            writer.Write(data->scalars().double_data().data().data(), element_count * sizeof(double));
+            break;
+        }
+        case DataType::VARCHAR: {
+            auto& strings = data->scalars().string_data().data();
+            string_offsets.resize(element_count + 1);
+            for (int64_t i = 0; i < element_count; ++i) {
+                string_offsets[i] = writer.size();
+                writer.Append(strings[i].data(), strings[i].size());
+            }
+            string_offsets[element_count] = writer.size();
+            break;
+        }
+        case DataType::VECTOR_FLOAT: {
+            writer.Write(data->vectors().float_vector().data().data(), element_count * element_sizeof_);
+            break;
+        }
+        case DataType::VECTOR_BINARY: {
+            writer.Write(data->vectors().binary_vector().data(), element_count * element_sizeof_);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported data type for mmap: " + datatype_name(field_meta.get_data_type()));
+        }
+    }
+    writer.Flush();
+
+    auto size = writer.size();
+    if (size > 0) {
+        auto map = mmap(nullptr, size, PROT_READ, MAP_SHARED, file.fd, 0);
+        AssertInfo(map != MAP_FAILED, "failed to mmap " + path + ": " + ErrorString());
+        mapping_.data = static_cast<char*>(map);
+        mapping_.size = size;
+        // sequential reads ahead aggressively for scans, random reads only the touched pages for gathers
+        madvise(map, size, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    }
+
+    if (field_meta.is_string()) {
+        views_.resize(element_count);
+        for (int64_t i = 0; i < element_count; ++i) {
+            views_[i] =
+                std::string_view(mapping_.data + string_offsets[i], string_offsets[i + 1] - string_offsets[i]);
+        }
+    }
+}
+
+MmapVector::Mapping::~Mapping() {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "common/FieldMeta.h"
+#include "common/Span.h"
+#include "common/Types.h"
+#include "exceptions/EasyAssert.h"
+#include "segcore/ConcurrentVector.h"
+
+namespace milvus::segcore {
+
+// Read only column of a sealed segment in a single chunk, written once to a local file and read from an mmap of it.
+// Its pages are in the page cache instead of on the heap, so the kernel can drop the cold ones under memory
+// pressure. The file is unlinked once mapped, so it goes away with the mapping.
+// For VARCHAR, the strings are stored back to back in the file, and only their views are kept on the heap.
+// The access pattern of the column is passed to madvise once, when it is mapped
+class MmapVector : public VectorBase {
+ public:
+    // how the column is read, scanned by filters and brute force search or gathered for outputs
+    enum class Access {
+        Sequential,
+        Random,
+    };
+
+    // write the element_count rows of data to a new file under dir, named after name, and map it
+    MmapVector(const std::string& dir,
+               const std::string& name,
+               const FieldMeta& field_meta,
+               int64_t size_per_chunk,
+               int64_t element_count,
+               const DataArray* data,
+               Access access);
+
+    int64_t
+    file_size() const {
+        return mapping_.size;
+    }
+
+    void
+    grow_to_at_least(int64_t element_count) override {
+        PanicInfo("mmap column is read only");
+    }
+
+    void
+    set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) override {
+        PanicInfo("mmap column is read only");
+    }
+
+    void
+    fill_chunk_data(const void* source, ssize_t element_count) override {
+        PanicInfo("mmap column is written once, when it is created");
+    }
+
+    SpanBase
+    get_span_base(int64_t chunk_id) const override {
+        AssertInfo(chunk_id == 0, "mmap column has only one chunk");
+        return SpanBase(get_chunk_data(0), element_count_, element_sizeof_);
+    }
+
+    const void*
+    get_chunk_data(ssize_t chunk_index) const override {
+        return views_.empty() ? static_cast<const void*>(mapping_.data) : views_.data();
+    }
+
+    ssize_t
+    num_chunk() const override {
+        return 1;
+    }
+
+    bool
+    empty() override {
+        return false;
+    }
+
+ private:
+    // unmapped on destruction, also when the constructor of the column throws after mapping
+    struct Mapping {
+        char* data = nullptr;
+        size_t size = 0;
+
+        Mapping() = default;
+        Mapping(const Mapping&) = delete;
+        Mapping&
+        operator=(const Mapping&) = delete;
+        ~Mapping();
+    };
+
+    int64_t element_count_;
+    int64_t element_sizeof_;
+    Mapping mapping_;
+    FixedVector<std::string_view> views_;
+};
+
+}  // namespace milvus::segcore
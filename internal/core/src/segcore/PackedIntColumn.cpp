@@ -0,0 +1,198 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/PackedIntColumn.h"
+
+#include <limits>
+
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+constexpr int64_t kMinValue = std::numeric_limits<int64_t>::min();
+constexpr int64_t kMaxValue = std::numeric_limits<int64_t>::max();
+constexpr int kBitsPerWord = 64;
+
+int64_t
+PackedWords(int64_t n, int bit_width) {
+    return (n * bit_width + kBitsPerWord - 1) / kBitsPerWord;
+}
+}  // namespace
+
+std::unique_ptr<PackedIntColumn>
+PackedIntColumn::Encode(const int64_t* values, int64_t n, int max_bit_width) {
+    if (n == 0) {
+        return nullptr;
+    }
+    auto [min, max] = std::minmax_element(values, values + n);
+    auto range = uint64_t(*max) - uint64_t(*min);
+    int bit_width = range == 0 ? 0 : kBitsPerWord - __builtin_clzll(range);
+    int64_t run_count = 1;
+    for (int64_t i = 1; i < n; ++i) {
+        run_count += values[i] != values[i - 1];
+    }
+
+    auto raw_size = n * int64_t(sizeof(int64_t));
+    auto run_length_size = run_count * int64_t(2 * sizeof(int64_t));
+    auto packed_size = bit_width <= max_bit_width ? PackedWords(n, bit_width) * int64_t(sizeof(uint64_t)) : raw_size;
+    std::unique_ptr<PackedIntColumn> column(new PackedIntColumn());
+    column->row_count_ = n;
+    if (run_length_size < packed_size && run_length_size <= raw_size / 2) {
+        column->run_values_.reserve(run_count);
+        column->run_ends_.reserve(run_count);
+        for (int64_t i = 1; i <= n; ++i) {
+            if (i == n || values[i] != values[i - 1]) {
+                column->run_values_.push_back(values[i - 1]);
+                column->run_ends_.push_back(i);
+            }
+        }
+        return column;
+    }
+    if (bit_width > max_bit_width) {
+        return nullptr;
+    }
+
+    column->min_ = *min;
+    column->bit_width_ = bit_width;
+    column->words_.resize(PackedWords(n, bit_width));
+    if (bit_width == 0) {
+        return column;
+    }
+    auto& words = column->words_;
+    for (int64_t i = 0; i < n; ++i) {
+        auto code = uint64_t(values[i]) - uint64_t(*min);
+        auto bit = uint64_t(i) * bit_width;
+        auto word = bit / kBitsPerWord;
+        auto shift = bit % kBitsPerWord;
+        words[word] |= code << shift;
+        if (shift + bit_width > kBitsPerWord) {
+            words[word + 1] |= code >> (kBitsPerWord - shift);
+        }
+    }
+    return column;
+}
+
+void
+PackedIntColumn::Unpack(int64_t begin, int64_t n, uint64_t* codes) const {
+    if (bit_width_ == 0) {
+        std::fill(codes, codes + n, 0);
+        return;
+    }
+    auto mask = bit_width_ == kBitsPerWord ? ~uint64_t(0) : (uint64_t(1) << bit_width_) - 1;
+    auto bit = uint64_t(begin) * bit_width_;
+    for (int64_t i = 0; i < n; ++i, bit += bit_width_) {
+        auto word = bit / kBitsPerWord;
+        auto shift = bit % kBitsPerWord;
+        auto code = words_[word] >> shift;
+        if (shift + bit_width_ > kBitsPerWord) {
+            code |= words_[word + 1] << (kBitsPerWord - shift);
+        }
+        codes[i] = code & mask;
+    }
+}
+
+void
+PackedIntColumn::AssertRowCount(int64_t row_count) const {
+    AssertInfo(row_count <= row_count_, "row count is bigger than the packed column");
+}
+
+BitsetType
+PackedIntColumn::RowsOfRuns(int64_t row_count, const std::vector<uint8_t>& flags) const {
+    AssertRowCount(row_count);
+    BitsetType result(row_count);
+    int64_t begin = 0;
+    for (size_t run = 0; run < run_ends_.size() && begin < row_count; ++run) {
+        auto end = std::min(run_ends_[run], row_count);
+        if (flags[run]) {
+            result.set(begin, end - begin, true);
+        }
+        begin = end;
+    }
+    return result;
+}
+
+BitsetType
+PackedIntColumn::RowsInRange(int64_t row_count, int64_t lower, int64_t upper) const {
+    if (is_run_length()) {
+        return Match(row_count, [lower, upper](int64_t value) { return lower <= value && value <= upper; });
+    }
+    lower = std::max(lower, min_);
+    if (lower > upper) {
+        AssertRowCount(row_count);
+        return BitsetType(row_count);
+    }
+    // one unsigned compare per row on the codes: code - begin wraps around for the codes below begin
+    auto begin = uint64_t(lower) - uint64_t(min_);
+    auto span = uint64_t(upper) - uint64_t(lower);
+    return RowsOfCodes(row_count, [begin, span](uint64_t code) { return code - begin <= span; });
+}
+
+BitsetType
+PackedIntColumn::Range(int64_t row_count, OpType op, int64_t value) const {
+    switch (op) {
+        case OpType::Equal: {
+            return RowsInRange(row_count, value, value);
+        }
+        case OpType::NotEqual: {
+            auto result = RowsInRange(row_count, value, value);
+            result.flip();
+            return result;
+        }
+        case OpType::GreaterThan: {
+            return Range(row_count, value, false, kMaxValue, true);
+        }
+        case OpType::GreaterEqual: {
+            return RowsInRange(row_count, value, kMaxValue);
+        }
+        case OpType::LessThan: {
+            return Range(row_count, kMinValue, true, value, false);
+        }
+        case OpType::LessEqual: {
+            return RowsInRange(row_count, kMinValue, value);
+        }
+        default: {
+            PanicInfo("unsupported op on packed column: " + std::to_string(op));
+        }
+    }
+}
+
+BitsetType
+PackedIntColumn::Range(int64_t row_count,
+                       int64_t lower,
+                       bool lower_inclusive,
+                       int64_t upper,
+                       bool upper_inclusive) const {
+    if ((!lower_inclusive && lower == kMaxValue) || (!upper_inclusive && upper == kMinValue)) {
+        AssertRowCount(row_count);
+        return BitsetType(row_count);
+    }
+    return RowsInRange(row_count, lower_inclusive ? lower : lower + 1, upper_inclusive ? upper : upper - 1);
+}
+
+BitsetType
+PackedIntColumn::In(int64_t row_count, size_t n, const int64_t* values) const {
+    std::vector<int64_t> sorted(values, values + n);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    if (sorted.size() == 1) {
+        return RowsInRange(row_count, sorted.front(), sorted.front());
+    }
+    auto is_term = [&sorted](int64_t value) { return std::binary_search(sorted.begin(), sorted.end(), value); };
+    return Match(row_count, is_term);
+}
+
+int64_t
+PackedIntColumn::ByteSize() const {
+    return (words_.size() + run_values_.size() + run_ends_.size()) * sizeof(int64_t);
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,156 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// Compressed INT64 column of a sealed segment, in one of two forms:
+// - frame of reference: per row value - min, bit-packed with the bits of max - min
+// - run length: the value and the end row of each run of equal values, for sorted or clustered columns
+// Predicates are evaluated on the packed codes, or once per run, and values are only decoded for output
+class PackedIntColumn {
+ public:
+    // encode values[0, n) in the smaller of the two forms, or return nullptr if the codes need more than
+    // max_bit_width bits and there are too many runs for the run length form to take at most half the raw size
+    static std::unique_ptr<PackedIntColumn>
+    Encode(const int64_t* values, int64_t n, int max_bit_width);
+
+    int64_t
+    row_count() const {
+        return row_count_;
+    }
+
+    bool
+    is_run_length() const {
+        return !run_ends_.empty();
+    }
+
+    // bits per row of the frame of reference form, 0 for a run length column
+    int
+    bit_width() const {
+        return bit_width_;
+    }
+
+    int64_t
+    run_count() const {
+        return run_ends_.size();
+    }
+
+    int64_t
+    Get(int64_t row) const {
+        if (is_run_length()) {
+            return run_values_[RunOf(row)];
+        }
+        uint64_t code;
+        Unpack(row, 1, &code);
+        return int64_t(uint64_t(min_) + code);
+    }
+
+    // The predicates below return a bitset of the rows [0, row_count), as a filter may only see the rows
+    // inserted before its timestamp
+
+    // rows compared to value by op, one of Equal, NotEqual, GreaterThan, GreaterEqual, LessThan or LessEqual
+    BitsetType
+    Range(int64_t row_count, OpType op, int64_t value) const;
+
+    BitsetType
+    Range(int64_t row_count,
+          int64_t lower,
+          bool lower_inclusive,
+          int64_t upper,
+          bool upper_inclusive) const;
+
+    // rows whose value is one of values[0, n)
+    BitsetType
+    In(int64_t row_count, size_t n, const int64_t* values) const;
+
+    // rows whose value passes pred, which is called once per run of a run length column
+    template <typename Pred>
+    BitsetType
+    Match(int64_t row_count, Pred pred) const {
+        if (is_run_length()) {
+            std::vector<uint8_t> flags(run_values_.size());
+            for (size_t run = 0; run < run_values_.size(); ++run) {
+                flags[run] = pred(run_values_[run]);
+            }
+            return RowsOfRuns(row_count, flags);
+        }
+        auto min = uint64_t(min_);
+        return RowsOfCodes(row_count, [min, &pred](uint64_t code) { return pred(int64_t(min + code)); });
+    }
+
+    int64_t
+    ByteSize() const;
+
+ private:
+    PackedIntColumn() = default;
+
+    // decode the codes of rows [begin, begin + n)
+    void
+    Unpack(int64_t begin, int64_t n, uint64_t* codes) const;
+
+    int64_t
+    RunOf(int64_t row) const {
+        return std::upper_bound(run_ends_.begin(), run_ends_.end(), row) - run_ends_.begin();
+    }
+
+    // rows whose value is in [lower, upper]
+    BitsetType
+    RowsInRange(int64_t row_count, int64_t lower, int64_t upper) const;
+
+    // rows of the flagged runs
+    BitsetType
+    RowsOfRuns(int64_t row_count, const std::vector<uint8_t>& flags) const;
+
+    // set bit i of the result when the code of row i passes pred, unpacking a word of the bitset at a time
+    template <typename Pred>
+    BitsetType
+    RowsOfCodes(int64_t row_count, Pred pred) const {
+        AssertRowCount(row_count);
+        size_t n = row_count;
+        BitsetType result(n);
+        auto blocks = result.blocks();
+        uint64_t codes[BitsetType::bits_per_block];
+        for (size_t begin = 0; begin < n; begin += BitsetType::bits_per_block) {
+            auto count = std::min(n - begin, BitsetType::bits_per_block);
+            Unpack(begin, count, codes);
+            BitsetType::block_type block = 0;
+            for (size_t i = 0; i < count; ++i) {
+                block |= BitsetType::block_type(pred(codes[i])) << i;
+            }
+            blocks[begin / BitsetType::bits_per_block] = block;
+        }
+        return result;
+    }
+
+    void
+    AssertRowCount(int64_t row_count) const;
+
+ private:
+    int64_t row_count_ = 0;
+    // frame of reference form
+    int64_t min_ = 0;
+    int bit_width_ = 0;
+    std::vector<uint64_t> words_;
+    // run length form, run i covers the rows [run_ends_[i - 1], run_ends_[i])
+    std::vector<int64_t> run_values_;
+    std::vector<int64_t> run_ends_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,162 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <string_view>
+
+#include "segcore/PlanCache.h"
+
+namespace milvus::segcore {
+
+// parsed Expr trees are roughly a few times larger than their protobuf encoding
+constexpr int64_t EXPR_EXPANSION_FACTOR = 4;
+
+static int64_t
+EstimatePlanMemory(int64_t serialized_size) {
+    // key bytes + parsed plan
+    return serialized_size + serialized_size * EXPR_EXPANSION_FACTOR + sizeof(query::Plan) +
+           sizeof(query::VectorPlanNode);
+}
+
+static std::unique_ptr<query::Plan>
+ShallowCopy(const query::Plan& plan) {
+    auto res = std::make_unique<query::Plan>(plan.schema_);
+    res->plan_node_ = plan.plan_node_;
+    res->tag2field_ = plan.tag2field_;
+    res->target_entries_ = plan.target_entries_;
+    res->extra_info_opt_ = plan.extra_info_opt_;
+    return res;
+}
+
+static std::unique_ptr<query::RetrievePlan>
+ShallowCopy(const query::RetrievePlan& plan) {
+    auto res = std::make_unique<query::RetrievePlan>(plan.schema_);
+    res->plan_node_ = plan.plan_node_;
+    res->field_ids_ = plan.field_ids_;
+    return res;
+}
+
+std::unique_ptr<query::Plan>
+PlanCache::GetOrCreateSearchPlan(const Schema& schema, const void* serialized_expr_plan, int64_t size) {
+    if (!enabled()) {
+        return query::CreateSearchPlanByExpr(schema, serialized_expr_plan, size);
+    }
+
+    std::string serialized(reinterpret_cast<const char*>(serialized_expr_plan), size);
+    CacheKey key{std::hash<std::string_view>{}(serialized), false};
+    {
+        std::lock_guard lck(mutex_);
+        auto entry = lookup(key, serialized);
+        if (entry != nullptr) {
+            return ShallowCopy(*entry->search_plan);
+        }
+    }
+
+    // parse outside the lock, concurrent misses on the same key are resolved in insert()
+    std::shared_ptr<const query::Plan> plan = query::CreateSearchPlanByExpr(schema, serialized_expr_plan, size);
+    auto res = ShallowCopy(*plan);
+
+    CacheEntry entry{key, std::move(serialized), std::move(plan), nullptr, EstimatePlanMemory(size)};
+    insert(std::move(entry));
+    return res;
+}
+
+std::unique_ptr<query::RetrievePlan>
+PlanCache::GetOrCreateRetrievePlan(const Schema& schema, const void* serialized_expr_plan, int64_t size) {
+    if (!enabled()) {
+        return query::CreateRetrievePlanByExpr(schema, serialized_expr_plan, size);
+    }
+
+    std::string serialized(reinterpret_cast<const char*>(serialized_expr_plan), size);
+    CacheKey key{std::hash<std::string_view>{}(serialized), true};
+    {
+        std::lock_guard lck(mutex_);
+        auto entry = lookup(key, serialized);
+        if (entry != nullptr) {
+            return ShallowCopy(*entry->retrieve_plan);
+        }
+    }
+
+    std::shared_ptr<const query::RetrievePlan> plan =
+        query::CreateRetrievePlanByExpr(schema, serialized_expr_plan, size);
+    auto res = ShallowCopy(*plan);
+
+    CacheEntry entry{key, std::move(serialized), nullptr, std::move(plan), EstimatePlanMemory(size)};
+    insert(std::move(entry));
+    return res;
+}
+
+const PlanCache::CacheEntry*
+PlanCache::lookup(const CacheKey& key, const std::string& serialized_expr_plan) {
+    auto iter = index_.find(key);
+    if (iter == index_.end() || iter->second->serialized_expr_plan != serialized_expr_plan) {
+        ++miss_count_;
+        return nullptr;
+    }
+    ++hit_count_;
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return &lru_.front();
+}
+
+void
+PlanCache::insert(CacheEntry&& entry) {
+    std::lock_guard lck(mutex_);
+    auto iter = index_.find(entry.key);
+    if (iter != index_.end()) {
+        if (iter->second->serialized_expr_plan == entry.serialized_expr_plan) {
+            // another thread cached the same plan meanwhile
+            return;
+        }
+        // hash collision, the newer plan wins
+        memory_bytes_ -= iter->second->memory_bytes;
+        lru_.erase(iter->second);
+        index_.erase(iter);
+    }
+    if (entry.memory_bytes > memory_limit_) {
+        return;
+    }
+    memory_bytes_ += entry.memory_bytes;
+    lru_.push_front(std::move(entry));
+    index_.emplace(lru_.front().key, lru_.begin());
+    evict_if_needed();
+}
+
+void
+PlanCache::evict_if_needed() {
+    while (!lru_.empty() && (int64_t(lru_.size()) > capacity_ || memory_bytes_ > memory_limit_)) {
+        auto& victim = lru_.back();
+        memory_bytes_ -= victim.memory_bytes;
+        index_.erase(victim.key);
+        lru_.pop_back();
+        ++evict_count_;
+    }
+}
+
+PlanCacheStats
+PlanCache::get_stats() const {
+    std::lock_guard lck(mutex_);
+    PlanCacheStats stats;
+    stats.hit_count = hit_count_;
+    stats.miss_count = miss_count_;
+    stats.evict_count = evict_count_;
+    stats.entry_count = lru_.size();
+    stats.memory_bytes = memory_bytes_;
+    return stats;
+}
+
+void
+PlanCache::clear() {
+    std::lock_guard lck(mutex_);
+    index_.clear();
+    lru_.clear();
+    memory_bytes_ = 0;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/Schema.h"
+#include "query/Plan.h"
+#include "query/PlanImpl.h"
+
+namespace milvus::segcore {
+
+struct PlanCacheStats {
+    int64_t hit_count = 0;
+    int64_t miss_count = 0;
+    int64_t evict_count = 0;
+    int64_t entry_count = 0;
+    int64_t memory_bytes = 0;
+};
+
+// Bounded LRU of parsed plans of a collection, keyed by the hash of serialized_expr_plan.
+// Cached plans are immutable; every lookup returns a lightweight Plan/RetrievePlan that
+// shares the parsed plan node and copies the prepared execution info (tag2field_,
+// target_entries_, extra_info_opt_), so callers still own and delete what they get.
+// A capacity of 0 disables the cache.
+class PlanCache {
+ public:
+    PlanCache(int64_t capacity, int64_t memory_limit) : capacity_(capacity), memory_limit_(memory_limit) {
+    }
+
+    PlanCache(const PlanCache&) = delete;
+    PlanCache&
+    operator=(const PlanCache&) = delete;
+
+    std::unique_ptr<query::Plan>
+    GetOrCreateSearchPlan(const Schema& schema, const void* serialized_expr_plan, int64_t size);
+
+    std::unique_ptr<query::RetrievePlan>
+    GetOrCreateRetrievePlan(const Schema& schema, const void* serialized_expr_plan, int64_t size);
+
+    bool
+    enabled() const {
+        return capacity_ > 0 && memory_limit_ > 0;
+    }
+
+    PlanCacheStats
+    get_stats() const;
+
+    void
+    clear();
+
+ private:
+    struct CacheKey {
+        size_t expr_hash;
+        bool is_retrieve;
+
+        bool
+        operator==(const CacheKey& other) const {
+            return expr_hash == other.expr_hash && is_retrieve == other.is_retrieve;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t
+        operator()(const CacheKey& key) const {
+            return key.expr_hash ^ size_t(key.is_retrieve);
+        }
+    };
+
+    struct CacheEntry {
+        CacheKey key;
+        // kept to rule out hash collisions
+        std::string serialized_expr_plan;
+        std::shared_ptr<const query::Plan> search_plan;
+        std::shared_ptr<const query::RetrievePlan> retrieve_plan;
+        int64_t memory_bytes;
+    };
+
+    using LruList = std::list<CacheEntry>;
+
+    // return nullptr on miss, move the entry to the front on hit
+    const CacheEntry*
+    lookup(const CacheKey& key, const std::string& serialized_expr_plan);
+
+    void
+    insert(CacheEntry&& entry);
+
+    void
+    evict_if_needed();
+
+ private:
+    const int64_t capacity_;
+    const int64_t memory_limit_;
+
+    mutable std::mutex mutex_;
+    LruList lru_;
+    std::unordered_map<CacheKey, LruList::iterator, CacheKeyHash> index_;
+    int64_t memory_bytes_ = 0;
+    int64_t hit_count_ = 0;
+    int64_t miss_count_ = 0;
+    int64_t evict_count_ = 0;
+};
+
+}  // namespace milvus::segcore
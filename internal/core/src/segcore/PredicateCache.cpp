@@ -0,0 +1,103 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/PredicateCache.h"
+
+namespace milvus::segcore {
+
+PredicateCache::CompressedBitset
+PredicateCache::CompressedBitset::Compress(const BitsetType& bitset) {
+    CompressedBitset res;
+    res.flipped = bitset.count() > bitset.size() / 2;
+    res.bitmap = res.flipped ? RoaringBitmap::FromBitset(~bitset) : RoaringBitmap::FromBitset(bitset);
+    return res;
+}
+
+BitsetType
+PredicateCache::CompressedBitset::Decompress() const {
+    auto res = bitmap.ToBitset();
+    if (flipped) {
+        res.flip();
+    }
+    return res;
+}
+
+std::optional<BitsetType>
+PredicateCache::Get(const std::string& fingerprint, int64_t size) {
+    std::lock_guard lck(mutex_);
+    auto iter = index_.find(fingerprint);
+    if (iter == index_.end() || int64_t(iter->second->bitset.bitmap.size()) != size) {
+        ++miss_count_;
+        return std::nullopt;
+    }
+    ++hit_count_;
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return lru_.front().bitset.Decompress();
+}
+
+void
+PredicateCache::Put(const std::string& fingerprint, const BitsetType& bitset) {
+    if (!enabled()) {
+        return;
+    }
+    // compress outside the lock
+    auto compressed = CompressedBitset::Compress(bitset);
+    auto memory_bytes = int64_t(compressed.memory_bytes() + fingerprint.size() + sizeof(CacheEntry));
+    if (memory_bytes > memory_limit_) {
+        return;
+    }
+
+    std::lock_guard lck(mutex_);
+    auto iter = index_.find(fingerprint);
+    if (iter != index_.end()) {
+        memory_bytes_ -= iter->second->memory_bytes;
+        auto entry = iter->second;
+        index_.erase(iter);
+        lru_.erase(entry);
+    }
+    lru_.push_front(CacheEntry{fingerprint, std::move(compressed), memory_bytes});
+    index_.emplace(lru_.front().fingerprint, lru_.begin());
+    memory_bytes_ += memory_bytes;
+    evict_if_needed();
+}
+
+void
+PredicateCache::evict_if_needed() {
+    while (!lru_.empty() && memory_bytes_ > memory_limit_) {
+        auto& victim = lru_.back();
+        memory_bytes_ -= victim.memory_bytes;
+        index_.erase(victim.fingerprint);
+        lru_.pop_back();
+        ++evict_count_;
+    }
+}
+
+void
+PredicateCache::Clear() {
+    std::lock_guard lck(mutex_);
+    index_.clear();
+    lru_.clear();
+    memory_bytes_ = 0;
+}
+
+PredicateCacheStats
+PredicateCache::get_stats() const {
+    std::lock_guard lck(mutex_);
+    PredicateCacheStats stats;
+    stats.hit_count = hit_count_;
+    stats.miss_count = miss_count_;
+    stats.evict_count = evict_count_;
+    stats.entry_count = lru_.size();
+    stats.memory_bytes = memory_bytes_;
+    return stats;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "common/RoaringBitmap.h"
+#include "common/Types.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+struct PredicateCacheStats {
+    int64_t hit_count = 0;
+    int64_t miss_count = 0;
+    int64_t evict_count = 0;
+    int64_t entry_count = 0;
+    int64_t memory_bytes = 0;
+};
+
+// LRU of predicate results of a sealed segment, keyed by the fingerprint of the filter expr.
+// Sealed data never changes once loaded and deletes/timestamps are masked after the filter,
+// so the raw output of ExecExprVisitor can be reused by every later query with the same filter.
+// Bitsets are stored as roaring bitmaps and the total size is bounded by memory_limit.
+class PredicateCache {
+ public:
+    explicit PredicateCache(int64_t memory_limit) : memory_limit_(memory_limit) {
+    }
+
+    PredicateCache(const PredicateCache&) = delete;
+    PredicateCache&
+    operator=(const PredicateCache&) = delete;
+
+    bool
+    enabled() const {
+        return memory_limit_ > 0;
+    }
+
+    // return std::nullopt if absent or cached for a different row count
+    std::optional<BitsetType>
+    Get(const std::string& fingerprint, int64_t size);
+
+    void
+    Put(const std::string& fingerprint, const BitsetType& bitset);
+
+    void
+    Clear();
+
+    PredicateCacheStats
+    get_stats() const;
+
+ private:
+    // stored as the complement if most bits are set, so both very selective and very loose
+    // filters stay sparse
+    struct CompressedBitset {
+        RoaringBitmap bitmap;
+        bool flipped = false;
+
+        static CompressedBitset
+        Compress(const BitsetType& bitset);
+
+        BitsetType
+        Decompress() const;
+
+        int64_t
+        memory_bytes() const {
+            return sizeof(CompressedBitset) + bitmap.memory_bytes();
+        }
+    };
+
+    struct CacheEntry {
+        std::string fingerprint;
+        CompressedBitset bitset;
+        int64_t memory_bytes;
+    };
+
+    using LruList = std::list<CacheEntry>;
+
+    void
+    evict_if_needed();
+
+ private:
+    const int64_t memory_limit_;
+
+    mutable std::mutex mutex_;
+    LruList lru_;
+    // keys point into the fingerprints owned by lru_
+    std::unordered_map<std::string_view, LruList::iterator> index_;
+    int64_t memory_bytes_ = 0;
+    int64_t hit_count_ = 0;
+    int64_t miss_count_ = 0;
+    int64_t evict_count_ = 0;
+};
+
+}  // namespace milvus::segcore
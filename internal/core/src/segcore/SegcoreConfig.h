@@ -75,6 +75,136 @@ class SegcoreConfig {
         nprobe_ = nprobe;
     }
 
+    int64_t
+    get_plan_cache_capacity() const {
+        return plan_cache_capacity_;
+    }
+
+    void
+    set_plan_cache_capacity(int64_t capacity) {
+        plan_cache_capacity_ = capacity;
+    }
+
+    int64_t
+    get_plan_cache_memory_limit() const {
+        return plan_cache_memory_limit_;
+    }
+
+    void
+    set_plan_cache_memory_limit(int64_t memory_limit) {
+        plan_cache_memory_limit_ = memory_limit;
+    }
+
+    int64_t
+    get_predicate_cache_memory_limit() const {
+        return predicate_cache_memory_limit_;
+    }
+
+    void
+    set_predicate_cache_memory_limit(int64_t memory_limit) {
+        predicate_cache_memory_limit_ = memory_limit;
+    }
+
+    bool
+    get_lazy_predicate_enabled() const {
+        return lazy_predicate_enabled_;
+    }
+
+    void
+    set_lazy_predicate_enabled(bool enabled) {
+        lazy_predicate_enabled_ = enabled;
+    }
+
+    int64_t
+    get_exact_search_threshold() const {
+        return exact_search_threshold_;
+    }
+
+    void
+    set_exact_search_threshold(int64_t threshold) {
+        exact_search_threshold_ = threshold;
+    }
+
+    bool
+    get_small_index_async() const {
+        return small_index_async_;
+    }
+
+    void
+    set_small_index_async(bool async) {
+        small_index_async_ = async;
+    }
+
+    int64_t
+    get_small_index_build_threads() const {
+        return small_index_build_threads_;
+    }
+
+    void
+    set_small_index_build_threads(int64_t num_threads) {
+        small_index_build_threads_ = num_threads;
+    }
+
+    int64_t
+    get_small_index_build_queue_size() const {
+        return small_index_build_queue_size_;
+    }
+
+    void
+    set_small_index_build_queue_size(int64_t queue_size) {
+        small_index_build_queue_size_ = queue_size;
+    }
+
+    bool
+    get_vector_small_index_enabled() const {
+        return vector_small_index_enabled_;
+    }
+
+    void
+    set_vector_small_index_enabled(bool enabled) {
+        vector_small_index_enabled_ = enabled;
+    }
+
+    bool
+    get_scalar_small_index_enabled() const {
+        return scalar_small_index_enabled_;
+    }
+
+    void
+    set_scalar_small_index_enabled(bool enabled) {
+        scalar_small_index_enabled_ = enabled;
+    }
+
+    int64_t
+    get_string_dict_max_cardinality() const {
+        return string_dict_max_cardinality_;
+    }
+
+    void
+    set_string_dict_max_cardinality(int64_t max_cardinality) {
+        string_dict_max_cardinality_ = max_cardinality;
+    }
+
+    int64_t
+    get_packed_int_max_bit_width() const {
+        return packed_int_max_bit_width_;
+    }
+
+    void
+    set_packed_int_max_bit_width(int64_t max_bit_width) {
+        packed_int_max_bit_width_ = max_bit_width;
+    }
+
+    bool
+    get_mmap_enabled() const {
+        return mmap_enabled_;
+    }
+
+    void
+    set_mmap_enabled(bool enabled) {
+        mmap_enabled_ = enabled;
+    }
+
     void
     set_small_index_config(const MetricType& metric_type, const SmallIndexConf& small_index_conf) {
         table_[metric_type] = small_index_conf;
@@ -84,6 +214,32 @@ class SegcoreConfig {
     int64_t chunk_rows_ = 32 * 1024;
     int64_t nlist_ = 100;
     int64_t nprobe_ = 4;
+    // plan cache is disabled by default, see segcore/PlanCache.h
+    int64_t plan_cache_capacity_ = 0;
+    int64_t plan_cache_memory_limit_ = 64 * 1024 * 1024;
+    // per sealed segment, 0 disables the predicate cache, see segcore/PredicateCache.h
+    int64_t predicate_cache_memory_limit_ = 0;
+    // let searches evaluate expensive filters on their candidates only, see query/LazyPredicate.h
+    bool lazy_predicate_enabled_ = true;
+    // search exactly over the rows passing the filter when there are at most this many, 0 disables it
+    int64_t exact_search_threshold_ = 0;
+    // build the small indexes of growing segments in the background, see segcore/SmallIndexExecutor.h.
+    // The executor is sized by the thread and queue settings when the first build is submitted
+    bool small_index_async_ = true;
+    int64_t small_index_build_threads_ = 2;
+    int64_t small_index_build_queue_size_ = 16;
+    // which fields of growing segments get small indexes per chunk
+    bool vector_small_index_enabled_ = true;
+    bool scalar_small_index_enabled_ = true;
+    // dictionary encode the VARCHAR columns loaded into sealed segments with at most this many distinct values,
+    // and at most one per two rows, 0 disables it, see segcore/StringDictColumn.h
+    int64_t string_dict_max_cardinality_ = 0;
+    // bit-pack the INT64 columns loaded into sealed segments whose max - min fits in this many bits, or run length
+    // encode them if that takes at most half the raw size, 0 disables it, see segcore/PackedIntColumn.h
+    int64_t packed_int_max_bit_width_ = 0;
+    // serve the other columns loaded into sealed segments from files mapped under the local root path,
+    // see segcore/MmapVector.h
+    bool mmap_enabled_ = false;
     std::map<knowhere::MetricType, SmallIndexConf> table_;
 };
 
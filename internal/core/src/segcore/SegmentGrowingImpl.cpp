@@ -14,6 +14,7 @@
 #include <queue>
 #include <thread>
 #include <boost/iterator/counting_iterator.hpp>
+#include <tbb/parallel_for.h>
 
 #include "common/Consts.h"
 #include "query/PlanNode.h"
@@ -37,17 +38,7 @@ SegmentGrowingImpl::PreDelete(int64_t size) {
 
 void
 SegmentGrowingImpl::mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const {
-    auto del_barrier = get_barrier(get_deleted_record(), timestamp);
-    if (del_barrier == 0) {
-        return;
-    }
-    auto bitmap_holder = get_deleted_bitmap(del_barrier, ins_barrier, deleted_record_, insert_record_, timestamp);
-    if (!bitmap_holder || !bitmap_holder->bitmap_ptr) {
-        return;
-    }
-    auto& delete_bitset = *bitmap_holder->bitmap_ptr;
-    AssertInfo(delete_bitset.size() == bitset.size(), "Deleted bitmap size not equal to filtered bitmap size");
-    bitset |= delete_bitset;
+    deleted_record_.mask_deleted(bitset, ins_barrier, timestamp);
 }
 
 void
@@ -59,38 +50,65 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     AssertInfo(insert_data->num_rows() == size, "Entities_raw count not equal to insert size");
     //    AssertInfo(insert_data->fields_data_size() == schema_->size(),
     //               "num fields of insert data not equal to num of schema fields");
-    // step 1: check insert data if valid
-    std::unordered_map<FieldId, int64_t> field_id_to_offset;
-    int64_t field_offset = 0;
-    for (auto field : insert_data->fields_data()) {
-        auto field_id = FieldId(field.field_id());
-        AssertInfo(!field_id_to_offset.count(field_id), "duplicate field data");
-        field_id_to_offset.emplace(field_id, field_offset++);
+    // step 1: check insert data if valid, and find the data of every schema field
+    auto num_fields = int64_t(insert_fields_.size());
+    std::vector<const DataArray*> fields_data(num_fields, nullptr);
+    for (int64_t i = 0; i < insert_data->fields_data_size(); ++i) {
+        auto& field_data = insert_data->fields_data(i);
+        auto field_id = FieldId(field_data.field_id());
+        // insert data usually lists the fields in schema order, which needs no lookup
+        auto pos = i < num_fields && insert_fields_[i].field_id == field_id ? i : int64_t(-1);
+        if (pos < 0) {
+            auto iter = field_positions_.find(field_id);
+            if (iter == field_positions_.end()) {
+                continue;
+            }
+            pos = iter->second;
+        }
+        AssertInfo(fields_data[pos] == nullptr, "duplicate field data");
+        fields_data[pos] = &field_data;
+    }
+    for (int64_t pos = 0; pos < num_fields; ++pos) {
+        AssertInfo(fields_data[pos] != nullptr, "Cannot find field_id");
     }
+    AssertInfo(pk_position_ >= 0, "Primary key is -1");
 
     // step 2: sort timestamp
     // query node already guarantees that the timestamp is ordered, avoid field data copy in c++
 
-    // step 3: fill into Segment.ConcurrentVector
+    // step 3: fill into Segment.ConcurrentVector and set pks to offset. Timestamps go first, as deletes look
+    // them up for the rows they find by pk. The other columns and the pks are independent of each other,
+    // large batches fan them out
     insert_record_.timestamps_.set_data_raw(reserved_offset, timestamps_raw, size);
-    insert_record_.row_ids_.set_data_raw(reserved_offset, row_ids, size);
-    for (auto [field_id, field_meta] : schema_->get_fields()) {
-        AssertInfo(field_id_to_offset.count(field_id), "Cannot find field_id");
-        auto data_offset = field_id_to_offset[field_id];
-        insert_record_.get_field_data_base(field_id)->set_data_raw(reserved_offset, size,
-                                                                   &insert_data->fields_data(data_offset), field_meta);
-    }
 
-    // step 4: set pks to offset
-    auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
-    AssertInfo(field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
-    std::vector<PkType> pks(size);
-    ParsePksFromFieldData(pks, insert_data->fields_data(field_id_to_offset[field_id]));
-    for (int i = 0; i < size; ++i) {
-        insert_record_.insert_pk(pks[i], reserved_offset + i);
+    // set pks to offset, and apply the deletes which came before these rows
+    auto insert_pks = [&] {
+        std::vector<PkType> pks(size);
+        ParsePksFromFieldData(pks, *fields_data[pk_position_]);
+        insert_record_.insert_pks(pks, reserved_offset);
+        deleted_record_.mark_inserted_rows(pks, timestamps_raw, reserved_offset);
+    };
+    // tasks [0, num_fields) copy the columns, then row ids, then pks
+    auto run_task = [&](int64_t task) {
+        if (task < num_fields) {
+            auto& field = insert_fields_[task];
+            field.data->set_data_raw(reserved_offset, size, fields_data[task], *field.meta);
+        } else if (task == num_fields) {
+            insert_record_.row_ids_.set_data_raw(reserved_offset, row_ids, size);
+        } else {
+            insert_pks();
+        }
+    };
+    auto num_tasks = num_fields + 2;
+    if (size >= PARALLEL_INSERT_MIN_ROWS) {
+        tbb::parallel_for(int64_t(0), num_tasks, run_task);
+    } else {
+        for (int64_t task = 0; task < num_tasks; ++task) {
+            run_task(task);
+        }
     }
 
-    // step 5: update small indexes
+    // step 4: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset, reserved_offset + size);
     if (enable_small_index_) {
         int64_t chunk_rows = segcore_config_.get_chunk_rows();
@@ -125,6 +143,10 @@ SegmentGrowingImpl::Delete(int64_t reserved_begin, int64_t size, const IdArray*
     deleted_record_.timestamps_.set_data_raw(reserved_begin, sort_timestamps.data(), size);
     deleted_record_.pks_.set_data_raw(reserved_begin, sort_pks.data(), size);
     deleted_record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
+
+    // step 3: mark the deleted rows
+    deleted_record_.index_deletes(sort_pks, sort_timestamps.data());
+    apply_deletes(deleted_record_, insert_record_, sort_pks, sort_timestamps.data());
     return Status::OK();
 }
 
@@ -158,6 +180,10 @@ SegmentGrowingImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     deleted_record_.pks_.set_data_raw(reserved_begin, pks.data(), size);
     deleted_record_.timestamps_.set_data_raw(reserved_begin, timestamps, size);
     deleted_record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
+
+    // step 3: mark the deleted rows
+    deleted_record_.index_deletes(pks, timestamps);
+    apply_deletes(deleted_record_, insert_record_, pks, timestamps);
 }
 
 SpanBase
@@ -188,6 +214,20 @@ SegmentGrowingImpl::vector_search(SearchInfo& search_info,
     }
 }
 
+bool
+SegmentGrowingImpl::get_vectors(FieldId field_id, const int64_t* seg_offsets, int64_t count, void* output) const {
+    auto vec_ptr = insert_record_.get_field_data_base(field_id);
+    auto& field_meta = schema_->operator[](field_id);
+    if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+        bulk_subscript_impl<FloatVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output);
+    } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
+        bulk_subscript_impl<BinaryVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output);
+    } else {
+        PanicInfo("The meta type of vector field is not vector type");
+    }
+    return true;
+}
+
 std::unique_ptr<DataArray>
 SegmentGrowingImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets, int64_t count) const {
     // TODO: support more types
@@ -243,9 +283,10 @@ SegmentGrowingImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets,
             return CreateScalarDataArrayFrom(output.data(), count, field_meta);
         }
         case DataType::VARCHAR: {
-            FixedVector<std::string> output(count);
+            // views into the column, the strings are copied once, into the result
+            FixedVector<std::string_view> output(count);
             bulk_subscript_impl<std::string>(*vec_ptr, seg_offsets, count, output.data());
-            return CreateScalarDataArrayFrom(output.data(), count, field_meta);
+            return CreateStringDataArrayFrom(output.data(), count, field_meta);
         }
         default: {
             PanicInfo("unsupported type");
@@ -284,7 +325,7 @@ SegmentGrowingImpl::bulk_subscript_impl(const VectorBase& vec_raw,
     auto vec_ptr = dynamic_cast<const ConcurrentVector<T>*>(&vec_raw);
     AssertInfo(vec_ptr, "Pointer of vec_raw is nullptr");
     auto& vec = *vec_ptr;
-    auto output = reinterpret_cast<T*>(output_raw);
+    auto output = reinterpret_cast<ChunkViewType<T>*>(output_raw);
     for (int64_t i = 0; i < count; ++i) {
         auto offset = seg_offsets[i];
         if (offset != INVALID_SEG_OFFSET) {
@@ -95,10 +95,12 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return *schema_;
     }
 
-    // return count of index that has index, i.e., [0, num_chunk_index) have built index
+    // return count of index that has index, i.e., [0, num_chunk_index) have built index,
+    // except the chunks whose build failed, see has_chunk_index
     int64_t
     num_chunk_index(FieldId field_id) const final {
-        return indexing_record_.get_finished_ack();
+        // fields with small indexes disabled have none
+        return indexing_record_.is_in(field_id) ? indexing_record_.get_finished_ack() : 0;
     }
 
     // count of chunk that has raw data
@@ -168,6 +170,20 @@ class SegmentGrowingImpl : public SegmentGrowing {
           insert_record_(*schema_, segcore_config.get_chunk_rows()),
           indexing_record_(*schema_, segcore_config_),
           id_(segment_id) {
+        for (auto field_id : schema_->get_field_ids()) {
+            field_positions_.emplace(field_id, insert_fields_.size());
+            insert_fields_.push_back(
+                {field_id, &schema_->operator[](field_id), insert_record_.get_field_data_base(field_id)});
+        }
+        auto pk_field_id = schema_->get_primary_field_id();
+        if (pk_field_id.has_value()) {
+            pk_position_ = field_positions_.at(pk_field_id.value());
+        }
+    }
+
+    ~SegmentGrowingImpl() override {
+        // the background small index builds read insert_record_, which is destroyed before indexing_record_
+        indexing_record_.WaitForBuilds();
     }
 
     void
@@ -181,6 +197,9 @@ class SegmentGrowingImpl : public SegmentGrowing {
                   const BitsetView& bitset,
                   SearchResult& output) const override;
 
+    bool
+    get_vectors(FieldId field_id, const int64_t* seg_offsets, int64_t count, void* output) const override;
+
  public:
     void
     mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const override;
@@ -234,6 +253,21 @@ class SegmentGrowingImpl : public SegmentGrowing {
 
  private:
     bool enable_small_index_ = true;
+
+    // Insert copies the columns of batches with at least this many rows in parallel
+    static constexpr int64_t PARALLEL_INSERT_MIN_ROWS = 1024;
+
+    struct InsertField {
+        FieldId field_id;
+        const FieldMeta* meta;
+        VectorBase* data;
+    };
+    // the schema fields in schema order with their columns, and the position of every field in it,
+    // resolved once per segment rather than per insert
+    std::vector<InsertField> insert_fields_;
+    std::unordered_map<FieldId, int64_t> field_positions_;
+    // -1 if the schema has no primary key
+    int64_t pk_position_ = -1;
 };
 
 inline SegmentGrowingPtr
@@ -23,6 +23,7 @@ SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan, SearchResult&
     AssertInfo(results.seg_offsets_.size() == size, "Size of result distances is not equal to size of ids");
     Assert(results.primary_keys_.size() == 0);
     results.primary_keys_.resize(size);
+    ProfilePhase phase(results.profile_.get(), "fill_primary_keys");
 
     auto pk_field_id_opt = get_schema().get_primary_field_id();
     AssertInfo(pk_field_id_opt.has_value(), "Cannot get primary key offset from schema");
@@ -41,6 +42,7 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, SearchResult&
     AssertInfo(plan, "empty plan");
     auto size = results.distances_.size();
     AssertInfo(results.seg_offsets_.size() == size, "Size of result distances is not equal to size of ids");
+    ProfilePhase phase(results.profile_.get(), "fill_target_entry");
 
     // fill other entries except primary key by result_offset
     for (auto field_id : plan->target_entries_) {
@@ -52,23 +54,31 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, SearchResult&
 std::unique_ptr<SearchResult>
 SegmentInternalInterface::Search(const query::Plan* plan,
                                  const query::PlaceholderGroup* placeholder_group,
-                                 Timestamp timestamp) const {
+                                 Timestamp timestamp,
+                                 bool with_profile) const {
     std::shared_lock lck(mutex_);
     check_search(plan);
     query::ExecPlanNodeVisitor visitor(*this, timestamp, placeholder_group);
+    QueryProfilePtr profile = with_profile ? std::make_shared<QueryProfile>() : nullptr;
+    visitor.set_profile(profile.get());
     auto results = std::make_unique<SearchResult>();
     *results = visitor.get_moved_result(*plan->plan_node_);
     results->segment_ = (void*)this;
+    results->profile_ = std::move(profile);
     return results;
 }
 
 std::unique_ptr<proto::segcore::RetrieveResults>
-SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan, Timestamp timestamp) const {
+SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
+                                   Timestamp timestamp,
+                                   QueryProfile* profile) const {
     std::shared_lock lck(mutex_);
     auto results = std::make_unique<proto::segcore::RetrieveResults>();
     query::ExecPlanNodeVisitor visitor(*this, timestamp);
+    visitor.set_profile(profile);
     auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
     retrieve_results.segment_ = (void*)this;
+    ProfilePhase phase(profile, "fill_target_entry");
 
     results->mutable_offset()->Add(retrieve_results.result_offsets_.begin(), retrieve_results.result_offsets_.end());
 
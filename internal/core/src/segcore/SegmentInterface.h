@@ -20,6 +20,9 @@
 
 #include "DeletedRecord.h"
 #include "FieldIndexing.h"
+#include "PackedIntColumn.h"
+#include "PredicateCache.h"
+#include "StringDictColumn.h"
 #include "common/Schema.h"
 #include "common/Span.h"
 #include "common/SystemProperty.h"
@@ -47,11 +50,16 @@ class SegmentInterface {
     virtual void
     FillTargetEntry(const query::Plan* plan, SearchResult& results) const = 0;
 
+    // with_profile attaches an execution profile to the result
     virtual std::unique_ptr<SearchResult>
-    Search(const query::Plan* Plan, const query::PlaceholderGroup* placeholder_group, Timestamp timestamp) const = 0;
+    Search(const query::Plan* Plan,
+           const query::PlaceholderGroup* placeholder_group,
+           Timestamp timestamp,
+           bool with_profile = false) const = 0;
 
+    // the execution profile is filled into profile if not nullptr
     virtual std::unique_ptr<proto::segcore::RetrieveResults>
-    Retrieve(const query::RetrievePlan* Plan, Timestamp timestamp) const = 0;
+    Retrieve(const query::RetrievePlan* Plan, Timestamp timestamp, QueryProfile* profile = nullptr) const = 0;
 
     // TODO: memory use is not correct when load string or load string index
     virtual int64_t
@@ -92,6 +100,12 @@ class SegmentInternalInterface : public SegmentInterface {
         return static_cast<Span<T>>(chunk_data_impl(field_id, chunk_id));
     }
 
+    // whether the chunk has a scalar index, a chunk of a growing segment has none if its small index failed to build
+    bool
+    has_chunk_index(FieldId field_id, int64_t chunk_id) const {
+        return chunk_index_impl(field_id, chunk_id) != nullptr;
+    }
+
     template <typename T>
     const index::ScalarIndex<T>&
     chunk_scalar_index(FieldId field_id, int64_t chunk_id) const {
@@ -106,7 +120,8 @@ class SegmentInternalInterface : public SegmentInterface {
     std::unique_ptr<SearchResult>
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_group,
-           Timestamp timestamp) const override;
+           Timestamp timestamp,
+           bool with_profile = false) const override;
 
     void
     FillPrimaryKeys(const query::Plan* plan, SearchResult& results) const override;
@@ -115,7 +130,7 @@ class SegmentInternalInterface : public SegmentInterface {
     FillTargetEntry(const query::Plan* plan, SearchResult& results) const override;
 
     std::unique_ptr<proto::segcore::RetrieveResults>
-    Retrieve(const query::RetrievePlan* plan, Timestamp timestamp) const override;
+    Retrieve(const query::RetrievePlan* plan, Timestamp timestamp, QueryProfile* profile = nullptr) const override;
 
     virtual bool
     HasIndex(FieldId field_id) const = 0;
@@ -138,6 +153,11 @@ class SegmentInternalInterface : public SegmentInterface {
                   const BitsetView& bitset,
                   SearchResult& output) const = 0;
 
+    // copy the vectors of field_id at seg_offsets into output, from raw data or the vector index,
+    // return false if neither of them has the vectors
+    virtual bool
+    get_vectors(FieldId field_id, const int64_t* seg_offsets, int64_t count, void* output) const = 0;
+
     virtual void
     mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const = 0;
 
@@ -172,6 +192,24 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
     search_ids(const IdArray& id_array, Timestamp timestamp) const = 0;
 
+    // cache of filter results for queries at timestamp, nullptr if the segment can't reuse them
+    virtual PredicateCache*
+    get_predicate_cache(Timestamp timestamp) const {
+        return nullptr;
+    }
+
+    // the field as a dictionary encoded column, nullptr if its raw data is stored as it is
+    virtual const StringDictColumn*
+    get_string_dict(FieldId field_id) const {
+        return nullptr;
+    }
+
+    // the field as a packed INT64 column, nullptr if its raw data is stored as it is
+    virtual const PackedIntColumn*
+    get_packed_int(FieldId field_id) const {
+        return nullptr;
+    }
+
  protected:
     // internal API: return chunk_data in span
     virtual SpanBase
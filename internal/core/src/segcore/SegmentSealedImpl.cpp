@@ -11,9 +11,11 @@
 
 #include "SegmentSealedImpl.h"
 #include "common/Consts.h"
+#include "config/ConfigChunkManager.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnSealed.h"
 #include "query/ScalarIndex.h"
+#include "segcore/SegcoreConfig.h"
 #include "Utils.h"
 
 namespace milvus::segcore {
@@ -22,7 +24,7 @@ static inline void
 set_bit(BitsetType& bitset, FieldId field_id, bool flag = true) {
     auto pos = field_id.get() - START_USER_FIELDID;
     AssertInfo(pos >= 0, "invalid field id");
-    bitset[pos] = flag;
+    bitset.set(pos, flag);
 }
 
 static inline bool
@@ -111,30 +113,33 @@ SegmentSealedImpl::LoadScalarIndex(const index::LoadIndexInfo& info) {
     if (schema_->get_primary_field_id() == field_id) {
         AssertInfo(field_id.get() != -1, "Primary key is -1");
         AssertInfo(insert_record_.empty_pks(), "already exists");
+        std::vector<PkType> pks;
         switch (field_meta.get_data_type()) {
             case DataType::INT64: {
                 auto int64_index = dynamic_cast<index::ScalarIndex<int64_t>*>(scalar_indexings_[field_id].get());
-                for (int i = 0; i < row_count; ++i) {
-                    insert_record_.insert_pk(int64_index->Reverse_Lookup(i), i);
-                }
-                insert_record_.seal_pks();
+                std::vector<int64_t> values(row_count);
+                int64_index->ReverseLookupRange(0, row_count, values.data());
+                pks.assign(values.begin(), values.end());
                 break;
             }
             case DataType::VARCHAR: {
                 auto string_index = dynamic_cast<index::ScalarIndex<std::string>*>(scalar_indexings_[field_id].get());
-                for (int i = 0; i < row_count; ++i) {
-                    insert_record_.insert_pk(string_index->Reverse_Lookup(i), i);
-                }
-                insert_record_.seal_pks();
+                std::vector<std::string> values(row_count);
+                string_index->ReverseLookupRange(0, row_count, values.data());
+                pks.assign(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
                 break;
             }
             default: {
                 PanicInfo("unsupported primary key type");
             }
         }
+        insert_record_.insert_pks(pks, 0);
+        insert_record_.seal_pks();
+        apply_loaded_deletes();
     }
 
     set_bit(index_ready_bitset_, field_id, true);
+    predicate_cache_.Clear();
     update_row_count(row_count);
     lck.unlock();
 }
@@ -171,6 +176,7 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
             insert_record_.timestamps_.fill_chunk_data(timestamps, size);
             insert_record_.timestamp_index_ = std::move(index);
             AssertInfo(insert_record_.timestamps_.num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+            apply_loaded_deletes();
         } else {
             AssertInfo(system_field_type == SystemFieldType::RowId, "System field type of id column is not RowId");
             auto row_ids = reinterpret_cast<const idx_t*>(info.field_data->scalars().long_data().data().data());
@@ -188,17 +194,54 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         AssertInfo(data_type == DataType(info.field_data->type()),
                    "field type of load data is inconsistent with the schema");
 
+        // strings with few distinct values are dictionary encoded instead of stored as they are
+        std::unique_ptr<StringDictColumn> string_dict;
+        auto max_cardinality = std::min(SegcoreConfig::default_config().get_string_dict_max_cardinality(), size / 2);
+        if (data_type == DataType::VARCHAR && max_cardinality > 0) {
+            string_dict = StringDictColumn::Encode(info.field_data->scalars().string_data().data().begin(), size,
+                                                   max_cardinality);
+        }
+        // and integers in a narrow range or in long runs are packed
+        std::unique_ptr<PackedIntColumn> packed_int;
+        auto max_bit_width = SegcoreConfig::default_config().get_packed_int_max_bit_width();
+        if (data_type == DataType::INT64 && max_bit_width > 0) {
+            packed_int = PackedIntColumn::Encode(info.field_data->scalars().long_data().data().data(), size,
+                                                 max_bit_width);
+        }
+        // and the other columns are written to a local file and mapped when mmap is enabled
+        std::unique_ptr<MmapVector> mmap_column;
+        if (string_dict == nullptr && packed_int == nullptr && SegcoreConfig::default_config().get_mmap_enabled()) {
+            auto dir = ChunkMangerConfig::GetLocalRootPath() + "/" + MMAP_ROOT_PATH;
+            auto name = std::to_string(id_) + "_" + std::to_string(field_id.get());
+            // the pk is searched through the pk index and only read for outputs, as is a vector field whose
+            // index is loaded, the other columns are scanned by filters and brute force search
+            auto output_only = field_id == schema_->get_primary_field_id() ||
+                               (field_meta.is_vector() && vector_indexings_.is_ready(field_id));
+            auto access = output_only ? MmapVector::Access::Random : MmapVector::Access::Sequential;
+            mmap_column =
+                std::make_unique<MmapVector>(dir, name, field_meta, MAX_ROW_COUNT, size, info.field_data, access);
+        }
+
         // write data under lock
         std::unique_lock lck(mutex_);
 
         // Don't allow raw data and index exist at the same time
         AssertInfo(!get_bit(index_ready_bitset_, field_id), "field data can't be loaded when indexing exists");
         auto field_data = insert_record_.get_field_data_base(field_id);
-        AssertInfo(field_data->empty(), "already exists");
+        AssertInfo(field_data->empty() && string_dicts_.count(field_id) == 0 && packed_ints_.count(field_id) == 0,
+                   "already exists");
 
         // insert data to insertRecord
-        field_data->fill_chunk_data(size, info.field_data, field_meta);
-        AssertInfo(field_data->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+        if (string_dict != nullptr) {
+            string_dicts_[field_id] = std::move(string_dict);
+        } else if (packed_int != nullptr) {
+            packed_ints_[field_id] = std::move(packed_int);
+        } else if (mmap_column != nullptr) {
+            insert_record_.set_field_data(field_id, std::move(mmap_column));
+        } else {
+            field_data->fill_chunk_data(size, info.field_data, field_meta);
+            AssertInfo(field_data->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+        }
 
         // set pks to offset
         if (schema_->get_primary_field_id() == field_id) {
@@ -206,13 +249,13 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
             AssertInfo(insert_record_.empty_pks(), "already exists");
             std::vector<PkType> pks(size);
             ParsePksFromFieldData(pks, *info.field_data);
-            for (int i = 0; i < size; ++i) {
-                insert_record_.insert_pk(pks[i], i);
-            }
+            insert_record_.insert_pks(pks, 0);
             insert_record_.seal_pks();
+            apply_loaded_deletes();
         }
 
         set_bit(field_data_ready_bitset_, field_id, true);
+        predicate_cache_.Clear();
     }
     update_row_count(info.row_count);
 }
@@ -232,10 +275,31 @@ SegmentSealedImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     auto timestamps = reinterpret_cast<const Timestamp*>(info.timestamps);
 
     // step 2: fill pks and timestamps
+    std::shared_lock lck(mutex_);
     auto reserved_begin = deleted_record_.reserved.fetch_add(size);
     deleted_record_.pks_.set_data_raw(reserved_begin, pks.data(), size);
     deleted_record_.timestamps_.set_data_raw(reserved_begin, timestamps, size);
     deleted_record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
+
+    // step 3: mark the deleted rows, or leave it to apply_loaded_deletes if the rows are not loaded yet
+    if (deletes_applicable()) {
+        apply_deletes(deleted_record_, insert_record_, pks, timestamps);
+    }
+}
+
+void
+SegmentSealedImpl::apply_loaded_deletes() {
+    if (!deletes_applicable()) {
+        return;
+    }
+    auto del_count = deleted_record_.ack_responder_.GetAck();
+    std::vector<PkType> pks(del_count);
+    std::vector<Timestamp> timestamps(del_count);
+    for (int64_t i = 0; i < del_count; ++i) {
+        pks[i] = deleted_record_.pks_[i];
+        timestamps[i] = deleted_record_.timestamps_[i];
+    }
+    apply_deletes(deleted_record_, insert_record_, pks, timestamps.data());
 }
 
 // internal API: support scalar index only
@@ -251,6 +315,9 @@ SegmentSealedImpl::num_chunk_index(FieldId field_id) const {
 
 int64_t
 SegmentSealedImpl::num_chunk_data(FieldId field_id) const {
+    if (get_string_dict(field_id) != nullptr || get_packed_int(field_id) != nullptr) {
+        return 1;
+    }
     auto field_data = insert_record_.get_field_data_base(field_id);
     AssertInfo(field_data != nullptr, "null field data ptr");
     return field_data->num_chunk();
@@ -271,6 +338,10 @@ SegmentSealedImpl::chunk_data_impl(FieldId field_id, int64_t chunk_id) const {
     std::shared_lock lck(mutex_);
     AssertInfo(get_bit(field_data_ready_bitset_, field_id),
                "Can't get bitset element at " + std::to_string(field_id.get()));
+    AssertInfo(string_dicts_.count(field_id) == 0,
+               "field " + std::to_string(field_id.get()) + " is dictionary encoded, read it by get_string_dict");
+    AssertInfo(packed_ints_.count(field_id) == 0,
+               "field " + std::to_string(field_id.get()) + " is packed, read it by get_packed_int");
     auto& field_meta = schema_->operator[](field_id);
     auto element_sizeof = field_meta.get_sizeof();
     auto field_data = insert_record_.get_field_data_base(field_id);
@@ -278,6 +349,20 @@ SegmentSealedImpl::chunk_data_impl(FieldId field_id, int64_t chunk_id) const {
     return field_data->get_span_base(0);
 }
 
+const StringDictColumn*
+SegmentSealedImpl::get_string_dict(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto iter = string_dicts_.find(field_id);
+    return iter == string_dicts_.end() ? nullptr : iter->second.get();
+}
+
+const PackedIntColumn*
+SegmentSealedImpl::get_packed_int(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto iter = packed_ints_.find(field_id);
+    return iter == packed_ints_.end() ? nullptr : iter->second.get();
+}
+
 const index::IndexBase*
 SegmentSealedImpl::chunk_index_impl(FieldId field_id, int64_t chunk_id) const {
     AssertInfo(scalar_indexings_.find(field_id) != scalar_indexings_.end(),
@@ -291,7 +376,15 @@ SegmentSealedImpl::GetMemoryUsageInBytes() const {
     // TODO: add estimate for index
     std::shared_lock lck(mutex_);
     auto row_count = row_count_opt_.value_or(0);
-    return schema_->get_total_sizeof() * row_count;
+    auto size = schema_->get_total_sizeof() * row_count;
+    // dictionary encoded and packed columns take their own size instead of the estimate of their raw data
+    for (auto& [field_id, string_dict] : string_dicts_) {
+        size += string_dict->ByteSize() - schema_->operator[](field_id).get_sizeof() * row_count;
+    }
+    for (auto& [field_id, packed_int] : packed_ints_) {
+        size += packed_int->ByteSize() - schema_->operator[](field_id).get_sizeof() * row_count;
+    }
+    return size;
 }
 
 int64_t
@@ -313,17 +406,7 @@ SegmentSealedImpl::get_schema() const {
 
 void
 SegmentSealedImpl::mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const {
-    auto del_barrier = get_barrier(get_deleted_record(), timestamp);
-    if (del_barrier == 0) {
-        return;
-    }
-    auto bitmap_holder = get_deleted_bitmap(del_barrier, ins_barrier, deleted_record_, insert_record_, timestamp);
-    if (!bitmap_holder || !bitmap_holder->bitmap_ptr) {
-        return;
-    }
-    auto& delete_bitset = *bitmap_holder->bitmap_ptr;
-    AssertInfo(delete_bitset.size() == bitset.size(), "Deleted bitmap size not equal to filtered bitmap size");
-    bitset |= delete_bitset;
+    deleted_record_.mask_deleted(bitset, ins_barrier, timestamp);
 }
 
 void
@@ -352,6 +435,24 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
     }
 }
 
+bool
+SegmentSealedImpl::get_vectors(FieldId field_id, const int64_t* seg_offsets, int64_t count, void* output) const {
+    auto& field_meta = schema_->operator[](field_id);
+    AssertInfo(field_meta.is_vector(), "The meta type of vector field is not vector type");
+    if (HasIndex(field_id)) {
+        auto field_indexing = vector_indexings_.get_field_indexing(field_id);
+        auto vec_index = dynamic_cast<index::VectorIndex*>(field_indexing->indexing_.get());
+        AssertInfo(vec_index != nullptr, "indexing of vector field isn't vector index");
+        return vec_index->GetVectors(seg_offsets, count, output);
+    }
+    if (!HasFieldData(field_id)) {
+        return false;
+    }
+    auto field_data = insert_record_.get_field_data_base(field_id);
+    bulk_subscript_impl(field_meta.get_sizeof(), field_data->get_chunk_data(0), seg_offsets, count, output);
+    return true;
+}
+
 void
 SegmentSealedImpl::DropFieldData(const FieldId field_id) {
     if (SystemProperty::Instance().IsSystem(field_id)) {
@@ -370,6 +471,9 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
         std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_id, false);
         insert_record_.drop_field_data(field_id);
+        string_dicts_.erase(field_id);
+        packed_ints_.erase(field_id);
+        predicate_cache_.Clear();
         lck.unlock();
     }
 }
@@ -415,6 +519,7 @@ SegmentSealedImpl::SegmentSealedImpl(SchemaPtr schema, int64_t segment_id)
       field_data_ready_bitset_(schema->size()),
       index_ready_bitset_(schema->size()),
       scalar_indexings_(schema->size()),
+      predicate_cache_(SegcoreConfig::default_config().get_predicate_cache_memory_limit()),
       id_(segment_id) {
 }
 
@@ -434,8 +539,8 @@ template <typename T>
 void
 SegmentSealedImpl::bulk_subscript_impl(const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw) {
     static_assert(IsScalar<T>);
-    auto src = reinterpret_cast<const T*>(src_raw);
-    auto dst = reinterpret_cast<T*>(dst_raw);
+    auto src = reinterpret_cast<const ChunkViewType<T>*>(src_raw);
+    auto dst = reinterpret_cast<ChunkViewType<T>*>(dst_raw);
     for (int64_t i = 0; i < count; ++i) {
         auto offset = seg_offsets[i];
         if (offset != INVALID_SEG_OFFSET) {
@@ -492,8 +597,8 @@ SegmentSealedImpl::fill_with_empty(FieldId field_id, int64_t count) const {
             return CreateScalarDataArrayFrom(output.data(), count, field_meta);
         }
         case DataType::VARCHAR: {
-            FixedVector<std::string> output(count);
-            return CreateScalarDataArrayFrom(output.data(), count, field_meta);
+            FixedVector<std::string_view> output(count);
+            return CreateStringDataArrayFrom(output.data(), count, field_meta);
         }
 
         case DataType::VECTOR_FLOAT:
@@ -530,6 +635,26 @@ SegmentSealedImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets,
     }
 
     Assert(get_bit(field_data_ready_bitset_, field_id));
+    // the only place a dictionary encoded column is decoded
+    if (auto string_dict = get_string_dict(field_id)) {
+        FixedVector<std::string_view> output(count);
+        for (int64_t i = 0; i < count; ++i) {
+            if (seg_offsets[i] != INVALID_SEG_OFFSET) {
+                output[i] = string_dict->Decode(seg_offsets[i]);
+            }
+        }
+        return CreateStringDataArrayFrom(output.data(), count, field_meta);
+    }
+    if (auto packed_int = get_packed_int(field_id)) {
+        FixedVector<int64_t> output(count);
+        for (int64_t i = 0; i < count; ++i) {
+            if (seg_offsets[i] != INVALID_SEG_OFFSET) {
+                output[i] = packed_int->Get(seg_offsets[i]);
+            }
+        }
+        return CreateScalarDataArrayFrom(output.data(), count, field_meta);
+    }
+
     auto field_data = insert_record_.get_field_data_base(field_id);
     AssertInfo(field_data->num_chunk() == 1, std::string("num chunk not equal to 1 for sealed segment, num_chunk: ") +
                                                  std::to_string(field_data->num_chunk()));
@@ -571,9 +696,10 @@ SegmentSealedImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets,
             return CreateScalarDataArrayFrom(output.data(), count, field_meta);
         }
         case DataType::VARCHAR: {
-            FixedVector<std::string> output(count);
+            // views into the column, the strings are copied once, into the result
+            FixedVector<std::string_view> output(count);
             bulk_subscript_impl<std::string>(src_vec, seg_offsets, count, output.data());
-            return CreateScalarDataArrayFrom(output.data(), count, field_meta);
+            return CreateStringDataArrayFrom(output.data(), count, field_meta);
         }
 
         case DataType::VECTOR_FLOAT:
@@ -620,24 +746,24 @@ SegmentSealedImpl::search_ids(const IdArray& id_array, Timestamp timestamp) cons
 
     auto res_id_arr = std::make_unique<IdArray>();
     std::vector<SegOffset> res_offsets;
-    for (auto pk : pks) {
-        auto segOffsets = insert_record_.search_pk(pk, timestamp);
-        for (auto offset : segOffsets) {
-            switch (data_type) {
-                case DataType::INT64: {
-                    res_id_arr->mutable_int_id()->add_data(std::get<int64_t>(pk));
-                    break;
-                }
-                case DataType::VARCHAR: {
-                    res_id_arr->mutable_str_id()->add_data(std::get<std::string>(pk));
-                    break;
-                }
-                default: {
-                    PanicInfo("unsupported type");
-                }
+    auto hits = insert_record_.search_pks(pks, timestamp);
+    res_offsets.reserve(hits.size());
+    for (auto [i, offset] : hits) {
+        auto& pk = pks[i];
+        switch (data_type) {
+            case DataType::INT64: {
+                res_id_arr->mutable_int_id()->add_data(std::get<int64_t>(pk));
+                break;
+            }
+            case DataType::VARCHAR: {
+                res_id_arr->mutable_str_id()->add_data(std::get<std::string>(pk));
+                break;
+            }
+            default: {
+                PanicInfo("unsupported type");
             }
-            res_offsets.push_back(offset);
         }
+        res_offsets.push_back(offset);
     }
     return {std::move(res_id_arr), std::move(res_offsets)};
 }
@@ -664,9 +790,13 @@ SegmentSealedImpl::Delete(int64_t reserved_offset, int64_t size, const IdArray*
         sort_timestamps[i] = t;
         sort_pks[i] = pk;
     }
+    std::shared_lock lck(mutex_);
     deleted_record_.timestamps_.set_data_raw(reserved_offset, sort_timestamps.data(), size);
     deleted_record_.pks_.set_data_raw(reserved_offset, sort_pks.data(), size);
     deleted_record_.ack_responder_.AddSegment(reserved_offset, reserved_offset + size);
+    if (deletes_applicable()) {
+        apply_deletes(deleted_record_, insert_record_, sort_pks, sort_timestamps.data());
+    }
     return Status::OK();
 }
 
@@ -723,6 +853,21 @@ SegmentSealedImpl::get_active_count(Timestamp ts) const {
     return this->get_row_count();
 }
 
+PredicateCache*
+SegmentSealedImpl::get_predicate_cache(Timestamp timestamp) const {
+    if (!predicate_cache_.enabled() || !is_system_field_ready()) {
+        return nullptr;
+    }
+    // filters on pk only match rows inserted before the query timestamp,
+    // so results are shared only by queries which see the whole segment
+    auto row_count = get_row_count();
+    auto range = insert_record_.timestamp_index_.get_active_range(timestamp);
+    if (range.first != row_count || range.second != row_count) {
+        return nullptr;
+    }
+    return &predicate_cache_;
+}
+
 void
 SegmentSealedImpl::mask_with_timestamps(BitsetType& bitset_chunk, Timestamp timestamp) const {
     // TODO change the
@@ -23,9 +23,12 @@
 
 #include "ConcurrentVector.h"
 #include "DeletedRecord.h"
+#include "MmapVector.h"
+#include "PackedIntColumn.h"
 #include "ScalarIndex.h"
 #include "SealedIndexingRecord.h"
 #include "SegmentSealed.h"
+#include "StringDictColumn.h"
 #include "TimestampIndex.h"
 #include "index/ScalarIndex.h"
 
@@ -117,6 +120,15 @@ class SegmentSealedImpl : public SegmentSealed {
     int64_t
     get_active_count(Timestamp ts) const override;
 
+    PredicateCache*
+    get_predicate_cache(Timestamp timestamp) const override;
+
+    const StringDictColumn*
+    get_string_dict(FieldId field_id) const override;
+
+    const PackedIntColumn*
+    get_packed_int(FieldId field_id) const override;
+
  private:
     template <typename T>
     static void
@@ -129,6 +141,16 @@ class SegmentSealedImpl : public SegmentSealed {
     std::unique_ptr<DataArray>
     fill_with_empty(FieldId field_id, int64_t count) const;
 
+    // whether deletes can be applied to the rows, i.e. both the pks and the timestamps are loaded
+    bool
+    deletes_applicable() const {
+        return !insert_record_.empty_pks() && insert_record_.timestamps_.num_chunk() > 0;
+    }
+
+    // apply the whole delete log once the pks and the timestamps are loaded, with mutex_ held exclusively
+    void
+    apply_loaded_deletes();
+
     void
     update_row_count(int64_t row_count) {
         if (row_count_opt_.has_value()) {
@@ -149,6 +171,9 @@ class SegmentSealedImpl : public SegmentSealed {
                   const BitsetView& bitset,
                   SearchResult& output) const override;
 
+    bool
+    get_vectors(FieldId field_id, const int64_t* seg_offsets, int64_t count, void* output) const override;
+
     void
     mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const override;
 
@@ -194,10 +219,17 @@ class SegmentSealedImpl : public SegmentSealed {
 
     // inserted fields data and row_ids, timestamps
     InsertRecord<true> insert_record_;
+    // VARCHAR fields loaded dictionary encoded, their field data in insert_record_ stays empty
+    std::unordered_map<FieldId, std::unique_ptr<StringDictColumn>> string_dicts_;
+    // INT64 fields loaded packed, likewise
+    std::unordered_map<FieldId, std::unique_ptr<PackedIntColumn>> packed_ints_;
 
     // deleted pks
     mutable DeletedRecord deleted_record_;
 
+    // filter results, invalidated whenever scalar data is loaded or dropped
+    mutable PredicateCache predicate_cache_;
+
     SchemaPtr schema_;
     int64_t id_;
 };
@@ -0,0 +1,72 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/SmallIndexExecutor.h"
+
+#include <algorithm>
+
+#include "segcore/SegcoreConfig.h"
+
+namespace milvus::segcore {
+
+SmallIndexExecutor&
+SmallIndexExecutor::GetInstance() {
+    auto& config = SegcoreConfig::default_config();
+    static SmallIndexExecutor executor(config.get_small_index_build_threads(),
+                                       config.get_small_index_build_queue_size());
+    return executor;
+}
+
+SmallIndexExecutor::SmallIndexExecutor(int64_t num_threads, int64_t queue_capacity)
+    : queue_capacity_(std::max<int64_t>(queue_capacity, 1)) {
+    num_threads = std::max<int64_t>(num_threads, 1);
+    for (int64_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back([this] { Run(); });
+    }
+}
+
+SmallIndexExecutor::~SmallIndexExecutor() {
+    {
+        std::lock_guard lck(mutex_);
+        stopped_ = true;
+    }
+    not_empty_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void
+SmallIndexExecutor::Submit(std::function<void()> build) {
+    std::unique_lock lck(mutex_);
+    not_full_.wait(lck, [this] { return queue_.size() < queue_capacity_; });
+    queue_.push_back(std::move(build));
+    lck.unlock();
+    not_empty_.notify_one();
+}
+
+void
+SmallIndexExecutor::Run() {
+    while (true) {
+        std::unique_lock lck(mutex_);
+        not_empty_.wait(lck, [this] { return stopped_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;
+        }
+        auto build = std::move(queue_.front());
+        queue_.pop_front();
+        lck.unlock();
+        not_full_.notify_one();
+        build();
+    }
+}
+
+}  // namespace milvus::segcore
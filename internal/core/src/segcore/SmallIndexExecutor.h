@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace milvus::segcore {
+
+// Runs the small index builds of growing segments off the insert path, see IndexingRecord::UpdateResourceAck.
+// A fixed set of threads takes builds from a bounded queue, and Submit blocks while the queue is full, so that
+// inserts outrunning the builds are slowed down instead of piling up chunks waiting for their index.
+class SmallIndexExecutor {
+ public:
+    // shared by all growing segments, sized by SegcoreConfig::default_config() when first used
+    static SmallIndexExecutor&
+    GetInstance();
+
+    SmallIndexExecutor(int64_t num_threads, int64_t queue_capacity);
+
+    SmallIndexExecutor(const SmallIndexExecutor&) = delete;
+    SmallIndexExecutor&
+    operator=(const SmallIndexExecutor&) = delete;
+
+    // runs the queued builds, then joins the threads
+    ~SmallIndexExecutor();
+
+    void
+    Submit(std::function<void()> build);
+
+ private:
+    void
+    Run();
+
+ private:
+    const size_t queue_capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::function<void()>> queue_;
+    bool stopped_ = false;
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace milvus::segcore
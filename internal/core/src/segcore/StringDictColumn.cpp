@@ -0,0 +1,140 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/StringDictColumn.h"
+
+#include "common/StringMatch.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+// set bit i of the result when the code of row i passes pred, a word of the bitset at a time
+template <typename Code, typename Pred>
+BitsetType
+RowsOf(const std::vector<Code>& codes, int64_t row_count, Pred pred) {
+    AssertInfo(row_count <= int64_t(codes.size()), "row count is bigger than the dictionary encoded column");
+    size_t n = row_count;
+    BitsetType result(n);
+    auto blocks = result.blocks();
+    for (size_t begin = 0; begin < n; begin += BitsetType::bits_per_block) {
+        auto end = std::min(n, begin + BitsetType::bits_per_block);
+        BitsetType::block_type block = 0;
+        for (auto i = begin; i < end; ++i) {
+            block |= BitsetType::block_type(pred(codes[i])) << (i - begin);
+        }
+        blocks[begin / BitsetType::bits_per_block] = block;
+    }
+    return result;
+}
+}  // namespace
+
+uint32_t
+StringDictColumn::LowerCode(std::string_view value) const {
+    return std::lower_bound(dict_.begin(), dict_.end(), value,
+                            [](const std::string& a, std::string_view b) { return a < b; }) -
+           dict_.begin();
+}
+
+uint32_t
+StringDictColumn::UpperCode(std::string_view value) const {
+    return std::upper_bound(dict_.begin(), dict_.end(), value,
+                            [](std::string_view a, const std::string& b) { return a < b; }) -
+           dict_.begin();
+}
+
+BitsetType
+StringDictColumn::RowsInRange(int64_t row_count, uint32_t begin, uint32_t end) const {
+    if (begin >= end) {
+        return BitsetType(row_count);
+    }
+    // one unsigned compare per row: code - begin wraps around for the codes below begin
+    auto width = end - begin;
+    auto in_range = [begin, width](uint32_t code) { return code - begin < width; };
+    return codes32_.empty() ? RowsOf(codes16_, row_count, in_range) : RowsOf(codes32_, row_count, in_range);
+}
+
+BitsetType
+StringDictColumn::RowsWithCodes(int64_t row_count, const std::vector<uint8_t>& flags) const {
+    auto flagged = [&flags](uint32_t code) { return flags[code] != 0; };
+    return codes32_.empty() ? RowsOf(codes16_, row_count, flagged) : RowsOf(codes32_, row_count, flagged);
+}
+
+BitsetType
+StringDictColumn::Range(int64_t row_count, OpType op, std::string_view value) const {
+    uint32_t num_codes = dict_.size();
+    switch (op) {
+        case OpType::Equal: {
+            return RowsInRange(row_count, LowerCode(value), UpperCode(value));
+        }
+        case OpType::NotEqual: {
+            auto result = RowsInRange(row_count, LowerCode(value), UpperCode(value));
+            result.flip();
+            return result;
+        }
+        case OpType::GreaterThan: {
+            return RowsInRange(row_count, UpperCode(value), num_codes);
+        }
+        case OpType::GreaterEqual: {
+            return RowsInRange(row_count, LowerCode(value), num_codes);
+        }
+        case OpType::LessThan: {
+            return RowsInRange(row_count, 0, LowerCode(value));
+        }
+        case OpType::LessEqual: {
+            return RowsInRange(row_count, 0, UpperCode(value));
+        }
+        case OpType::PrefixMatch: {
+            // the values sharing a prefix are adjacent in the dictionary
+            auto begin = LowerCode(value);
+            auto has_prefix = [value](const std::string& str) { return milvus::PrefixMatch(str, value); };
+            uint32_t end = std::partition_point(dict_.begin() + begin, dict_.end(), has_prefix) - dict_.begin();
+            return RowsInRange(row_count, begin, end);
+        }
+        default: {
+            PanicInfo("unsupported op on dictionary encoded column: " + std::to_string(op));
+        }
+    }
+}
+
+BitsetType
+StringDictColumn::Range(int64_t row_count,
+                        std::string_view lower,
+                        bool lower_inclusive,
+                        std::string_view upper,
+                        bool upper_inclusive) const {
+    auto begin = lower_inclusive ? LowerCode(lower) : UpperCode(lower);
+    auto end = upper_inclusive ? UpperCode(upper) : LowerCode(upper);
+    return RowsInRange(row_count, begin, end);
+}
+
+BitsetType
+StringDictColumn::In(int64_t row_count, size_t n, const std::string* values) const {
+    std::vector<uint8_t> flags(dict_.size());
+    for (size_t i = 0; i < n; ++i) {
+        auto code = LowerCode(values[i]);
+        if (code < dict_.size() && dict_[code] == values[i]) {
+            flags[code] = 1;
+        }
+    }
+    return RowsWithCodes(row_count, flags);
+}
+
+int64_t
+StringDictColumn::ByteSize() const {
+    int64_t size = codes16_.size() * sizeof(uint16_t) + codes32_.size() * sizeof(uint32_t);
+    for (auto& value : dict_) {
+        size += sizeof(std::string) + value.size();
+    }
+    return size;
+}
+
+}  // namespace milvus::segcore
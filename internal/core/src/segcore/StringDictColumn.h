@@ -0,0 +1,158 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// Dictionary encoded VARCHAR column of a sealed segment: the distinct values in ascending order, and per row the
+// code of its value, i.e. the position of the value in the dictionary. Codes are ordered like the values, so
+// equality, range and prefix predicates select a range of codes, and the strings are only decoded for output.
+// Codes are 16-bit when the dictionary has at most 64K values, 32-bit otherwise
+class StringDictColumn {
+ public:
+    // encode values[0, n), or return nullptr if they have more than max_cardinality distinct values.
+    // values is a random access iterator of anything convertible to std::string_view
+    template <typename Iterator>
+    static std::unique_ptr<StringDictColumn>
+    Encode(Iterator values, int64_t n, int64_t max_cardinality);
+
+    int64_t
+    row_count() const {
+        return row_count_;
+    }
+
+    int64_t
+    cardinality() const {
+        return dict_.size();
+    }
+
+    uint32_t
+    code(int64_t row) const {
+        return codes32_.empty() ? codes16_[row] : codes32_[row];
+    }
+
+    std::string_view
+    Decode(int64_t row) const {
+        return dict_[code(row)];
+    }
+
+    // The predicates below return a bitset of the rows [0, row_count), as a filter may only see the rows
+    // inserted before its timestamp
+
+    // rows compared to value by op, one of Equal, NotEqual, GreaterThan, GreaterEqual, LessThan, LessEqual
+    // or PrefixMatch
+    BitsetType
+    Range(int64_t row_count, OpType op, std::string_view value) const;
+
+    BitsetType
+    Range(int64_t row_count,
+          std::string_view lower,
+          bool lower_inclusive,
+          std::string_view upper,
+          bool upper_inclusive) const;
+
+    // rows whose value is one of values[0, n)
+    BitsetType
+    In(int64_t row_count, size_t n, const std::string* values) const;
+
+    // rows whose value passes pred, which is called once per distinct value
+    template <typename Pred>
+    BitsetType
+    Match(int64_t row_count, Pred pred) const {
+        std::vector<uint8_t> flags(dict_.size());
+        for (size_t code = 0; code < dict_.size(); ++code) {
+            flags[code] = pred(std::string_view(dict_[code]));
+        }
+        return RowsWithCodes(row_count, flags);
+    }
+
+    int64_t
+    ByteSize() const;
+
+ private:
+    StringDictColumn() = default;
+
+    // first code whose value is not less than value
+    uint32_t
+    LowerCode(std::string_view value) const;
+
+    // first code whose value is greater than value
+    uint32_t
+    UpperCode(std::string_view value) const;
+
+    // rows whose code is in [begin, end)
+    BitsetType
+    RowsInRange(int64_t row_count, uint32_t begin, uint32_t end) const;
+
+    // rows whose code is flagged
+    BitsetType
+    RowsWithCodes(int64_t row_count, const std::vector<uint8_t>& flags) const;
+
+ private:
+    int64_t row_count_ = 0;
+    std::vector<std::string> dict_;
+    std::vector<uint16_t> codes16_;
+    std::vector<uint32_t> codes32_;
+};
+
+template <typename Iterator>
+std::unique_ptr<StringDictColumn>
+StringDictColumn::Encode(Iterator values, int64_t n, int64_t max_cardinality) {
+    // number the values in the order they show up, giving up as soon as there are too many of them
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::vector<uint32_t> row_ids(n);
+    for (int64_t i = 0; i < n; ++i) {
+        auto [iter, inserted] = ids.try_emplace(std::string_view(values[i]), uint32_t(ids.size()));
+        if (inserted && int64_t(ids.size()) > max_cardinality) {
+            return nullptr;
+        }
+        row_ids[i] = iter->second;
+    }
+
+    // then renumber them in ascending order
+    std::vector<std::pair<std::string_view, uint32_t>> sorted(ids.begin(), ids.end());
+    std::sort(sorted.begin(), sorted.end());
+    std::unique_ptr<StringDictColumn> column(new StringDictColumn());
+    std::vector<uint32_t> codes(sorted.size());
+    column->dict_.reserve(sorted.size());
+    for (uint32_t code = 0; code < sorted.size(); ++code) {
+        column->dict_.emplace_back(sorted[code].first);
+        codes[sorted[code].second] = code;
+    }
+    column->row_count_ = n;
+    if (sorted.size() <= size_t(std::numeric_limits<uint16_t>::max()) + 1) {
+        column->codes16_.resize(n);
+        for (int64_t i = 0; i < n; ++i) {
+            column->codes16_[i] = codes[row_ids[i]];
+        }
+    } else {
+        column->codes32_.resize(n);
+        for (int64_t i = 0; i < n; ++i) {
+            column->codes32_[i] = codes[row_ids[i]];
+        }
+    }
+    return column;
+}
+
+}  // namespace milvus::segcore
@@ -70,12 +70,11 @@ TimestampIndex::GenerateBitset(Timestamp query_timestamp,
                                int64_t size) {
     auto [beg, end] = active_range;
     Assert(beg < end);
-    BitsetType bitset;
-    bitset.reserve(size);
-    bitset.resize(beg, false);
-    bitset.resize(size, true);
+    BitsetType bitset(size);
+    // rows after the active range are all newer than query_timestamp
+    bitset.set(end, size - end, true);
     for (int64_t i = beg; i < end; ++i) {
-        bitset[i] = timestamps[i] > query_timestamp;
+        bitset.set(i, timestamps[i] > query_timestamp);
     }
     return bitset;
 }
@@ -11,7 +11,6 @@
 
 #pragma once
 
-#include <boost/dynamic_bitset.hpp>
 #include <vector>
 #include <utility>
 
@@ -165,6 +165,21 @@ CreateVectorDataArrayFrom(const void* data_raw, int64_t count, const FieldMeta&
     return data_array;
 }
 
+std::unique_ptr<DataArray>
+CreateStringDataArrayFrom(const std::string_view* data, int64_t count, const FieldMeta& field_meta) {
+    AssertInfo(field_meta.get_data_type() == DataType::VARCHAR, "field is not VARCHAR");
+    auto data_array = std::make_unique<DataArray>();
+    data_array->set_field_id(field_meta.get_id().get());
+    data_array->set_type(milvus::proto::schema::DataType(field_meta.get_data_type()));
+
+    auto obj = data_array->mutable_scalars()->mutable_string_data()->mutable_data();
+    obj->Reserve(count);
+    for (int64_t i = 0; i < count; i++) {
+        obj->Add()->assign(data[i].data(), data[i].size());
+    }
+    return data_array;
+}
+
 std::unique_ptr<DataArray>
 CreateDataArrayFrom(const void* data_raw, int64_t count, const FieldMeta& field_meta) {
     auto data_type = field_meta.get_data_type();
@@ -273,21 +288,17 @@ ReverseDataFromIndex(const index::IndexBase* index,
         case DataType::BOOL: {
             using IndexType = index::ScalarIndex<bool>;
             auto ptr = dynamic_cast<const IndexType*>(index);
-            std::vector<bool> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            auto raw_data = std::make_unique<bool[]>(count);
+            ptr->ReverseLookup(seg_offsets, count, raw_data.get());
             auto obj = scalar_array->mutable_bool_data();
-            *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
+            *(obj->mutable_data()) = {raw_data.get(), raw_data.get() + count};
             break;
         }
         case DataType::INT8: {
             using IndexType = index::ScalarIndex<int8_t>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<int8_t> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_int_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -296,9 +307,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<int16_t>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<int16_t> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_int_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -307,9 +316,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<int32_t>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<int32_t> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_int_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -318,9 +325,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<int64_t>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<int64_t> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_long_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -329,9 +334,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<float>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<float> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_float_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -340,9 +343,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<double>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<double> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_double_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -351,9 +352,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<std::string>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<std::string> raw_data(count);
-            for (int64_t i = 0; i < count; ++i) {
-                raw_data[i] = ptr->Reverse_Lookup(seg_offsets[i]);
-            }
+            ptr->ReverseLookup(seg_offsets, count, raw_data.data());
             auto obj = scalar_array->mutable_string_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
             break;
@@ -148,7 +148,7 @@ appendScalarIndex(CLoadIndexInfo c_load_index_info, CBinarySet c_binary_set) {
 
         milvus::index::CreateIndexInfo index_info;
         index_info.field_type = milvus::DataType(field_type);
-        index_info.index_type = index_params["index_type"];
+        index_info.index_type = milvus::index::GetScalarIndexType(*binary_set, index_params["index_type"]);
         // set default index mode
         index_info.index_mode = milvus::IndexMode::MODE_CPU;
         if (index_params.count("index_mode")) {
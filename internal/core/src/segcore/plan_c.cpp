@@ -49,7 +49,7 @@ CreateSearchPlanByExpr(CCollection c_col, const void* serialized_expr_plan, cons
     auto col = (milvus::segcore::Collection*)c_col;
 
     try {
-        auto res = milvus::query::CreateSearchPlanByExpr(*col->get_schema(), serialized_expr_plan, size);
+        auto res = col->get_plan_cache().GetOrCreateSearchPlan(*col->get_schema(), serialized_expr_plan, size);
 
         auto status = CStatus();
         status.error_code = Success;
@@ -147,7 +147,7 @@ CreateRetrievePlanByExpr(CCollection c_col,
     auto col = (milvus::segcore::Collection*)c_col;
 
     try {
-        auto res = milvus::query::CreateRetrievePlanByExpr(*col->get_schema(), serialized_expr_plan, size);
+        auto res = col->get_plan_cache().GetOrCreateRetrievePlan(*col->get_schema(), serialized_expr_plan, size);
 
         auto status = CStatus();
         status.error_code = Success;
@@ -175,3 +175,19 @@ DeleteRetrievePlan(CRetrievePlan c_plan) {
     auto plan = (milvus::query::RetrievePlan*)c_plan;
     delete plan;
 }
+
+CStatus
+GetPlanCacheStats(CCollection c_col, CPlanCacheStats* stats) {
+    try {
+        auto col = (milvus::segcore::Collection*)c_col;
+        auto res = col->get_plan_cache().get_stats();
+        stats->hit_count = res.hit_count;
+        stats->miss_count = res.miss_count;
+        stats->evict_count = res.evict_count;
+        stats->entry_count = res.entry_count;
+        stats->memory_bytes = res.memory_bytes;
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
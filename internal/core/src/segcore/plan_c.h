@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#pragma once
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -23,6 +25,14 @@ typedef void* CSearchPlan;
 typedef void* CPlaceholderGroup;
 typedef void* CRetrievePlan;
 
+typedef struct CPlanCacheStats {
+    int64_t hit_count;
+    int64_t miss_count;
+    int64_t evict_count;
+    int64_t entry_count;
+    int64_t memory_bytes;
+} CPlanCacheStats;
+
 CStatus
 CreateSearchPlan(CCollection col, const char* dsl, CSearchPlan* res_plan);
 
@@ -63,6 +73,10 @@ CreateRetrievePlanByExpr(CCollection c_col,
 void
 DeleteRetrievePlan(CRetrievePlan plan);
 
+// plans created by CreateSearchPlanByExpr/CreateRetrievePlanByExpr are cached per collection
+CStatus
+GetPlanCacheStats(CCollection c_col, CPlanCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
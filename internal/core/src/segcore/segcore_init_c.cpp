@@ -56,4 +56,95 @@ SegcoreSetIndexSliceSize(const int64_t value) {
     LOG_SEGCORE_DEBUG_ << "set config index slice size: " << value;
 }
 
+extern "C" void
+SegcoreSetPlanCacheCapacity(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_plan_cache_capacity(value);
+    LOG_SEGCORE_DEBUG_ << "set config plan cache capacity: " << value;
+}
+
+extern "C" void
+SegcoreSetPlanCacheMemoryLimit(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_plan_cache_memory_limit(value);
+    LOG_SEGCORE_DEBUG_ << "set config plan cache memory limit: " << value;
+}
+
+extern "C" void
+SegcoreSetPredicateCacheMemoryLimit(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_predicate_cache_memory_limit(value);
+    LOG_SEGCORE_DEBUG_ << "set config predicate cache memory limit: " << value;
+}
+
+extern "C" void
+SegcoreSetLazyPredicateEnabled(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_lazy_predicate_enabled(value);
+    LOG_SEGCORE_DEBUG_ << "set config lazy predicate enabled: " << value;
+}
+
+extern "C" void
+SegcoreSetExactSearchThreshold(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_exact_search_threshold(value);
+    LOG_SEGCORE_DEBUG_ << "set config exact search threshold: " << value;
+}
+
+extern "C" void
+SegcoreSetSmallIndexAsync(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_small_index_async(value);
+    LOG_SEGCORE_DEBUG_ << "set config small index async: " << value;
+}
+
+extern "C" void
+SegcoreSetSmallIndexBuildThreads(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_small_index_build_threads(value);
+    LOG_SEGCORE_DEBUG_ << "set config small index build threads: " << value;
+}
+
+extern "C" void
+SegcoreSetSmallIndexBuildQueueSize(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_small_index_build_queue_size(value);
+    LOG_SEGCORE_DEBUG_ << "set config small index build queue size: " << value;
+}
+
+extern "C" void
+SegcoreSetVectorSmallIndexEnabled(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_vector_small_index_enabled(value);
+    LOG_SEGCORE_DEBUG_ << "set config vector small index enabled: " << value;
+}
+
+extern "C" void
+SegcoreSetScalarSmallIndexEnabled(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_scalar_small_index_enabled(value);
+    LOG_SEGCORE_DEBUG_ << "set config scalar small index enabled: " << value;
+}
+
+extern "C" void
+SegcoreSetStringDictMaxCardinality(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_string_dict_max_cardinality(value);
+    LOG_SEGCORE_DEBUG_ << "set config string dict max cardinality: " << value;
+}
+
+extern "C" void
+SegcoreSetPackedIntMaxBitWidth(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_packed_int_max_bit_width(value);
+    LOG_SEGCORE_DEBUG_ << "set config packed int max bit width: " << value;
+}
+
+extern "C" void
+SegcoreSetMmapEnabled(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_mmap_enabled(value);
+    LOG_SEGCORE_DEBUG_ << "set config mmap enabled: " << value;
+}
+
 }  // namespace milvus::segcore
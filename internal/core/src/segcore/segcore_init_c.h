@@ -15,6 +15,8 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
 void
 SegcoreInit(const char*);
 
@@ -34,6 +36,46 @@ SegcoreSetSimdType(const char*);
 void
 SegcoreSetIndexSliceSize(const int64_t);
 
+// the plan cache config is read when a collection is created, the existing collections keep theirs
+void
+SegcoreSetPlanCacheCapacity(const int64_t);
+
+void
+SegcoreSetPlanCacheMemoryLimit(const int64_t);
+
+void
+SegcoreSetPredicateCacheMemoryLimit(const int64_t);
+
+void
+SegcoreSetLazyPredicateEnabled(const bool);
+
+void
+SegcoreSetExactSearchThreshold(const int64_t);
+
+void
+SegcoreSetSmallIndexAsync(const bool);
+
+void
+SegcoreSetSmallIndexBuildThreads(const int64_t);
+
+void
+SegcoreSetSmallIndexBuildQueueSize(const int64_t);
+
+void
+SegcoreSetVectorSmallIndexEnabled(const bool);
+
+void
+SegcoreSetScalarSmallIndexEnabled(const bool);
+
+void
+SegcoreSetStringDictMaxCardinality(const int64_t);
+
+void
+SegcoreSetPackedIntMaxBitWidth(const int64_t);
+
+void
+SegcoreSetMmapEnabled(const bool);
+
 #ifdef __cplusplus
 }
 #endif
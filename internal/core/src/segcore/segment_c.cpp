@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <cstring>
+
 #include "common/CGoHelper.h"
 #include "common/LoadInfo.h"
 #include "common/Types.h"
@@ -60,17 +62,18 @@ DeleteSearchResult(CSearchResult search_result) {
     delete res;
 }
 
-CStatus
-Search(CSegmentInterface c_segment,
-       CSearchPlan c_plan,
-       CPlaceholderGroup c_placeholder_group,
-       uint64_t timestamp,
-       CSearchResult* result) {
+static CStatus
+SearchImpl(CSegmentInterface c_segment,
+           CSearchPlan c_plan,
+           CPlaceholderGroup c_placeholder_group,
+           uint64_t timestamp,
+           CSearchResult* result,
+           bool with_profile) {
     try {
         auto segment = (milvus::segcore::SegmentInterface*)c_segment;
         auto plan = (milvus::query::Plan*)c_plan;
         auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(c_placeholder_group);
-        auto search_result = segment->Search(plan, phg_ptr, timestamp);
+        auto search_result = segment->Search(plan, phg_ptr, timestamp, with_profile);
         if (!milvus::PositivelyRelated(plan->plan_node_->search_info_.metric_type_)) {
             for (auto& dis : search_result->distances_) {
                 dis *= -1;
@@ -83,17 +86,51 @@ Search(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+Search(CSegmentInterface c_segment,
+       CSearchPlan c_plan,
+       CPlaceholderGroup c_placeholder_group,
+       uint64_t timestamp,
+       CSearchResult* result) {
+    return SearchImpl(c_segment, c_plan, c_placeholder_group, timestamp, result, false);
+}
+
+CStatus
+SearchWithProfile(CSegmentInterface c_segment,
+                  CSearchPlan c_plan,
+                  CPlaceholderGroup c_placeholder_group,
+                  uint64_t timestamp,
+                  CSearchResult* result) {
+    return SearchImpl(c_segment, c_plan, c_placeholder_group, timestamp, result, true);
+}
+
+CStatus
+GetSearchResultProfile(CSearchResult search_result, char** profile) {
+    try {
+        auto res = (milvus::SearchResult*)search_result;
+        AssertInfo(res->profile_ != nullptr, "search result has no profile, use SearchWithProfile");
+        *profile = strdup(res->profile_->ToJson().c_str());
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result) {
     std::free((void*)(retrieve_result->proto_blob));
 }
 
-CStatus
-Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, CRetrieveResult* result) {
+static CStatus
+RetrieveImpl(CSegmentInterface c_segment,
+             CRetrievePlan c_plan,
+             uint64_t timestamp,
+             CRetrieveResult* result,
+             milvus::QueryProfile* profile) {
     try {
         auto segment = (const milvus::segcore::SegmentInterface*)c_segment;
         auto plan = (const milvus::query::RetrievePlan*)c_plan;
-        auto retrieve_result = segment->Retrieve(plan, timestamp);
+        auto retrieve_result = segment->Retrieve(plan, timestamp, profile);
 
         auto size = retrieve_result->ByteSize();
         void* buffer = malloc(size);
@@ -107,6 +144,25 @@ Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp,
     }
 }
 
+CStatus
+Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, CRetrieveResult* result) {
+    return RetrieveImpl(c_segment, c_plan, timestamp, result, nullptr);
+}
+
+CStatus
+RetrieveWithProfile(CSegmentInterface c_segment,
+                    CRetrievePlan c_plan,
+                    uint64_t timestamp,
+                    CRetrieveResult* result,
+                    char** profile) {
+    milvus::QueryProfile query_profile;
+    auto status = RetrieveImpl(c_segment, c_plan, timestamp, result, &query_profile);
+    if (status.error_code == Success) {
+        *profile = strdup(query_profile.ToJson().c_str());
+    }
+    return status;
+}
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment) {
     auto segment = (milvus::segcore::SegmentInterface*)c_segment;
@@ -44,12 +44,33 @@ Search(CSegmentInterface c_segment,
        uint64_t timestamp,
        CSearchResult* result);
 
+// same as Search, but also collect the execution profile of the search, see GetSearchResultProfile
+CStatus
+SearchWithProfile(CSegmentInterface c_segment,
+                  CSearchPlan c_plan,
+                  CPlaceholderGroup c_placeholder_group,
+                  uint64_t timestamp,
+                  CSearchResult* result);
+
+// execution profile of a result of SearchWithProfile as json, including the fill phases run by reduce.
+// *profile must be freed by the caller
+CStatus
+GetSearchResultProfile(CSearchResult search_result, char** profile);
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result);
 
 CStatus
 Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, CRetrieveResult* result);
 
+// same as Retrieve, and return the execution profile as json in *profile, which must be freed by the caller
+CStatus
+RetrieveWithProfile(CSegmentInterface c_segment,
+                    CRetrievePlan c_plan,
+                    uint64_t timestamp,
+                    CRetrieveResult* result,
+                    char** profile);
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment);
 
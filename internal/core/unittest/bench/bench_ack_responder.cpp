@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+
+#include "segcore/AckResponder.h"
+
+using namespace milvus::segcore;
+
+static AckResponder* ack_responder = nullptr;
+static std::atomic<int64_t> reserved = 0;
+
+// inserters reserving batches of state.range(0) rows and acknowledging them, as concurrent Insert calls on one
+// growing segment do, with a GetAck per batch as num_chunk() and the small index updates do
+static void
+Segcore_AckResponder_AddSegment(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        ack_responder = new AckResponder();
+        reserved = 0;
+    }
+    auto batch = state.range(0);
+    for (auto _ : state) {
+        auto begin = reserved.fetch_add(batch);
+        ack_responder->AddSegment(begin, begin + batch);
+        benchmark::DoNotOptimize(ack_responder->GetAck());
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index == 0) {
+        delete ack_responder;
+        ack_responder = nullptr;
+    }
+}
+BENCHMARK(Segcore_AckResponder_AddSegment)->Arg(1)->Arg(1000)->ThreadRange(1, 32)->UseRealTime();
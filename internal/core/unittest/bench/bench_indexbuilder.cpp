@@ -19,6 +19,8 @@
 #include "pb/index_cgo_msg.pb.h"
 #include "indexbuilder/VecIndexCreator.h"
 #include "indexbuilder/index_c.h"
+#include "index/ScalarIndexSort.h"
+#include "index/StringIndexMarisa.h"
 #include "test_utils/indexbuilder_test_utils.h"
 #include "common/Consts.h"
 
@@ -105,3 +107,38 @@ BENCHMARK(IndexBuilder_build)->Args({0, 0, false});
 
 // IVF_FLAT, L2, VectorFloat
 BENCHMARK(IndexBuilder_build_and_codec)->Args({0, 0, false});
+
+static void
+IndexBuilder_build_scalar_sort(benchmark::State& state) {
+    auto n = state.range(0);
+    std::vector<int64_t> data(n);
+    for (auto& x : data) {
+        x = std::rand();
+    }
+
+    for (auto _ : state) {
+        auto index = milvus::index::CreateScalarIndexSort<int64_t>();
+        index->Build(n, data.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void
+IndexBuilder_build_marisa(benchmark::State& state) {
+    auto n = state.range(0);
+    // about n / 8 distinct strings, like a field of names or tags
+    std::vector<std::string> data(n);
+    for (auto& x : data) {
+        x = "key_" + std::to_string(std::rand() % (n / 8));
+    }
+
+    for (auto _ : state) {
+        auto index = milvus::index::CreateStringIndexMarisa();
+        index->Build(n, data.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// rows, reported as rows per second
+BENCHMARK(IndexBuilder_build_scalar_sort)->Arg(NB)->Arg(10 * NB)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(IndexBuilder_build_marisa)->Arg(NB)->Arg(10 * NB)->Unit(benchmark::kMillisecond)->UseRealTime();
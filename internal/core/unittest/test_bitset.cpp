@@ -0,0 +1,228 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/RoaringBitmap.h"
+#include "common/Types.h"
+
+using namespace milvus;
+
+namespace {
+std::vector<bool>
+GenRandomBits(int64_t n, double ratio, int seed) {
+    std::default_random_engine er(seed);
+    std::bernoulli_distribution distribution(ratio);
+    std::vector<bool> res(n);
+    for (int64_t i = 0; i < n; ++i) {
+        res[i] = distribution(er);
+    }
+    return res;
+}
+
+BitsetType
+ToBitset(const std::vector<bool>& bits) {
+    BitsetType res(bits.size());
+    for (size_t i = 0; i < bits.size(); ++i) {
+        res.set(i, bits[i]);
+    }
+    return res;
+}
+
+void
+AssertBitsEqual(const BitsetType& bitset, const std::vector<bool>& bits) {
+    ASSERT_EQ(bitset.size(), bits.size());
+    size_t count = 0;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        ASSERT_EQ(bitset[i], bits[i]) << i;
+        count += bits[i];
+    }
+    ASSERT_EQ(bitset.count(), count);
+}
+}  // namespace
+
+TEST(Bitset, Basic) {
+    // sizes around word and vector register boundaries
+    for (int64_t n : {0, 1, 63, 64, 65, 511, 512, 513, 10007}) {
+        auto bits = GenRandomBits(n, 0.3, n);
+        auto bitset = ToBitset(bits);
+        AssertBitsEqual(bitset, bits);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(bitset.data()) % BitsetType::alignment, 0);
+
+        bitset.flip();
+        for (auto&& bit : bits) {
+            bit = !bit;
+        }
+        AssertBitsEqual(bitset, bits);
+
+        bitset.set();
+        ASSERT_EQ(bitset.count(), n);
+        ASSERT_EQ(bitset.all(), true);
+        bitset.reset();
+        ASSERT_EQ(bitset.none(), true);
+    }
+}
+
+TEST(Bitset, Resize) {
+    BitsetType bitset(70, true);
+    ASSERT_EQ(bitset.count(), 70);
+    bitset.resize(10);
+    ASSERT_EQ(bitset.count(), 10);
+    bitset.resize(100, false);
+    ASSERT_EQ(bitset.count(), 10);
+    bitset.resize(200, true);
+    ASSERT_EQ(bitset.count(), 110);
+    ASSERT_EQ(bitset.find_first(), 0);
+    ASSERT_EQ(bitset.find_next(9), 100);
+
+    BitsetType ranged(300);
+    ranged.set(5, 250, true);
+    ASSERT_EQ(ranged.count(), 250);
+    ASSERT_FALSE(ranged[4]);
+    ASSERT_TRUE(ranged[5]);
+    ASSERT_TRUE(ranged[254]);
+    ASSERT_FALSE(ranged[255]);
+}
+
+TEST(Bitset, Logical) {
+    int64_t n = 10007;
+    auto left_bits = GenRandomBits(n, 0.5, 1);
+    auto right_bits = GenRandomBits(n, 0.5, 2);
+    auto left = ToBitset(left_bits);
+    auto right = ToBitset(right_bits);
+
+    std::vector<bool> and_bits(n), or_bits(n), xor_bits(n), minus_bits(n);
+    for (int64_t i = 0; i < n; ++i) {
+        and_bits[i] = left_bits[i] && right_bits[i];
+        or_bits[i] = left_bits[i] || right_bits[i];
+        xor_bits[i] = left_bits[i] != right_bits[i];
+        minus_bits[i] = left_bits[i] && !right_bits[i];
+    }
+    AssertBitsEqual(left & right, and_bits);
+    AssertBitsEqual(left | right, or_bits);
+    AssertBitsEqual(left ^ right, xor_bits);
+    AssertBitsEqual(left - right, minus_bits);
+    ASSERT_EQ(~~left, left);
+    ASSERT_NE(left, right);
+}
+
+TEST(Bitset, FindAndAppend) {
+    auto bits = GenRandomBits(3000, 0.01, 3);
+    auto bitset = ToBitset(bits);
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        if (bits[i]) {
+            expected.push_back(i);
+        }
+    }
+    std::vector<size_t> found;
+    for (auto i = bitset.find_first(); i != BitsetType::npos; i = bitset.find_next(i)) {
+        found.push_back(i);
+    }
+    ASSERT_EQ(found, expected);
+
+    // chunks of unaligned sizes, as assembled by ExecExprVisitor
+    std::vector<bool> all_bits;
+    BitsetType assembled;
+    for (int64_t n : {100, 64, 1, 1000, 37}) {
+        auto chunk_bits = GenRandomBits(n, 0.5, n);
+        assembled.append(ToBitset(chunk_bits));
+        all_bits.insert(all_bits.end(), chunk_bits.begin(), chunk_bits.end());
+    }
+    AssertBitsEqual(assembled, all_bits);
+}
+
+TEST(Bitset, View) {
+    auto bits = GenRandomBits(1000, 0.5, 4);
+    auto bitset = ToBitset(bits);
+    BitsetView view = bitset;
+    ASSERT_EQ(view.data(), bitset.data());
+    ASSERT_EQ(view.size(), bitset.size());
+    for (size_t i = 0; i < bits.size(); ++i) {
+        ASSERT_EQ(view.test(i), bits[i]);
+    }
+
+    auto sub_view = view.subview(512, 488);
+    ASSERT_EQ(sub_view.data(), bitset.data() + 64);
+    for (size_t i = 0; i < 488; ++i) {
+        ASSERT_EQ(sub_view.test(i), bits[512 + i]);
+    }
+
+    BitsetType copied(view.data(), view.size());
+    ASSERT_EQ(copied, bitset);
+}
+
+TEST(RoaringBitmap, Basic) {
+    int64_t n = 300000;
+    // sparse chunks are kept as arrays and dense ones as bitmaps
+    for (double ratio : {0.0, 0.001, 0.05, 0.5}) {
+        auto bits = GenRandomBits(n, ratio, 5);
+        auto dense = ToBitset(bits);
+        RoaringBitmap roaring(n);
+        for (int64_t i = 0; i < n; ++i) {
+            if (bits[i]) {
+                roaring.set(i);
+            }
+        }
+        ASSERT_EQ(roaring.count(), dense.count());
+        ASSERT_EQ(roaring.ToBitset(), dense);
+        ASSERT_EQ(RoaringBitmap::FromBitset(dense), roaring);
+        for (int64_t i = 0; i < n; i += 7) {
+            ASSERT_EQ(roaring.test(i), bits[i]);
+        }
+        if (ratio < 0.01) {
+            ASSERT_LT(roaring.memory_bytes(), dense.memory_bytes());
+        }
+
+        auto mask = ToBitset(GenRandomBits(n, 0.1, 6));
+        auto expected = mask | dense;
+        roaring.OrInto(mask);
+        ASSERT_EQ(mask, expected);
+    }
+}
+
+TEST(RoaringBitmap, Update) {
+    int64_t n = 100000;
+    RoaringBitmap roaring(n);
+    BitsetType dense(n);
+    // grow one chunk past the array limit and shrink it back
+    for (int64_t i = 0; i < 10000; ++i) {
+        roaring.set(i * 3);
+        dense.set(i * 3);
+    }
+    ASSERT_EQ(roaring.ToBitset(), dense);
+    for (int64_t i = 0; i < 10000; i += 2) {
+        roaring.reset(i * 3);
+        dense.reset(i * 3);
+    }
+    ASSERT_EQ(roaring.count(), 5000);
+    ASSERT_EQ(roaring.ToBitset(), dense);
+    ASSERT_EQ(RoaringBitmap::FromBitset(dense), roaring);
+
+    // the last chunk is only as long as needed
+    RoaringBitmap small = RoaringBitmap::FromBitset(BitsetType(1000, true));
+    ASSERT_LT(small.memory_bytes(), 1000);
+    small.resize(n);
+    small.set(n - 1);
+    ASSERT_EQ(small.count(), 1001);
+
+    roaring.set(n - 1);
+    roaring.resize(20000);
+    dense.resize(20000);
+    ASSERT_EQ(roaring.ToBitset(), dense);
+    roaring.resize(n);
+    ASSERT_FALSE(roaring.test(n - 1));
+    roaring.resize(0);
+    ASSERT_TRUE(roaring.none());
+}
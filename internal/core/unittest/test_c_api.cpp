@@ -28,6 +28,7 @@
 #include "segcore/Collection.h"
 #include "segcore/reduce_c.h"
 #include "segcore/Reduce.h"
+#include "segcore/SegcoreConfig.h"
 #include "test_utils/DataGen.h"
 #include "index/IndexFactory.h"
 #include "test_utils/indexbuilder_test_utils.h"
@@ -917,6 +918,69 @@ TEST(CApiTest, SearchTestWithExpr) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SearchPlanCache) {
+    auto& config = milvus::segcore::SegcoreConfig::default_config();
+    auto old_capacity = config.get_plan_cache_capacity();
+    config.set_plan_cache_capacity(1);
+    auto c_collection = NewCollection(get_default_schema_config());
+    config.set_plan_cache_capacity(old_capacity);
+
+    const char* serialized_expr_plan = R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: 10
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0"
+                                         >)";
+    const char* serialized_expr_plan2 = R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: 5
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0"
+                                         >)";
+    auto binary_plan = translate_text_plan_to_binary_plan(serialized_expr_plan);
+    auto binary_plan2 = translate_text_plan_to_binary_plan(serialized_expr_plan2);
+
+    void* plan = nullptr;
+    auto status = CreateSearchPlanByExpr(c_collection, binary_plan.data(), binary_plan.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* plan2 = nullptr;
+    status = CreateSearchPlanByExpr(c_collection, binary_plan.data(), binary_plan.size(), &plan2);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_EQ(GetTopK(plan), 10);
+    ASSERT_EQ(GetTopK(plan2), 10);
+
+    CPlanCacheStats stats;
+    status = GetPlanCacheStats(c_collection, &stats);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_EQ(stats.hit_count, 1);
+    ASSERT_EQ(stats.miss_count, 1);
+    ASSERT_EQ(stats.entry_count, 1);
+
+    // a different plan evicts the only slot
+    void* plan3 = nullptr;
+    status = CreateSearchPlanByExpr(c_collection, binary_plan2.data(), binary_plan2.size(), &plan3);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_EQ(GetTopK(plan3), 5);
+    status = GetPlanCacheStats(c_collection, &stats);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_EQ(stats.miss_count, 2);
+    ASSERT_EQ(stats.evict_count, 1);
+    ASSERT_EQ(stats.entry_count, 1);
+
+    // cached plans must outlive the handles given out
+    DeleteSearchPlan(plan);
+    ASSERT_EQ(GetTopK(plan2), 10);
+    DeleteSearchPlan(plan2);
+    DeleteSearchPlan(plan3);
+    DeleteCollection(c_collection);
+}
+
 TEST(CApiTest, RetrieveTestWithExpr) {
     auto collection = NewCollection(get_default_schema_config());
     auto segment = NewSegment(collection, Growing, -1);
@@ -953,6 +1017,119 @@ TEST(CApiTest, RetrieveTestWithExpr) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SearchAndRetrieveWithProfile) {
+    auto c_collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(c_collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)c_collection)->get_schema();
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    const char* serialized_expr_plan = R"(vector_anns: <
+                                            field_id: 100
+                                            predicates: <
+                                              unary_range_expr: <
+                                                column_info: <
+                                                  field_id: 101
+                                                  data_type: Int64
+                                                >
+                                                op: GreaterEqual
+                                                value: <
+                                                  int64_val: 0
+                                                >
+                                              >
+                                            >
+                                            query_info: <
+                                                topk: 10
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0"
+                                         >)";
+
+    int num_queries = 10;
+    auto blob = generate_query_data(num_queries);
+
+    void* plan = nullptr;
+    auto binary_plan = translate_text_plan_to_binary_plan(serialized_expr_plan);
+    auto status = CreateSearchPlanByExpr(c_collection, binary_plan.data(), binary_plan.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    CSearchResult search_result;
+    status = Search(segment, plan, placeholderGroup, N, &search_result);
+    ASSERT_EQ(status.error_code, Success);
+    char* profile = nullptr;
+    status = GetSearchResultProfile(search_result, &profile);
+    ASSERT_NE(status.error_code, Success);
+    free((char*)status.error_msg);
+    DeleteSearchResult(search_result);
+
+    status = SearchWithProfile(segment, plan, placeholderGroup, N, &search_result);
+    ASSERT_EQ(status.error_code, Success);
+    std::vector<CSearchResult> results{search_result};
+    auto slice_nqs = std::vector<int64_t>{num_queries};
+    auto slice_topKs = std::vector<int64_t>{10};
+    CSearchResultDataBlobs c_search_result_data;
+    status = ReduceSearchResultsAndFillData(&c_search_result_data, plan, results.data(), results.size(),
+                                            slice_nqs.data(), slice_topKs.data(), slice_nqs.size());
+    ASSERT_EQ(status.error_code, Success);
+
+    status = GetSearchResultProfile(search_result, &profile);
+    ASSERT_EQ(status.error_code, Success);
+    auto search_profile = milvus::json::parse(profile);
+    free(profile);
+    ASSERT_EQ(search_profile["search_strategy"], "vector_search");
+    ASSERT_EQ(search_profile["exprs"].size(), 1);
+    auto& expr = search_profile["exprs"][0];
+    ASSERT_EQ(expr["rows_out"], N);
+    ASSERT_EQ(expr["path"], "raw_data");
+    std::vector<std::string> phases;
+    for (auto& phase : search_profile["phases"]) {
+        phases.push_back(phase["phase"]);
+    }
+    std::vector<std::string> expected_phases{"predicate",        "mask_with_timestamps", "mask_with_delete",
+                                             "vector_search",    "fill_primary_keys",    "fill_target_entry"};
+    ASSERT_EQ(phases, expected_phases);
+
+    // retrieve "age in [0, 1]"
+    auto retrieve_plan = std::make_unique<query::RetrievePlan>(*schema);
+    std::vector<int64_t> values{0, 1};
+    retrieve_plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    retrieve_plan->plan_node_->predicate_ =
+        std::make_unique<query::TermExprImpl<int64_t>>(FieldId(101), DataType::INT64, values);
+    retrieve_plan->field_ids_ = {FieldId(101)};
+
+    CRetrieveResult retrieve_result;
+    status = RetrieveWithProfile(segment, retrieve_plan.get(), N, &retrieve_result, &profile);
+    ASSERT_EQ(status.error_code, Success);
+    auto retrieve_profile = milvus::json::parse(profile);
+    free(profile);
+    // age is the primary key, so term exprs on it go through the pk index
+    ASSERT_EQ(retrieve_profile["exprs"][0]["rows_out"], 2);
+    ASSERT_EQ(retrieve_profile["exprs"][0]["path"], "index");
+    ASSERT_EQ(retrieve_profile["phases"].back()["phase"], "fill_target_entry");
+
+    DeleteRetrieveResult(&retrieve_result);
+    DeleteSearchResultDataBlobs(c_search_result_data);
+    DeleteSearchResult(search_result);
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, GetMemoryUsageInBytesTest) {
     auto collection = NewCollection(get_default_schema_config());
     auto segment = NewSegment(collection, Growing, -1);
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <random>
 #include <string>
 #include <thread>
@@ -94,6 +95,90 @@ TEST(ConcurrentVector, TestMultithreads) {
     }
 }
 
+TEST(ConcurrentVector, TestReadWhileGrowing) {
+    ThreadSafeVector<std::vector<int64_t>> vec;
+    constexpr int64_t total = 5000;
+    std::atomic<bool> stop = false;
+
+    // readers never lock, an element is complete as soon as it's counted in size() and never moves
+    auto reader = [&] {
+        const int64_t* first = nullptr;
+        while (!stop) {
+            auto size = vec.size();
+            if (size > 0 && first == nullptr) {
+                first = vec[0].data();
+            }
+            for (int64_t i = 0; i < size; ++i) {
+                ASSERT_EQ(vec[i].size(), 4);
+            }
+            if (first != nullptr) {
+                ASSERT_EQ(vec[0].data(), first);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int i = 0; i < 4; ++i) {
+        pool.emplace_back(reader);
+    }
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; ++i) {
+        writers.emplace_back([&, i] {
+            for (int64_t size = 1; size <= total; size += i + 1) {
+                vec.emplace_to_at_least(size, std::vector<int64_t>(4));
+            }
+        });
+    }
+    for (auto& thread : writers) {
+        thread.join();
+    }
+    stop = true;
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    ASSERT_EQ(vec.size(), total);
+}
+
+TEST(ConcurrentVector, TestStringColumn) {
+    int64_t size_per_chunk = 32;
+    int64_t N = 100;
+    std::vector<std::string> strs(N);
+    for (int64_t i = 0; i < N; ++i) {
+        // empty strings and strings longer than a block of the arena
+        strs[i] = i % 10 == 0 ? "" : std::string(i == 42 ? 100000 : i, 'a' + i % 26);
+    }
+
+    // batches out of order and across chunks, as concurrent inserts fill a growing segment
+    ConcurrentVector<std::string> vec(size_per_chunk);
+    vec.set_data_raw(50, strs.data() + 50, N - 50);
+    vec.set_data_raw(0, strs.data(), 50);
+    ASSERT_EQ(vec.num_chunk(), milvus::upper_div(N, size_per_chunk));
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(vec[i], strs[i]);
+    }
+    for (int64_t chunk_id = 0; chunk_id < vec.num_chunk(); ++chunk_id) {
+        auto span = milvus::Span<std::string_view>(vec.get_span_base(chunk_id));
+        ASSERT_EQ(span.row_count(), size_per_chunk);
+        for (int64_t i = 0; i < size_per_chunk && chunk_id * size_per_chunk + i < N; ++i) {
+            ASSERT_EQ(span[i], strs[chunk_id * size_per_chunk + i]);
+        }
+    }
+
+    // a sealed column is one chunk with all the bytes packed back to back
+    ConcurrentVector<std::string> sealed(size_per_chunk);
+    sealed.fill_chunk_data(strs.data(), N);
+    ASSERT_EQ(sealed.num_chunk(), 1);
+    auto span = sealed.get_span(0);
+    ASSERT_EQ(span.row_count(), N);
+    const char* next = nullptr;
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(span[i], strs[i]);
+        if (!span[i].empty()) {
+            ASSERT_TRUE(next == nullptr || span[i].data() == next);
+            next = span[i].data() + span[i].size();
+        }
+    }
+}
+
 TEST(ConcurrentVector, TestAckSingle) {
     std::vector<std::tuple<int64_t, int64_t, int64_t>> raw_data;
     std::default_random_engine e(42);
@@ -112,3 +197,60 @@ TEST(ConcurrentVector, TestAckSingle) {
     }
     EXPECT_EQ(ack.GetAck(), N);
 }
+
+TEST(ConcurrentVector, TestAckManyOutstanding) {
+    // more segments waiting for a gap than the ack ring holds
+    AckResponder ack;
+    int N = 2000;
+    for (int i = N - 1; i >= 1; --i) {
+        ack.AddSegment(i, i + 1);
+        ASSERT_EQ(ack.GetAck(), 0);
+    }
+    ack.AddSegment(0, 1);
+    ASSERT_EQ(ack.GetAck(), N);
+}
+
+TEST(ConcurrentVector, TestAckMultithreads) {
+    AckResponder ack;
+    std::atomic<int64_t> reserved = 0;
+    std::atomic<bool> stop = false;
+    int num_threads = 8;
+    int num_segments = 20000;
+
+    // ack never goes backward, and every row under it has been acknowledged by its writer
+    std::vector<std::atomic<bool>> done(num_threads * num_segments * 4);
+    std::thread reader([&] {
+        int64_t last = 0;
+        while (!stop) {
+            auto current = ack.GetAck();
+            ASSERT_GE(current, last);
+            if (current > 0) {
+                ASSERT_TRUE(done[current - 1]);
+            }
+            last = current;
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < num_threads; ++t) {
+        writers.emplace_back([&, t] {
+            std::default_random_engine e(t);
+            for (int i = 0; i < num_segments; ++i) {
+                auto size = e() % 4 + 1;
+                auto begin = reserved.fetch_add(size);
+                for (auto row = begin; row < begin + size; ++row) {
+                    done[row] = true;
+                }
+                if (e() % 16 == 0) {
+                    std::this_thread::yield();
+                }
+                ack.AddSegment(begin, begin + size);
+            }
+        });
+    }
+    for (auto& thread : writers) {
+        thread.join();
+    }
+    stop = true;
+    reader.join();
+    ASSERT_EQ(ack.GetAck(), reserved);
+}
@@ -1611,3 +1611,99 @@ arg_types: Int64
                             << boost::format("[%1%, %2%, %3%, %4%, %5%]") % val1 % val2 % val3 % val4 % val5;
     }
 }
+
+TEST(Expr, TestSealedPackedInt) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    std::string dsl_string_tpl = R"({
+        "bool": {
+            "must": [
+                %1%,
+                {
+                    "vector": {
+                        "fakevec": {
+                            "metric_type": "L2",
+                            "params": {
+                                "nprobe": 10
+                            },
+                            "query": "$0",
+                            "topk": 10,
+                            "round_decimal": 3
+                        }
+                    }
+                }
+            ]
+        }
+    })";
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("age32", DataType::INT32);
+    schema->set_primary_field_id(pk_fid);
+
+    int N = 10000;
+    auto& config = SegcoreConfig::default_config();
+    auto old_max_bit_width = config.get_packed_int_max_bit_width();
+    // distinct ages are bit-packed, ages repeated in long runs are run length encoded
+    for (auto repeat_count : {1, 1000}) {
+        auto dataset = DataGen(schema, N, 42, 0, repeat_count);
+        config.set_packed_int_max_bit_width(32);
+        auto segment = SealedCreator(schema, dataset);
+        config.set_packed_int_max_bit_width(old_max_bit_width);
+        auto packed_int = segment->get_packed_int(i64_fid);
+        ASSERT_NE(packed_int, nullptr);
+        ASSERT_EQ(packed_int->is_run_length(), repeat_count > 1);
+        auto age_col = dataset.get_col<int64_t>(i64_fid);
+        auto age32_col = dataset.get_col<int32_t>(i32_fid);
+
+        auto lo = age_col[N / 4];
+        auto hi = age_col[N / 2];
+        auto range = [](const std::string& clause) { return R"({"range": {"age": {)" + clause + "}}}"; };
+        auto value = [](const char* op, int64_t v) { return boost::str(boost::format(R"("%1%": %2%)") % op % v); };
+        std::vector<std::tuple<std::string, std::function<bool(int64_t, int32_t)>>> testcases = {
+            {range(value("GT", lo) + ", " + value("LT", hi)), [=](int64_t v, int32_t) { return lo < v && v < hi; }},
+            {range(value("GE", lo) + ", " + value("LE", hi)), [=](int64_t v, int32_t) { return lo <= v && v <= hi; }},
+            {range(value("GE", lo)), [=](int64_t v, int32_t) { return v >= lo; }},
+            {range(value("GT", lo)), [=](int64_t v, int32_t) { return v > lo; }},
+            {range(value("LE", lo)), [=](int64_t v, int32_t) { return v <= lo; }},
+            {range(value("LT", lo)), [=](int64_t v, int32_t) { return v < lo; }},
+            {range(value("EQ", lo)), [=](int64_t v, int32_t) { return v == lo; }},
+            {range(value("NE", lo)), [=](int64_t v, int32_t) { return v != lo; }},
+            {range(value("LT", -1)), [=](int64_t v, int32_t) { return v < -1; }},
+            {range(R"("EQ": {"MOD": {"right_operand": 7, "value": 3}})"),
+             [=](int64_t v, int32_t) { return v % 7 == 3; }},
+            {boost::str(boost::format(R"({"term": {"age": {"values": [%1%, %2%, -1]}}})") % lo % hi),
+             [=](int64_t v, int32_t) { return v == lo || v == hi; }},
+            {R"({"compare": {"LT": ["age32", "age"]}})", [](int64_t v, int32_t v32) { return v32 < v; }},
+        };
+
+        // a filter may see fewer rows than the segment has
+        for (auto row_count : {N, N - 7}) {
+            ExecExprVisitor visitor(*segment, row_count, MAX_TIMESTAMP);
+            for (auto [clause, ref_func] : testcases) {
+                auto dsl_string = boost::str(boost::format(dsl_string_tpl) % clause);
+                auto plan = CreatePlan(*schema, dsl_string);
+                auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+                ASSERT_EQ(final.size(), row_count);
+                for (int i = 0; i < row_count; ++i) {
+                    ASSERT_EQ(final[i], ref_func(age_col[i], age32_col[i])) << clause << "@" << i << "!!" << age_col[i];
+                }
+            }
+        }
+
+        // the ages are decoded for output
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        std::vector<int64_t> values{lo, hi};
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        plan->plan_node_->predicate_ = std::make_unique<query::TermExprImpl<int64_t>>(i64_fid, DataType::INT64, values);
+        plan->field_ids_ = {i64_fid};
+        auto retrieved = segment->Retrieve(plan.get(), MAX_TIMESTAMP);
+        auto& output = retrieved->fields_data(0).scalars().long_data().data();
+        ASSERT_GT(output.size(), 0);
+        ASSERT_EQ(output.size(), retrieved->offset().size());
+        for (int i = 0; i < output.size(); ++i) {
+            ASSERT_EQ(output[i], age_col[retrieved->offset(i)]);
+        }
+    }
+}
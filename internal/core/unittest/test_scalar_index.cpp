@@ -13,6 +13,9 @@
 #include <knowhere/index/vector_index/helpers/IndexParameter.h>
 #include <knowhere/index/vector_index/ConfAdapterMgr.h>
 
+#include "index/BitmapIndex.h"
+#include "index/IndexStructure.h"
+#include "index/ScalarIndexSort.h"
 #include "index/IndexFactory.h"
 #include "common/CDataType.h"
 #include "test_utils/indexbuilder_test_utils.h"
@@ -116,6 +119,7 @@ TYPED_TEST_P(TypedScalarIndexTest, Reverse) {
         auto arr = GenArr<T>(nb);
         scalar_index->Build(nb, arr.data());
         assert_reverse<T>(scalar_index, arr);
+        assert_bulk_reverse<T>(scalar_index, nb);
     }
 }
 
@@ -166,3 +170,76 @@ using ScalarT = ::testing::Types<int8_t, int16_t, int32_t, int64_t, float, doubl
 REGISTER_TYPED_TEST_CASE_P(TypedScalarIndexTest, Dummy, Constructor, Count, In, NotIn, Range, Codec, Reverse);
 
 INSTANTIATE_TYPED_TEST_CASE_P(ArithmeticCheck, TypedScalarIndexTest, ScalarT);
+
+TEST(BitmapIndex, String) {
+    std::vector<std::string> categories{"book", "bookmark", "food", "toy"};
+    std::vector<std::string> arr;
+    for (int64_t i = 0; i < 10000; ++i) {
+        arr.push_back(categories[(i * 7) % categories.size()]);
+    }
+    auto index = milvus::index::CreateBitmapIndex<std::string>();
+    index->Build(arr.size(), arr.data());
+    ASSERT_EQ(index->Count(), arr.size());
+    ASSERT_EQ(index->Cardinality(), categories.size());
+
+    auto check = [&](const milvus::TargetBitmapPtr& bitset, std::function<bool(const std::string&)> expected) {
+        ASSERT_EQ(bitset->size(), arr.size());
+        for (size_t i = 0; i < arr.size(); ++i) {
+            ASSERT_EQ(bitset->test(i), expected(arr[i])) << i;
+        }
+    };
+    std::vector<std::string> terms{"food", "car"};
+    check(index->In(terms.size(), terms.data()), [](auto& v) { return v == "food"; });
+    check(index->NotIn(terms.size(), terms.data()), [](auto& v) { return v != "food"; });
+    check(index->Range("c", milvus::OpType::GreaterThan), [](auto& v) { return v > "c"; });
+    check(index->Range("bookmark", milvus::OpType::LessEqual), [](auto& v) { return v <= "bookmark"; });
+    check(index->Range("book", false, "toy", false), [](auto& v) { return v > "book" && v < "toy"; });
+
+    auto dataset = std::make_shared<knowhere::Dataset>();
+    dataset->Set(milvus::index::OPERATOR_TYPE, milvus::OpType::PrefixMatch);
+    dataset->Set(milvus::index::PREFIX_VALUE, std::string("book"));
+    check(index->Query(dataset), [](auto& v) { return v.rfind("book", 0) == 0; });
+    dataset->Set(milvus::index::OPERATOR_TYPE, milvus::OpType::Match);
+    dataset->Set(milvus::index::MATCH_VALUE, std::string("%o%"));
+    check(index->Query(dataset), [](auto& v) { return v.find('o') != std::string::npos; });
+
+    auto binary_set = index->Serialize(nullptr);
+    ASSERT_EQ(milvus::index::GetScalarIndexType(binary_set, "Trie"), milvus::index::BITMAP_INDEX);
+    auto copy_index = milvus::index::CreateBitmapIndex<std::string>();
+    copy_index->Load(binary_set);
+    for (size_t i = 0; i < arr.size(); ++i) {
+        ASSERT_EQ(copy_index->Reverse_Lookup(i), arr[i]);
+    }
+    check(copy_index->In(terms.size(), terms.data()), [](auto& v) { return v == "food"; });
+}
+
+TEST(ScalarIndexSort, LoadIndexStructures) {
+    std::vector<int32_t> arr{5, 3, 9, 3, 1};
+    std::shared_ptr<uint8_t[]> index_data(new uint8_t[arr.size() * sizeof(milvus::index::IndexStructure<int32_t>)]);
+    auto structures = reinterpret_cast<milvus::index::IndexStructure<int32_t>*>(index_data.get());
+    std::vector<size_t> order{4, 1, 3, 0, 2};
+    for (size_t i = 0; i < order.size(); ++i) {
+        structures[i] = milvus::index::IndexStructure<int32_t>(arr[order[i]], order[i]);
+    }
+    std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
+    auto length = arr.size();
+    memcpy(index_length.get(), &length, sizeof(size_t));
+    milvus::BinarySet binary_set;
+    binary_set.Append("index_data", index_data, arr.size() * sizeof(milvus::index::IndexStructure<int32_t>));
+    binary_set.Append("index_length", index_length, sizeof(size_t));
+
+    auto index = milvus::index::CreateScalarIndexSort<int32_t>();
+    index->Load(binary_set);
+    ASSERT_EQ(index->Count(), arr.size());
+    for (size_t i = 0; i < arr.size(); ++i) {
+        ASSERT_EQ(index->Reverse_Lookup(i), arr[i]);
+    }
+    auto bitset = index->Range(3, milvus::OpType::LessEqual);
+    ASSERT_EQ(bitset->count(), 3);
+
+    auto copy_index = milvus::index::CreateScalarIndexSort<int32_t>();
+    copy_index->Load(index->Serialize(nullptr));
+    for (size_t i = 0; i < arr.size(); ++i) {
+        ASSERT_EQ(copy_index->Reverse_Lookup(i), arr[i]);
+    }
+}
@@ -127,3 +127,27 @@ TYPED_TEST_P(TypedScalarIndexCreatorTest, Codec) {
 REGISTER_TYPED_TEST_CASE_P(TypedScalarIndexCreatorTest, Dummy, Constructor, Codec);
 
 INSTANTIATE_TYPED_TEST_CASE_P(ArithmeticCheck, TypedScalarIndexCreatorTest, ScalarT);
+
+TEST(ScalarIndexCreator, PickBitmapByCardinality) {
+    auto build = [](int64_t cardinality) {
+        auto creator = milvus::indexbuilder::CreateScalarIndex(milvus::DataType::INT64, "", "");
+        std::vector<int64_t> arr(10000);
+        for (size_t i = 0; i < arr.size(); ++i) {
+            arr[i] = i % cardinality;
+        }
+        build_index<int64_t>(creator, arr);
+        return creator;
+    };
+
+    auto low = build(10)->Serialize();
+    ASSERT_EQ(milvus::index::GetScalarIndexType(low, ""), milvus::index::BITMAP_INDEX);
+    auto high = build(1000)->Serialize();
+    ASSERT_EQ(milvus::index::GetScalarIndexType(high, ""), milvus::index::ASCENDING_SORT);
+
+    // the loaded index is of the type that was built
+    auto copy_creator = milvus::indexbuilder::CreateScalarIndex(milvus::DataType::INT64, "", "");
+    copy_creator->Load(low);
+    auto copy = copy_creator->Serialize();
+    ASSERT_EQ(milvus::index::GetScalarIndexType(copy, ""), milvus::index::BITMAP_INDEX);
+    ASSERT_EQ(copy.GetByName(milvus::index::BITMAP_INDEX_IDS)->size, 10000 * sizeof(uint16_t));
+}
@@ -17,6 +17,8 @@
 #include "segcore/SegmentSealedImpl.h"
 #include "test_utils/DataGen.h"
 #include "index/IndexFactory.h"
+#include "query/ExprImpl.h"
+#include "query/generated/ShowExprVisitor.h"
 #include "segcore/segcore_init_c.h"
 
 using namespace milvus;
@@ -418,7 +420,7 @@ TEST(Sealed, LoadFieldData) {
     ASSERT_EQ(segment->num_chunk_index(str_id), 0);
     auto chunk_span1 = segment->chunk_data<int64_t>(counter_id, 0);
     auto chunk_span2 = segment->chunk_data<double>(double_id, 0);
-    auto chunk_span3 = segment->chunk_data<std::string>(str_id, 0);
+    auto chunk_span3 = segment->chunk_data<std::string_view>(str_id, 0);
     auto ref1 = dataset.get_col<int64_t>(counter_id);
     auto ref2 = dataset.get_col<double>(double_id);
     auto ref3 = dataset.get_col(str_id)->scalars().string_data().data();
@@ -852,3 +854,381 @@ TEST(Sealed, RealCount) {
     ASSERT_TRUE(status.ok());
     ASSERT_EQ(0, segment->get_real_count());
 }
+
+TEST(Sealed, PredicateCache) {
+    auto& config = SegcoreConfig::default_config();
+    auto old_limit = config.get_predicate_cache_memory_limit();
+    config.set_predicate_cache_memory_limit(1024 * 1024);
+
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto metric_type = knowhere::metric::L2;
+    auto fake_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "counter": {
+                        "GE": 42000,
+                        "LT": 42005
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 6
+                    }
+                }
+            }
+            ]
+        }
+    })";
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto query_ptr = vec_col.data() + 42000 * dim;
+    auto segment = SealedCreator(schema, dataset);
+    config.set_predicate_cache_memory_limit(old_limit);
+
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, 16, query_ptr);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 10000000;
+
+    auto sr = segment->Search(plan.get(), ph_group.get(), time);
+    auto sr2 = segment->Search(plan.get(), ph_group.get(), time);
+    ASSERT_EQ(sr->seg_offsets_, sr2->seg_offsets_);
+    for (int i = 0; i < num_queries; ++i) {
+        ASSERT_EQ(sr2->seg_offsets_[i * topK], 42000 + i);
+    }
+
+    auto cache = segment->get_predicate_cache(time);
+    ASSERT_NE(cache, nullptr);
+    auto stats = cache->get_stats();
+    ASSERT_EQ(stats.miss_count, 1);
+    ASSERT_EQ(stats.hit_count, 1);
+    ASSERT_EQ(stats.entry_count, 1);
+    // 5 hits out of 100k rows are kept as positions
+    ASSERT_LT(stats.memory_bytes, N / 8);
+
+    // deletes are masked after the cached filter
+    auto pks = dataset.get_col<int64_t>(i64_fid);
+    auto del_offset = segment->PreDelete(1);
+    auto del_ids = GenPKs(pks.begin() + 42000, pks.begin() + 42001);
+    auto del_tss = GenTss(1, time - 1);
+    ASSERT_TRUE(segment->Delete(del_offset, 1, del_ids.get(), del_tss.data()).ok());
+    auto sr3 = segment->Search(plan.get(), ph_group.get(), time);
+    ASSERT_NE(sr3->seg_offsets_[0], 42000);
+    ASSERT_EQ(cache->get_stats().hit_count, 2);
+
+    // queries which don't see the whole segment bypass the cache
+    ASSERT_EQ(segment->get_predicate_cache(0), nullptr);
+}
+
+TEST(Sealed, PredicateCacheEviction) {
+    int64_t N = 10000;
+    PredicateCache cache(2 * N / 8);
+
+    BitsetType sparse(N);
+    sparse.set(1);
+    sparse.set(N - 1);
+    BitsetType full(N);
+    full.set();
+    full.reset(7);
+    BitsetType dense(N);
+    for (int i = 0; i < N; i += 2) {
+        dense.set(i);
+    }
+
+    cache.Put("sparse", sparse);
+    cache.Put("full", full);
+    ASSERT_EQ(cache.Get("sparse", N).value(), sparse);
+    ASSERT_EQ(cache.Get("full", N).value(), full);
+    ASSERT_FALSE(cache.Get("full", N + 1).has_value());
+    ASSERT_FALSE(cache.Get("absent", N).has_value());
+
+    // dense bitsets don't compress, two of them exceed the budget
+    cache.Put("dense", dense);
+    cache.Put("dense2", dense);
+    auto stats = cache.get_stats();
+    ASSERT_GT(stats.evict_count, 0);
+    ASSERT_LE(stats.memory_bytes, 2 * N / 8);
+    ASSERT_EQ(cache.Get("dense2", N).value(), dense);
+
+    cache.Clear();
+    ASSERT_EQ(cache.get_stats().entry_count, 0);
+    ASSERT_FALSE(cache.Get("dense2", N).has_value());
+}
+
+TEST(Sealed, PredicateCacheFingerprint) {
+    using query::LogicalBinaryExpr;
+    using query::UdfExpr;
+    auto make_udf = [](const std::string& wasm_body) -> query::ExprPtr {
+        return std::make_unique<UdfExpr>("is_even", std::vector<UdfExpr::param>{FieldId(101)},
+                                         std::vector<bool>{true}, wasm_body, std::vector<DataType>{DataType::INT64});
+    };
+    auto fingerprint = [](query::Expr& expr) { return query::ShowExprVisitor().call_child(expr).dump(); };
+
+    // udfs of the same name and body size are told apart by their bodies
+    auto udf1 = make_udf("AGFzbQEAAAA=");
+    auto udf2 = make_udf("AGFzbQEAAAB=");
+    ASSERT_NE(fingerprint(*udf1), fingerprint(*udf2));
+    ASSERT_EQ(fingerprint(*udf1), fingerprint(*make_udf("AGFzbQEAAAA=")));
+
+    auto minus = std::make_unique<LogicalBinaryExpr>(LogicalBinaryExpr::OpType::LogicalMinus, udf1, udf2);
+    ASSERT_NE(fingerprint(*minus).find("LogicalMinus"), std::string::npos);
+}
+
+TEST(Sealed, ExactSearchOnSurvivors) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto metric_type = knowhere::metric::L2;
+    auto fake_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "counter": {
+                        "GE": 42000,
+                        "LT": 43000
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 1
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 6
+                    }
+                }
+            }
+            ]
+        }
+    })";
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto query_ptr = vec_col.data() + 42000 * dim;
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, 16, query_ptr);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 10000000;
+
+    milvus::index::CreateIndexInfo create_index_info;
+    create_index_info.field_type = DataType::VECTOR_FLOAT;
+    create_index_info.metric_type = knowhere::metric::L2;
+    create_index_info.index_type = knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+    auto indexing = milvus::index::IndexFactory::GetInstance().CreateIndex(create_index_info, nullptr);
+    auto build_conf = knowhere::Config{{knowhere::meta::METRIC_TYPE, knowhere::metric::L2},
+                                       {knowhere::meta::DIM, std::to_string(dim)},
+                                       {knowhere::indexparam::NLIST, "100"}};
+    indexing->BuildWithDataset(knowhere::GenDataset(N, dim, vec_col.data()), build_conf);
+
+    LoadIndexInfo load_info;
+    load_info.field_id = fake_id.get();
+    load_info.index = std::move(indexing);
+    load_info.index_params["metric_type"] = "L2";
+    auto sealed_segment = SealedCreator(schema, dataset);
+    sealed_segment->DropFieldData(fake_id);
+    sealed_segment->LoadIndex(load_info);
+
+    auto& config = SegcoreConfig::default_config();
+    auto old_threshold = config.get_exact_search_threshold();
+    config.set_exact_search_threshold(0);
+    // brute force over the whole growing segment as the ground truth
+    auto segment = CreateGrowingSegment(schema);
+    segment->disable_small_index();
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    auto expected = segment->Search(plan.get(), ph_group.get(), time);
+    auto sr = sealed_segment->Search(plan.get(), ph_group.get(), time, true);
+    ASSERT_EQ(sr->profile_->search_strategy, "vector_search");
+
+    // the 1000 rows passing the filter are searched exactly, vectors come from the IVF_FLAT index
+    config.set_exact_search_threshold(2048);
+    sr = sealed_segment->Search(plan.get(), ph_group.get(), time, true);
+    config.set_exact_search_threshold(old_threshold);
+    ASSERT_EQ(sr->profile_->search_strategy, "exact_on_survivors");
+    ASSERT_EQ(sr->seg_offsets_, expected->seg_offsets_);
+    for (int i = 0; i < num_queries; ++i) {
+        ASSERT_EQ(sr->seg_offsets_[i * topK], 42000 + i);
+        ASSERT_EQ(sr->distances_[i * topK], 0.0);
+    }
+}
+
+TEST(Sealed, PackedIntColumn) {
+    std::default_random_engine er(42);
+    int64_t N = 1000;
+    auto check = [&](const std::vector<int64_t>& data, const PackedIntColumn& column) {
+        for (int64_t i = 0; i < N; ++i) {
+            ASSERT_EQ(column.Get(i), data[i]);
+        }
+        std::vector<int64_t> values{data[0], data[N / 2], data[N - 1], std::numeric_limits<int64_t>::min(),
+                                    std::numeric_limits<int64_t>::max()};
+        for (auto row_count : {N, N - 7}) {
+            for (auto value : values) {
+                auto lt = column.Range(row_count, OpType::LessThan, value);
+                auto ne = column.Range(row_count, OpType::NotEqual, value);
+                auto ge = column.Range(row_count, OpType::GreaterEqual, value);
+                auto between = column.Range(row_count, values[0], false, value, true);
+                auto in = column.In(row_count, 2, values.data() + 1);
+                ASSERT_EQ(lt.size(), row_count);
+                for (int64_t i = 0; i < row_count; ++i) {
+                    ASSERT_EQ(lt[i], data[i] < value);
+                    ASSERT_EQ(ne[i], data[i] != value);
+                    ASSERT_EQ(ge[i], data[i] >= value);
+                    ASSERT_EQ(between[i], values[0] < data[i] && data[i] <= value);
+                    ASSERT_EQ(in[i], data[i] == values[1] || data[i] == values[2]);
+                }
+            }
+        }
+    };
+
+    // narrow range, packed with 11 bits
+    std::vector<int64_t> data(N);
+    for (auto& x : data) {
+        x = -1000 + int64_t(er() % 2000);
+    }
+    auto column = PackedIntColumn::Encode(data.data(), N, 32);
+    ASSERT_NE(column, nullptr);
+    ASSERT_FALSE(column->is_run_length());
+    ASSERT_EQ(column->bit_width(), 11);
+    check(data, *column);
+    ASSERT_EQ(PackedIntColumn::Encode(data.data(), N, 10), nullptr);
+
+    // whole range, packed with 64 bits only when allowed
+    data[0] = std::numeric_limits<int64_t>::min();
+    data[1] = std::numeric_limits<int64_t>::max();
+    ASSERT_EQ(PackedIntColumn::Encode(data.data(), N, 32), nullptr);
+    column = PackedIntColumn::Encode(data.data(), N, 64);
+    ASSERT_NE(column, nullptr);
+    ASSERT_EQ(column->bit_width(), 64);
+    check(data, *column);
+
+    // sorted runs
+    for (int64_t i = 0; i < N; ++i) {
+        data[i] = (i / 100) * 1000000007;
+    }
+    column = PackedIntColumn::Encode(data.data(), N, 32);
+    ASSERT_NE(column, nullptr);
+    ASSERT_TRUE(column->is_run_length());
+    ASSERT_EQ(column->run_count(), N / 100);
+    ASSERT_LT(column->ByteSize(), N);
+    check(data, *column);
+}
+
+TEST(Sealed, LoadFieldDataMmap) {
+    auto dim = 16;
+    auto N = ROW_COUNT;
+    auto metric_type = knowhere::metric::L2;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto double_id = schema->AddDebugField("double", DataType::DOUBLE);
+    auto int32_id = schema->AddDebugField("int32", DataType::INT32);
+    auto int8_id = schema->AddDebugField("int8", DataType::INT8);
+    auto str_id = schema->AddDebugField("str", DataType::VARCHAR);
+    schema->set_primary_field_id(counter_id);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "double": {
+                        "GE": -1,
+                        "LT": 1
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 3
+                    }
+                }
+            }
+            ]
+        }
+    })";
+
+    auto dataset = DataGen(schema, N);
+    auto& config = SegcoreConfig::default_config();
+    auto old_mmap_enabled = config.get_mmap_enabled();
+    config.set_mmap_enabled(true);
+    auto segment = SealedCreator(schema, dataset);
+    config.set_mmap_enabled(false);
+    auto ref_segment = SealedCreator(schema, dataset);
+    config.set_mmap_enabled(old_mmap_enabled);
+
+    auto counter_span = segment->chunk_data<int64_t>(counter_id, 0);
+    auto double_span = segment->chunk_data<double>(double_id, 0);
+    auto int32_span = segment->chunk_data<int32_t>(int32_id, 0);
+    auto int8_span = segment->chunk_data<int8_t>(int8_id, 0);
+    auto str_span = segment->chunk_data<std::string_view>(str_id, 0);
+    auto counter_ref = dataset.get_col<int64_t>(counter_id);
+    auto double_ref = dataset.get_col<double>(double_id);
+    auto int32_ref = dataset.get_col<int32_t>(int32_id);
+    auto int8_ref = dataset.get_col<int8_t>(int8_id);
+    auto str_ref = dataset.get_col(str_id)->scalars().string_data().data();
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(counter_span[i], counter_ref[i]);
+        ASSERT_EQ(double_span[i], double_ref[i]);
+        ASSERT_EQ(int32_span[i], int32_ref[i]);
+        ASSERT_EQ(int8_span[i], int8_ref[i]);
+        ASSERT_EQ(str_span[i], str_ref[i]);
+    }
+
+    // brute force search scans the mapped vectors
+    Timestamp time = 1000000;
+    auto plan = CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(5, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    auto sr = segment->Search(plan.get(), ph_group.get(), time);
+    auto ref_sr = ref_segment->Search(plan.get(), ph_group.get(), time);
+    ASSERT_EQ(SearchResultToJson(*sr).dump(-2), SearchResultToJson(*ref_sr).dump(-2));
+
+    // retrieve gathers the output rows from the mapped files
+    std::vector<int64_t> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(counter_ref[i * 997 % N]);
+    }
+    auto retrieve_plan = std::make_unique<query::RetrievePlan>(*schema);
+    retrieve_plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    retrieve_plan->plan_node_->predicate_ =
+        std::make_unique<query::TermExprImpl<int64_t>>(counter_id, DataType::INT64, values);
+    retrieve_plan->field_ids_ = {counter_id, fakevec_id, double_id, int32_id, int8_id, str_id};
+    auto retrieved = segment->Retrieve(retrieve_plan.get(), time);
+    auto ref_retrieved = ref_segment->Retrieve(retrieve_plan.get(), time);
+    ASSERT_EQ(retrieved->fields_data_size(), retrieve_plan->field_ids_.size());
+    ASSERT_EQ(retrieved->SerializeAsString(), ref_retrieved->SerializeAsString());
+}
@@ -10,9 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <random>
 #include <string>
 #include <iostream>
+#include <thread>
 
 #include "segcore/SegmentGrowingImpl.h"
 #include "test_utils/DataGen.h"
@@ -81,6 +83,142 @@ TEST(SegmentCoreTest, SmallIndex) {
     schema->AddDebugField("age", DataType::INT32);
 }
 
+TEST(SegmentCoreTest, InsertFieldsOutOfOrder) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i32_fid = schema->AddDebugField("age", DataType::INT32);
+    auto str_fid = schema->AddDebugField("name", DataType::VARCHAR);
+    auto i64_fid = schema->AddDebugField("id", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    // large enough for the columns to be copied in parallel
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto& fields_data = *dataset.raw_->mutable_fields_data();
+    std::reverse(fields_data.begin(), fields_data.end());
+
+    auto segment = CreateGrowingSegment(schema);
+    auto reserved_begin = segment->PreInsert(N);
+    segment->Insert(reserved_begin, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto& record = dynamic_cast<SegmentGrowingImpl*>(segment.get())->get_insert_record();
+    auto vec = dataset.get_col<float>(vec_fid);
+    auto ages = dataset.get_col<int32_t>(i32_fid);
+    auto names = dataset.get_col<std::string>(str_fid);
+    auto ids = dataset.get_col<int64_t>(i64_fid);
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(record.get_field_data<milvus::FloatVector>(vec_fid)->get_element(i)[0], vec[i * 16]);
+        ASSERT_EQ(record.get_field_data<int32_t>(i32_fid)->operator[](i), ages[i]);
+        ASSERT_EQ(record.get_field_data<std::string>(str_fid)->operator[](i), names[i]);
+        ASSERT_EQ(record.row_ids_[i], dataset.row_ids_[i]);
+    }
+    for (int i = 0; i < N; i += 97) {
+        auto offsets = record.search_pk(PkType(ids[i]), int64_t(N));
+        ASSERT_TRUE(std::find(offsets.begin(), offsets.end(), SegOffset(i)) != offsets.end());
+    }
+}
+
+TEST(SegmentCoreTest, AsyncSmallIndex) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto config = SegcoreConfig::default_config();
+    config.set_chunk_rows(1024);
+    config.set_small_index_async(true);
+    config.set_scalar_small_index_enabled(false);
+    auto segment = CreateGrowingSegment(schema, -1, config);
+    auto growing = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    int N = 1024 * 8;
+    int batch = 1000;
+    for (int begin = 0; begin < N; begin += batch) {
+        auto size = std::min(batch, N - begin);
+        auto sub_dataset = DataGen(schema, size, 42 + begin);
+        auto reserved_begin = segment->PreInsert(size);
+        segment->Insert(reserved_begin, size, sub_dataset.row_ids_.data(), sub_dataset.timestamps_.data(),
+                        sub_dataset.raw_);
+        // the builds in flight are not visible yet
+        ASSERT_LE(growing->num_chunk_index(vec_fid), (begin + size) / 1024);
+    }
+
+    growing->get_indexing_record().WaitForBuilds();
+    ASSERT_EQ(growing->get_indexing_record().get_finished_ack(), N / 1024);
+    ASSERT_EQ(growing->num_chunk_index(vec_fid), N / 1024);
+    // scalar small indexes are disabled
+    ASSERT_FALSE(growing->get_indexing_record().is_in(i64_fid));
+    ASSERT_EQ(growing->num_chunk_index(i64_fid), 0);
+}
+
+TEST(SegmentCoreTest, AsyncSmallIndexFailure) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto config = SegcoreConfig::default_config();
+    config.set_chunk_rows(1024);
+    config.set_small_index_async(true);
+    config.set_scalar_small_index_enabled(false);
+    // without nlist, the small indexes of all chunks fail to build
+    SmallIndexConf small_index_conf;
+    small_index_conf.index_type = "IVF";
+    small_index_conf.search_params["nprobe"] = 4;
+    config.set_small_index_config(knowhere::metric::L2, small_index_conf);
+    auto segment = CreateGrowingSegment(schema, -1, config);
+    auto growing = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+    auto ref_segment = CreateGrowingSegment(schema);
+    ref_segment->disable_small_index();
+
+    int N = 1024 * 4;
+    auto dataset = DataGen(schema, N);
+    for (auto seg : {segment.get(), ref_segment.get()}) {
+        auto reserved_begin = seg->PreInsert(N);
+        seg->Insert(reserved_begin, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    }
+
+    // the ack still moves past the failed chunks, which are left without index
+    growing->get_indexing_record().WaitForBuilds();
+    ASSERT_EQ(growing->num_chunk_index(vec_fid), N / 1024);
+    auto& field_indexing = growing->get_indexing_record().get_field_indexing(vec_fid);
+    for (int chunk_id = 0; chunk_id < N / 1024; ++chunk_id) {
+        ASSERT_EQ(field_indexing.get_chunk_indexing(chunk_id), nullptr);
+    }
+
+    // and are searched on raw data
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 4
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 3
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = milvus::query::CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(5, 16, 1024);
+    auto ph_group = milvus::query::ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 1000000;
+    auto sr = segment->Search(plan.get(), ph_group.get(), time);
+    auto ref_sr = ref_segment->Search(plan.get(), ph_group.get(), time);
+    ASSERT_EQ(sr->seg_offsets_, ref_sr->seg_offsets_);
+    ASSERT_EQ(sr->distances_, ref_sr->distances_);
+}
+
 TEST(InsertRecordTest, growing_int64_t) {
     using namespace milvus::segcore;
     auto schema = std::make_shared<Schema>();
@@ -115,6 +253,65 @@ TEST(InsertRecordTest, growing_string) {
     }
 }
 
+TEST(InsertRecordTest, growing_concurrent_insert_pks) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    auto record = milvus::segcore::InsertRecord<false>(*schema, int64_t(32));
+    const int num_threads = 8;
+    const int batch = 1000;
+    const int num_batches = 20;
+    const int N = num_threads * batch * num_batches;
+
+    // every pk is inserted twice, by two consecutive rows of a batch
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            for (int b = 0; b < num_batches; b++) {
+                std::vector<PkType> pks(batch);
+                for (int i = 0; i < batch; i++) {
+                    pks[i] = int64_t(((t * num_batches + b) * batch + i) / 2);
+                }
+                record.insert_pks(pks, int64_t(t * num_batches + b) * batch);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int pk = 0; pk < N / 2; pk++) {
+        std::vector<SegOffset> offset = record.search_pk(PkType(int64_t(pk)), int64_t(N));
+        ASSERT_EQ(offset.size(), 2);
+        ASSERT_EQ(offset[0].get(), int64_t(2 * pk));
+        ASSERT_EQ(offset[1].get(), int64_t(2 * pk + 1));
+    }
+    ASSERT_TRUE(record.search_pk(PkType(int64_t(N)), int64_t(N)).empty());
+}
+
+TEST(InsertRecordTest, growing_strided_pks) {
+    using namespace milvus::segcore;
+    const int N = 100000;
+
+    // pks sharing their low bits, as allocator or timestamp derived ids do, must not share their home slots
+    for (int shift : {0, 20, 32}) {
+        OffsetHashMap<int64_t> map;
+        std::vector<PkType> pks(N);
+        for (int i = 0; i < N; i++) {
+            pks[i] = int64_t(i) << shift;
+        }
+        map.insert(pks.data(), N, 0);
+        ASSERT_LT(map.max_probe_length(), 64);
+        for (int i = 0; i < N; i++) {
+            auto offsets = map.find(pks[i]);
+            ASSERT_EQ(offsets.size(), 1);
+            ASSERT_EQ(offsets[0], i);
+        }
+    }
+}
+
 TEST(InsertRecordTest, sealed_int64_t) {
     using namespace milvus::segcore;
     auto schema = std::make_shared<Schema>();
@@ -150,4 +347,39 @@ TEST(InsertRecordTest, sealed_string) {
         std::vector<SegOffset> offset = record.search_pk(std::to_string(i), int64_t(N + 1));
         ASSERT_EQ(offset[0].get(), int64_t(i));
     }
-}
\ No newline at end of file
+}
+TEST(InsertRecordTest, sealed_search_pks) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto str_fid = schema->AddDebugField("name", DataType::VARCHAR);
+    schema->set_primary_field_id(str_fid);
+    auto record = milvus::segcore::InsertRecord<true>(*schema, int64_t(32));
+    const int N = 10000;
+
+    // pks share their first 8 bytes, and every pk is inserted by offsets i and i + N
+    auto pk_of = [](int i) { return "long_prefix_" + std::to_string(i); };
+    for (int i = N - 1; i >= 0; i--) record.insert_pk(PkType(pk_of(i)), int64_t(i + N));
+    for (int i = 0; i < N; i++) record.insert_pk(PkType(pk_of(i)), int64_t(i));
+    record.seal_pks();
+
+    std::vector<PkType> pks;
+    for (int i = 0; i < N; i += 3) {
+        pks.emplace_back(pk_of(i));
+        pks.emplace_back(pk_of(i + N));
+    }
+    auto hits = record.search_pks(pks, int64_t(2 * N));
+    // half of the pks are present, with two offsets each
+    ASSERT_EQ(hits.size(), pks.size());
+    for (size_t j = 0; j < hits.size(); j += 2) {
+        auto [i, offset] = hits[j];
+        ASSERT_EQ(i % 2, 0);
+        ASSERT_EQ(pks[i], PkType(pk_of(offset.get())));
+        ASSERT_EQ(hits[j + 1].first, i);
+        ASSERT_EQ(hits[j + 1].second.get(), offset.get() + N);
+    }
+
+    ASSERT_EQ(record.search_pk(PkType(pk_of(7)), int64_t(2 * N)).size(), 2);
+    ASSERT_TRUE(record.search_pk(PkType(std::string("long_prefix_")), int64_t(2 * N)).empty());
+    ASSERT_TRUE(record.search_pk(PkType(std::string("")), int64_t(2 * N)).empty());
+}
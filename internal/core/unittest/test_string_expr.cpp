@@ -16,8 +16,10 @@
 
 #include "pb/plan.pb.h"
 #include "query/Expr.h"
+#include "query/LazyPredicate.h"
 #include "query/generated/PlanNodeVisitor.h"
 #include "query/generated/ExecExprVisitor.h"
+#include "segcore/SegcoreConfig.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "test_utils/DataGen.h"
 #include "query/PlanProto.h"
@@ -324,6 +326,7 @@ TEST(StringExpr, Compare) {
         {proto::plan::OpType::Equal, [](std::string v1, std::string v2) { return v1 == v2; }},
         {proto::plan::OpType::NotEqual, [](std::string v1, std::string v2) { return v1 != v2; }},
         {proto::plan::OpType::PrefixMatch, [](std::string v1, std::string v2) { return PrefixMatch(v1, v2); }},
+        {proto::plan::OpType::PostfixMatch, [](std::string v1, std::string v2) { return PostfixMatch(v1, v2); }},
     };
 
     auto seg = CreateGrowingSegment(schema);
@@ -399,6 +402,12 @@ TEST(StringExpr, UnaryRange) {
         {proto::plan::OpType::LessThan, "3000", [](std::string val) { return val < "3000"; }},
         {proto::plan::OpType::LessEqual, "3000", [](std::string val) { return val <= "3000"; }},
         {proto::plan::OpType::PrefixMatch, "a", [](std::string val) { return PrefixMatch(val, "a"); }},
+        {proto::plan::OpType::PostfixMatch, "7", [](std::string val) { return PostfixMatch(val, "7"); }},
+        {proto::plan::OpType::PostfixMatch, "123456789", [](std::string val) { return PostfixMatch(val, "123456789"); }},
+        {proto::plan::OpType::Match, "%12%", [](std::string val) { return val.find("12") != std::string::npos; }},
+        {proto::plan::OpType::Match, "1%2%3",
+         [](std::string val) { return std::regex_match(val, std::regex("1.*2.*3")); }},
+        {proto::plan::OpType::Match, "1234", [](std::string val) { return val == "1234"; }},
     };
 
     auto seg = CreateGrowingSegment(schema);
@@ -499,6 +508,202 @@ TEST(StringExpr, BinaryRange) {
     }
 }
 
+TEST(StringExpr, SealedDictEncoded) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = GenTestSchema();
+    const auto& fvec_meta = schema->operator[](FieldName("fvec"));
+    const auto& str_meta = schema->operator[](FieldName("str"));
+    const auto& another_str_meta = schema->operator[](FieldName("another_str"));
+
+    // every string repeated 10 times, so the string columns are loaded dictionary encoded
+    int N = 10000;
+    auto dataset = DataGen(schema, N, 42, 0, 10);
+    auto& config = SegcoreConfig::default_config();
+    auto old_max_cardinality = config.get_string_dict_max_cardinality();
+    config.set_string_dict_max_cardinality(64 * 1024);
+    auto segment = SealedCreator(schema, dataset);
+    config.set_string_dict_max_cardinality(old_max_cardinality);
+    ASSERT_NE(segment->get_string_dict(str_meta.get_id()), nullptr);
+    ASSERT_LE(segment->get_string_dict(str_meta.get_id())->cardinality(), N / 10);
+    ASSERT_LT(segment->GetMemoryUsageInBytes(), schema->get_total_sizeof() * N);
+    auto str_col = dataset.get_col(str_meta.get_id())->scalars().string_data().data();
+    auto another_str_col = dataset.get_col(another_str_meta.get_id())->scalars().string_data().data();
+
+    auto gen_plan = [&](proto::plan::Expr* expr) {
+        auto anns = GenAnns(expr, false, fvec_meta.get_id().get(), "$0");
+        auto plan_node = std::make_unique<proto::plan::PlanNode>();
+        plan_node->set_allocated_vector_anns(anns);
+        return ProtoParser(*schema).CreatePlan(*plan_node);
+    };
+    auto str_column_info = [&](const FieldMeta& field_meta) {
+        return GenColumnInfo(field_meta.get_id().get(), proto::schema::DataType::VarChar, false, false);
+    };
+
+    std::vector<std::pair<std::unique_ptr<Plan>, std::function<bool(int)>>> testcases;
+    auto value = str_col[N / 2];
+    for (auto op : {proto::plan::OpType::Equal, proto::plan::OpType::NotEqual, proto::plan::OpType::GreaterThan,
+                    proto::plan::OpType::GreaterEqual, proto::plan::OpType::LessThan, proto::plan::OpType::LessEqual,
+                    proto::plan::OpType::PrefixMatch, proto::plan::OpType::PostfixMatch}) {
+        auto operand = op == proto::plan::OpType::PrefixMatch    ? value.substr(0, 2)
+                       : op == proto::plan::OpType::PostfixMatch ? value.substr(value.size() - 2)
+                                                                 : value;
+        auto unary_range_expr = GenUnaryRangeExpr(op, operand);
+        unary_range_expr->set_allocated_column_info(str_column_info(str_meta));
+        auto expr = GenExpr().release();
+        expr->set_allocated_unary_range_expr(unary_range_expr);
+        testcases.emplace_back(gen_plan(expr), [&, op, operand](int i) {
+            std::string_view val = str_col[i];
+            switch (op) {
+                case proto::plan::OpType::Equal:
+                    return val == operand;
+                case proto::plan::OpType::NotEqual:
+                    return val != operand;
+                case proto::plan::OpType::GreaterThan:
+                    return val > operand;
+                case proto::plan::OpType::GreaterEqual:
+                    return val >= operand;
+                case proto::plan::OpType::LessThan:
+                    return val < operand;
+                case proto::plan::OpType::LessEqual:
+                    return val <= operand;
+                case proto::plan::OpType::PrefixMatch:
+                    return PrefixMatch(val, operand);
+                default:
+                    return PostfixMatch(val, operand);
+            }
+        });
+    }
+    {
+        auto lower = std::min(str_col[0], str_col[N - 1]);
+        auto upper = std::max(str_col[0], str_col[N - 1]);
+        auto binary_range_expr = GenBinaryRangeExpr(true, false, lower, upper);
+        binary_range_expr->set_allocated_column_info(str_column_info(str_meta));
+        auto expr = GenExpr().release();
+        expr->set_allocated_binary_range_expr(binary_range_expr);
+        testcases.emplace_back(gen_plan(expr), [&, lower, upper](int i) {
+            return lower <= str_col[i] && str_col[i] < upper;
+        });
+    }
+    {
+        std::vector<std::string> terms{str_col[0], str_col[N - 1], "not a value"};
+        auto term_expr = GenTermExpr<std::string>(terms);
+        term_expr->set_allocated_column_info(str_column_info(str_meta));
+        auto expr = GenExpr().release();
+        expr->set_allocated_term_expr(term_expr);
+        testcases.emplace_back(gen_plan(expr), [&, terms](int i) {
+            return std::find(terms.begin(), terms.end(), str_col[i]) != terms.end();
+        });
+    }
+    {
+        auto compare_expr = GenCompareExpr(proto::plan::OpType::LessThan);
+        compare_expr->set_allocated_left_column_info(str_column_info(str_meta));
+        compare_expr->set_allocated_right_column_info(str_column_info(another_str_meta));
+        auto expr = GenExpr().release();
+        expr->set_allocated_compare_expr(compare_expr);
+        testcases.emplace_back(gen_plan(expr), [&](int i) { return str_col[i] < another_str_col[i]; });
+    }
+
+    // a filter may see fewer rows than the segment has
+    for (auto row_count : {N, N - 7}) {
+        ExecExprVisitor visitor(*segment, row_count, MAX_TIMESTAMP);
+        for (auto& [plan, ref_func] : testcases) {
+            auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+            ASSERT_EQ(final.size(), row_count);
+            for (int i = 0; i < row_count; ++i) {
+                ASSERT_EQ(final[i], ref_func(i)) << "@" << i << "!!" << str_col[i];
+            }
+        }
+    }
+
+    // the strings are decoded for output
+    auto retrieve_expr = GenAlwaysTrueExpr(fvec_meta, str_meta);
+    auto retrieve_plan_proto = GenPlanNode();
+    retrieve_plan_proto->set_allocated_predicates(retrieve_expr);
+    SetTargetEntry(retrieve_plan_proto, {str_meta.get_id().get()});
+    auto retrieve_plan = ProtoParser(*schema).CreateRetrievePlan(*retrieve_plan_proto);
+    auto retrieved = segment->Retrieve(retrieve_plan.get(), MAX_TIMESTAMP);
+    auto& output = retrieved->fields_data(0).scalars().string_data().data();
+    ASSERT_EQ(output.size(), retrieved->offset().size());
+    for (int i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(output[i], str_col[retrieved->offset(i)]);
+    }
+}
+
+TEST(StringExpr, LazyPredicate) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = GenTestSchema();
+    const auto& fvec_meta = schema->operator[](FieldName("fvec"));
+    const auto& str_meta = schema->operator[](FieldName("str"));
+
+    auto gen_unary_range_plan = [&, fvec_meta, str_meta](proto::plan::OpType op,
+                                                         std::string value) -> std::unique_ptr<proto::plan::PlanNode> {
+        auto column_info = GenColumnInfo(str_meta.get_id().get(), proto::schema::DataType::VarChar, false, false);
+        auto unary_range_expr = GenUnaryRangeExpr(op, value);
+        unary_range_expr->set_allocated_column_info(column_info);
+
+        auto expr = GenExpr().release();
+        expr->set_allocated_unary_range_expr(unary_range_expr);
+
+        auto anns = GenAnns(expr, fvec_meta.get_data_type() == DataType::VECTOR_BINARY, fvec_meta.get_id().get(), "$0");
+
+        auto plan_node = std::make_unique<proto::plan::PlanNode>();
+        plan_node->set_allocated_vector_anns(anns);
+        return std::move(plan_node);
+    };
+
+    std::vector<std::tuple<proto::plan::OpType, std::string>> testcases{
+        {proto::plan::OpType::GreaterThan, "5"},
+        {proto::plan::OpType::LessThan, "2"},
+        {proto::plan::OpType::PrefixMatch, "11"},
+        {proto::plan::OpType::PostfixMatch, "11"},
+        {proto::plan::OpType::Match, "%11%"},
+    };
+
+    int64_t N = 100000;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fvec_meta.get_id());
+    auto segment = CreateGrowingSegment(schema);
+    segment->disable_small_index();  // brute-force search.
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+    ExecExprVisitor visitor(*seg_promote, N, MAX_TIMESTAMP);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, 16, vec_col.data());
+    auto& config = SegcoreConfig::default_config();
+    for (const auto& [op, value] : testcases) {
+        auto plan = ProtoParser(*schema).CreatePlan(*gen_unary_range_plan(op, value));
+        auto& predicate = *plan->plan_node_->predicate_.value();
+
+        // evaluated row by row, the same as the bitset of all rows
+        auto expected = visitor.call_child(predicate);
+        LazyPredicate lazy_predicate(*seg_promote, predicate, N);
+        for (int64_t i = N - 1; i >= 0; i -= 7) {
+            ASSERT_EQ(lazy_predicate(i), expected[i]) << "@" << op << "@" << value << "@" << i;
+        }
+        ASSERT_EQ(lazy_predicate(N - 1), expected[N - 1]);
+        ASSERT_EQ(lazy_predicate.num_evaluated(), (N + 6) / 7);
+
+        // string filters are checked on the candidates of the search only
+        auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        auto lazy_result = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP, true);
+        ASSERT_TRUE(lazy_result->profile_->lazy_predicate);
+        ASSERT_LT(lazy_result->profile_->lazy_predicate_rows, N / 5);
+
+        config.set_lazy_predicate_enabled(false);
+        auto eager_result = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP, true);
+        config.set_lazy_predicate_enabled(true);
+        ASSERT_FALSE(eager_result->profile_->lazy_predicate);
+        ASSERT_EQ(lazy_result->seg_offsets_, eager_result->seg_offsets_);
+        ASSERT_EQ(lazy_result->distances_, eager_result->distances_);
+    }
+}
+
 TEST(AlwaysTrueStringPlan, SearchWithOutputFields) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -72,6 +72,23 @@ TEST_F(StringIndexMarisaTest, NotIn) {
     ASSERT_TRUE(bitset->none());
 }
 
+TEST_F(StringIndexMarisaTest, EmbeddedNul) {
+    using namespace std::string_literals;
+    std::vector<std::string> values{"a\0b"s, "a\0c"s, "a"s, "a\0b"s};
+    auto index = milvus::index::CreateStringIndexMarisa();
+    index->Build(values.size(), values.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(index->Reverse_Lookup(i), values[i]);
+    }
+    auto bitset = index->In(1, values.data());
+    ASSERT_EQ(bitset->count(), 2);
+    ASSERT_TRUE(bitset->test(0));
+    ASSERT_TRUE(bitset->test(3));
+    auto not_in = index->NotIn(1, values.data() + 2);
+    ASSERT_EQ(not_in->count(), 3);
+    ASSERT_FALSE(not_in->test(2));
+}
+
 TEST_F(StringIndexMarisaTest, Range) {
     auto index = milvus::index::CreateStringIndexMarisa();
     std::vector<std::string> strings(nb);
@@ -111,12 +128,46 @@ TEST_F(StringIndexMarisaTest, Range) {
     }
 }
 
+TEST_F(StringIndexMarisaTest, RangeMatchesScan) {
+    auto index = milvus::index::CreateStringIndexMarisa();
+    index->Build(nb, strs.data());
+
+    std::vector<std::string> bounds = {"", "0", "5", strs[0], strs[nb / 2], strs[0] + "0", "~"};
+    for (auto& value : bounds) {
+        auto lt = index->Range(value, milvus::OpType::LessThan);
+        auto le = index->Range(value, milvus::OpType::LessEqual);
+        auto gt = index->Range(value, milvus::OpType::GreaterThan);
+        auto ge = index->Range(value, milvus::OpType::GreaterEqual);
+        auto prefix = index->PrefixMatch(value);
+        for (size_t i = 0; i < strs.size(); i++) {
+            ASSERT_EQ(lt->test(i), strs[i] < value);
+            ASSERT_EQ(le->test(i), strs[i] <= value);
+            ASSERT_EQ(gt->test(i), strs[i] > value);
+            ASSERT_EQ(ge->test(i), strs[i] >= value);
+            ASSERT_EQ(prefix->test(i), milvus::PrefixMatch(strs[i], value));
+        }
+        for (auto& upper : bounds) {
+            for (auto lb_inclusive : {true, false}) {
+                for (auto ub_inclusive : {true, false}) {
+                    auto bitset = index->Range(value, lb_inclusive, upper, ub_inclusive);
+                    for (size_t i = 0; i < strs.size(); i++) {
+                        auto expected = (lb_inclusive ? strs[i] >= value : strs[i] > value) &&
+                                        (ub_inclusive ? strs[i] <= upper : strs[i] < upper);
+                        ASSERT_EQ(bitset->test(i), expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST_F(StringIndexMarisaTest, Reverse) {
     auto index_types = GetIndexTypes<std::string>();
     for (const auto& index_type : index_types) {
         auto index = milvus::index::IndexFactory::GetInstance().CreateScalarIndex<std::string>(index_type);
         index->Build(nb, strs.data());
         assert_reverse<std::string>(index.get(), strs);
+        assert_bulk_reverse<std::string>(index.get(), nb);
     }
 }
 
@@ -132,6 +183,35 @@ TEST_F(StringIndexMarisaTest, PrefixMatch) {
     }
 }
 
+TEST_F(StringIndexMarisaTest, PostfixMatch) {
+    auto index = milvus::index::CreateStringIndexMarisa();
+    index->Build(nb, strs.data());
+
+    for (size_t i = 0; i < strs.size(); i++) {
+        auto postfix = strs[i].substr(strs[i].size() / 2);
+        auto bitset = index->PostfixMatch(postfix);
+        ASSERT_EQ(bitset->size(), strs.size());
+        for (size_t j = 0; j < strs.size(); j++) {
+            ASSERT_EQ(bitset->test(j), milvus::PostfixMatch(strs[j], postfix));
+        }
+    }
+}
+
+TEST_F(StringIndexMarisaTest, PatternMatch) {
+    auto index = milvus::index::CreateStringIndexMarisa();
+    index->Build(nb, strs.data());
+
+    for (auto& infix : {"1", "23", "456"}) {
+        auto bitset = index->PatternMatch(std::string("%") + infix + "%");
+        ASSERT_EQ(bitset->size(), strs.size());
+        for (size_t j = 0; j < strs.size(); j++) {
+            ASSERT_EQ(bitset->test(j), strs[j].find(infix) != std::string::npos);
+        }
+    }
+    auto bitset = index->PatternMatch(strs[0]);
+    ASSERT_TRUE(bitset->test(0));
+}
+
 TEST_F(StringIndexMarisaTest, Query) {
     auto index = milvus::index::CreateStringIndexMarisa();
     index->Build(nb, strs.data());
@@ -35,7 +35,56 @@ TEST(Util, StringMatch) {
     ASSERT_FALSE(PostfixMatch("dontmatch", "postfix"));
 }
 
-TEST(Util, GetDeleteBitmap) {
+TEST(Util, StringMatcher) {
+    using namespace milvus;
+
+    // literals within and beyond one 8-byte word, on strings shorter and longer than a word
+    StringMatcher prefix(OpType::PrefixMatch, "tag_");
+    ASSERT_TRUE(prefix("tag_"));
+    ASSERT_TRUE(prefix("tag_very_long_value"));
+    ASSERT_FALSE(prefix("tax_very_long_value"));
+    ASSERT_FALSE(prefix("tag"));
+    ASSERT_TRUE(StringMatcher(OpType::PrefixMatch, "")("anything"));
+    ASSERT_TRUE(StringMatcher(OpType::PrefixMatch, "a_long_prefix")("a_long_prefix_1"));
+    ASSERT_FALSE(StringMatcher(OpType::PrefixMatch, "a_long_prefix")("a_long_prefiy_1"));
+
+    StringMatcher postfix(OpType::PostfixMatch, ".jpg");
+    ASSERT_TRUE(postfix("a.jpg"));
+    ASSERT_TRUE(postfix("some/long/path/to/image.jpg"));
+    ASSERT_FALSE(postfix("some/long/path/to/image.png"));
+    ASSERT_FALSE(postfix("jpg"));
+    ASSERT_TRUE(StringMatcher(OpType::PostfixMatch, "a_long_postfix")("1a_long_postfix"));
+    ASSERT_FALSE(StringMatcher(OpType::PostfixMatch, "a_long_postfix")("1a_long_postfiy"));
+
+    StringMatcher infix(OpType::Match, "%needle%");
+    ASSERT_TRUE(infix("needle"));
+    ASSERT_TRUE(infix("haystack with a needle inside"));
+    ASSERT_FALSE(infix("haystack with a neeedle inside"));
+
+    StringMatcher pattern(OpType::Match, "ab%cd%ef");
+    ASSERT_TRUE(pattern("abcdef"));
+    ASSERT_TRUE(pattern("ab_cd_cd_ef"));
+    ASSERT_FALSE(pattern("abef"));
+    ASSERT_FALSE(pattern("abcdeff"));
+    // the infix must not overlap the anchors
+    ASSERT_FALSE(StringMatcher(OpType::Match, "ab%b")("ab"));
+    ASSERT_FALSE(StringMatcher(OpType::Match, "a%bc%c")("abc"));
+
+    StringMatcher escaped(OpType::Match, "100\\%%");
+    ASSERT_TRUE(escaped("100%"));
+    ASSERT_TRUE(escaped("100% sure"));
+    ASSERT_FALSE(escaped("1000"));
+    ASSERT_TRUE(StringMatcher(OpType::Match, "exact")("exact"));
+    ASSERT_FALSE(StringMatcher(OpType::Match, "exact")("exactly"));
+    ASSERT_TRUE(StringMatcher(OpType::Match, "%%")(""));
+
+    ASSERT_TRUE(query::Match(std::string_view("1postfix"), std::string("postfix"), OpType::PostfixMatch));
+    // patterns go through a StringMatcher built once per expr
+    ASSERT_ANY_THROW(query::Match(std::string("a-b-c"), std::string("a%c"), OpType::Match));
+    ASSERT_ANY_THROW(StringMatcher(OpType::LessThan, "a"));
+}
+
+TEST(Util, ApplyDeletes) {
     using namespace milvus;
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -63,35 +112,53 @@ TEST(Util, GetDeleteBitmap) {
     field_data->fill_chunk_data(age_data.data(), N);
     insert_record.ack_responder_.AddSegment(insert_offset, insert_offset + N);
 
+    auto deleted_count = [&](Timestamp query_timestamp) {
+        BitsetType bitset(N);
+        delete_record.mask_deleted(bitset, N, query_timestamp);
+        return bitset.count();
+    };
+
     // test case delete pk1(ts = 0) -> insert repeated pk1 (ts = {1 ... N}) -> query (ts = N)
     std::vector<Timestamp> delete_ts = {0};
     std::vector<PkType> delete_pk = {1};
-    auto offset = delete_record.reserved.fetch_add(1);
-    delete_record.timestamps_.set_data_raw(offset, delete_ts.data(), 1);
-    delete_record.pks_.set_data_raw(offset, delete_pk.data(), 1);
-    delete_record.ack_responder_.AddSegment(offset, offset + 1);
-
-    auto query_timestamp = tss[N - 1];
-    auto del_barrier = get_barrier(delete_record, query_timestamp);
-    auto insert_barrier = get_barrier(insert_record, query_timestamp);
-    auto res_bitmap = get_deleted_bitmap(del_barrier, insert_barrier, delete_record, insert_record, query_timestamp);
-    ASSERT_EQ(res_bitmap->bitmap_ptr->count(), 0);
+    apply_deletes(delete_record, insert_record, delete_pk, delete_ts.data());
+    ASSERT_EQ(deleted_count(tss[N - 1]), 0);
 
     // test case insert repeated pk1 (ts = {1 ... N}) -> delete pk1 (ts = N) -> query (ts = N)
     delete_ts = {uint64_t(N)};
-    delete_pk = {1};
-    offset = delete_record.reserved.fetch_add(1);
-    delete_record.timestamps_.set_data_raw(offset, delete_ts.data(), 1);
-    delete_record.pks_.set_data_raw(offset, delete_pk.data(), 1);
-    delete_record.ack_responder_.AddSegment(offset, offset + 1);
-
-    del_barrier = get_barrier(delete_record, query_timestamp);
-    res_bitmap = get_deleted_bitmap(del_barrier, insert_barrier, delete_record, insert_record, query_timestamp);
-    ASSERT_EQ(res_bitmap->bitmap_ptr->count(), N);
+    apply_deletes(delete_record, insert_record, delete_pk, delete_ts.data());
+    ASSERT_EQ(deleted_count(tss[N - 1]), N);
+    ASSERT_EQ(deleted_count(MAX_TIMESTAMP), N);
 
     // test case insert repeated pk1 (ts = {1 ... N}) -> delete pk1 (ts = N) -> query (ts = N/2)
-    query_timestamp = tss[N - 1] / 2;
-    del_barrier = get_barrier(delete_record, query_timestamp);
-    res_bitmap = get_deleted_bitmap(del_barrier, N, delete_record, insert_record, query_timestamp);
-    ASSERT_EQ(res_bitmap->bitmap_ptr->count(), 0);
+    ASSERT_EQ(deleted_count(tss[N - 1] / 2), 0);
+
+    // an earlier delete of pk1 (ts = N/2) deletes the rows inserted until then earlier
+    delete_ts = {uint64_t(N / 2)};
+    apply_deletes(delete_record, insert_record, delete_pk, delete_ts.data());
+    ASSERT_EQ(deleted_count(tss[N - 1] / 2), N / 2);
+    ASSERT_EQ(deleted_count(tss[N - 1]), N);
+}
+
+TEST(Util, MarkInsertedRows) {
+    using namespace milvus;
+    using namespace milvus::segcore;
+
+    // deletes of pk 1 at ts = 5 and pk 2 at ts = 20 come before the rows they apply to
+    DeletedRecord delete_record;
+    std::vector<PkType> delete_pks = {int64_t(1), int64_t(2)};
+    std::vector<Timestamp> delete_ts = {5, 20};
+    delete_record.index_deletes(delete_pks, delete_ts.data());
+
+    std::vector<PkType> pks = {int64_t(1), int64_t(1), int64_t(2), int64_t(3)};
+    std::vector<Timestamp> tss = {4, 6, 10, 1};
+    delete_record.mark_inserted_rows(pks, tss.data(), 0);
+    ASSERT_EQ(delete_record.num_deleted_rows(), 2);
+
+    BitsetType bitset(pks.size());
+    delete_record.mask_deleted(bitset, pks.size(), 20);
+    ASSERT_TRUE(bitset[0]);
+    ASSERT_FALSE(bitset[1]);
+    ASSERT_TRUE(bitset[2]);
+    ASSERT_FALSE(bitset[3]);
 }
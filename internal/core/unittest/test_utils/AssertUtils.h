@@ -149,6 +149,28 @@ assert_reverse(ScalarIndex<std::string>* index, const std::vector<std::string>&
     }
 }
 
+// the batch forms of reverse lookup must agree with Reverse_Lookup
+template <typename T>
+inline void
+assert_bulk_reverse(ScalarIndex<T>* index, size_t n) {
+    std::vector<int64_t> offsets;
+    for (int64_t offset = n - 1; offset >= 0; offset -= 3) {
+        offsets.push_back(offset);
+    }
+    std::unique_ptr<T[]> values(new T[offsets.size()]);
+    index->ReverseLookup(offsets.data(), offsets.size(), values.get());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT_EQ(values[i], index->Reverse_Lookup(offsets[i]));
+    }
+
+    auto begin = n / 3;
+    std::unique_ptr<T[]> column(new T[n - begin]);
+    index->ReverseLookupRange(begin, n - begin, column.get());
+    for (size_t i = begin; i < n; ++i) {
+        ASSERT_EQ(column[i - begin], index->Reverse_Lookup(i));
+    }
+}
+
 template <>
 inline void
 assert_in(ScalarIndex<std::string>* index, const std::vector<std::string>& arr) {
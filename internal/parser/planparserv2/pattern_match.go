@@ -2,74 +2,78 @@ package planparserv2
 
 import (
 	"fmt"
+	"strings"
 
 	"github.com/milvus-io/milvus/internal/proto/planpb"
 )
 
-var wildcards = map[byte]struct{}{
-	// '_': {}, // TODO
-	'%': {},
-}
-
 var escapeCharacter byte = '\\'
 
-// hasWildcards returns true if pattern contains any wildcard.
-func hasWildcards(pattern string) bool {
-	l := len(pattern)
-	i := l - 1
-	for ; i >= 0; i-- {
-		_, ok := wildcards[pattern[i]]
-		if ok {
-			if i > 0 && pattern[i-1] == escapeCharacter {
-				i--
-				continue
-			}
-			return true
+// splitPattern splits pattern on its unescaped % wildcards and unescapes the literals between them,
+// so "a\%b%c" gives ["a%b", "c"]. The wildcard _ is not supported yet, an unescaped _ is an error.
+func splitPattern(pattern string) ([]string, error) {
+	literals := make([]string, 0, 1)
+	var literal strings.Builder
+	for i := 0; i < len(pattern); i++ {
+		c := pattern[i]
+		switch {
+		case c == escapeCharacter && i+1 < len(pattern):
+			i++
+			literal.WriteByte(pattern[i])
+		case c == '%':
+			literals = append(literals, literal.String())
+			literal.Reset()
+		case c == '_':
+			return nil, fmt.Errorf("unsupported pattern: %s, the wildcard _ is not supported yet", pattern)
+		default:
+			literal.WriteByte(c)
 		}
 	}
-	return false
+	return append(literals, literal.String()), nil
 }
 
-// findLastNotOfWildcards find the last location not of last wildcard.
-func findLastNotOfWildcards(pattern string) int {
-	loc := len(pattern) - 1
-	for ; loc >= 0; loc-- {
-		_, ok := wildcards[pattern[loc]]
-		if !ok {
-			break
-		}
-		if ok {
-			if loc > 0 && pattern[loc-1] == escapeCharacter {
-				break
-			}
+// escapeLiteral escapes the wildcards and escape characters of literal, so segcore matches it as is.
+func escapeLiteral(literal string) string {
+	var escaped strings.Builder
+	for i := 0; i < len(literal); i++ {
+		if literal[i] == '%' || literal[i] == '_' || literal[i] == escapeCharacter {
+			escaped.WriteByte(escapeCharacter)
 		}
+		escaped.WriteByte(literal[i])
 	}
-	return loc
+	return escaped.String()
 }
 
 // translatePatternMatch translates pattern to related op type and operand.
+// The operands of equal, prefix and postfix matches are unescaped, the operand of a general match is a pattern.
 func translatePatternMatch(pattern string) (op planpb.OpType, operand string, err error) {
-	l := len(pattern)
-	loc := findLastNotOfWildcards(pattern)
-
-	if loc < 0 {
-		// always match.
-		return planpb.OpType_PrefixMatch, "", nil
+	literals, err := splitPattern(pattern)
+	if err != nil {
+		return planpb.OpType_Invalid, "", err
 	}
-
-	exist := hasWildcards(pattern[:loc+1])
-	if loc >= l-1 && !exist {
+	if len(literals) == 1 {
 		// equal match.
-		return planpb.OpType_Equal, pattern, nil
+		return planpb.OpType_Equal, literals[0], nil
 	}
-	if !exist {
-		// prefix match.
-		return planpb.OpType_PrefixMatch, pattern[:loc+1], nil
+
+	first, last := literals[0], literals[len(literals)-1]
+	hasInfix := false
+	for _, literal := range literals[1 : len(literals)-1] {
+		hasInfix = hasInfix || literal != ""
+	}
+	if !hasInfix && last == "" {
+		// prefix match, always match if the prefix is empty.
+		return planpb.OpType_PrefixMatch, first, nil
+	}
+	if !hasInfix && first == "" {
+		// postfix match.
+		return planpb.OpType_PostfixMatch, last, nil
 	}
 
-	return planpb.OpType_Invalid, "", fmt.Errorf(
-		"unsupported pattern: %s, "+
-			"only prefix pattern match like %s "+
-			"and equal match like %s(no wildcards) are supported",
-		pattern, "ab%", "ab")
+	// general pattern match, the pattern is evaluated by segcore.
+	escaped := make([]string, 0, len(literals))
+	for _, literal := range literals {
+		escaped = append(escaped, escapeLiteral(literal))
+	}
+	return planpb.OpType_Match, strings.Join(escaped, "%"), nil
 }
@@ -6,86 +6,6 @@ import (
 	"github.com/milvus-io/milvus/internal/proto/planpb"
 )
 
-func Test_hasWildcards(t *testing.T) {
-	type args struct {
-		pattern string
-	}
-	tests := []struct {
-		name string
-		args args
-		want bool
-	}{
-		{
-			args: args{
-				pattern: "no-wildcards",
-			},
-			want: false,
-		},
-		{
-			args: args{
-				pattern: "has\\%",
-			},
-			want: false,
-		},
-		{
-			args: args{
-				pattern: "%",
-			},
-			want: true,
-		},
-		{
-			args: args{
-				pattern: "has%",
-			},
-			want: true,
-		},
-	}
-	for _, tt := range tests {
-		t.Run(tt.name, func(t *testing.T) {
-			if got := hasWildcards(tt.args.pattern); got != tt.want {
-				t.Errorf("hasWildcards(%s) = %v, want %v", tt.args.pattern, got, tt.want)
-			}
-		})
-	}
-}
-
-func Test_findLocOfLastWildcard(t *testing.T) {
-	type args struct {
-		pattern string
-	}
-	tests := []struct {
-		name string
-		args args
-		want int
-	}{
-		{
-			args: args{
-				pattern: "no-wildcards",
-			},
-			want: 11,
-		},
-		{
-			args: args{
-				pattern: "only\\%",
-			},
-			want: 5,
-		},
-		{
-			args: args{
-				pattern: "prefix%%",
-			},
-			want: 5,
-		},
-	}
-	for _, tt := range tests {
-		t.Run(tt.name, func(t *testing.T) {
-			if got := findLastNotOfWildcards(tt.args.pattern); got != tt.want {
-				t.Errorf("findLastNotOfWildcards(%s) = %v, want %v", tt.args.pattern, got, tt.want)
-			}
-		})
-	}
-}
-
 func Test_translatePatternMatch(t *testing.T) {
 	type args struct {
 		pattern string
@@ -115,12 +35,72 @@ func Test_translatePatternMatch(t *testing.T) {
 			wantOperand: "",
 			wantErr:     false,
 		},
+		{
+			args:        args{pattern: "%suffix"},
+			wantOp:      planpb.OpType_PostfixMatch,
+			wantOperand: "suffix",
+			wantErr:     false,
+		},
+		{
+			args:        args{pattern: "%%infix%"},
+			wantOp:      planpb.OpType_Match,
+			wantOperand: "%%infix%",
+			wantErr:     false,
+		},
 		{
 			args:        args{pattern: "prefix%suffix"},
+			wantOp:      planpb.OpType_Match,
+			wantOperand: "prefix%suffix",
+			wantErr:     false,
+		},
+		{
+			args:        args{pattern: "not_%_supported"},
+			wantOp:      planpb.OpType_Invalid,
+			wantOperand: "",
+			wantErr:     true,
+		},
+		{
+			args:        args{pattern: "not_supported%"},
+			wantOp:      planpb.OpType_Invalid,
+			wantOperand: "",
+			wantErr:     true,
+		},
+		{
+			args:        args{pattern: "not_supported"},
 			wantOp:      planpb.OpType_Invalid,
 			wantOperand: "",
 			wantErr:     true,
 		},
+		{
+			args:        args{pattern: `equal\%\_\\`},
+			wantOp:      planpb.OpType_Equal,
+			wantOperand: `equal%_\`,
+			wantErr:     false,
+		},
+		{
+			args:        args{pattern: `pre\%fix\_%%`},
+			wantOp:      planpb.OpType_PrefixMatch,
+			wantOperand: "pre%fix_",
+			wantErr:     false,
+		},
+		{
+			args:        args{pattern: `%post\_fix\%`},
+			wantOp:      planpb.OpType_PostfixMatch,
+			wantOperand: "post_fix%",
+			wantErr:     false,
+		},
+		{
+			args:        args{pattern: `%in\%fix\_%`},
+			wantOp:      planpb.OpType_Match,
+			wantOperand: `%in\%fix\_%`,
+			wantErr:     false,
+		},
+		{
+			args:        args{pattern: `a\b%c`},
+			wantOp:      planpb.OpType_Match,
+			wantOperand: "ab%c",
+			wantErr:     false,
+		},
 	}
 	for _, tt := range tests {
 		t.Run(tt.name, func(t *testing.T) {
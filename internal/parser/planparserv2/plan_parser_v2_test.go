@@ -122,6 +122,9 @@ func TestExpr_Like(t *testing.T) {
 	exprStrs := []string{
 		`VarCharField like "prefix%"`,
 		`VarCharField like "equal"`,
+		`VarCharField like "%postfix"`,
+		`VarCharField like "%infix%"`,
+		`VarCharField like "prefix%infix%postfix"`,
 	}
 	for _, exprStr := range exprStrs {
 		assertValidExpr(t, helper, exprStr)
@@ -206,6 +206,12 @@ func (node *QueryNode) InitSegcore() {
 	nprobe := C.int64_t(Params.QueryNodeCfg.SmallIndexNProbe)
 	C.SegcoreSetNprobe(nprobe)
 
+	C.SegcoreSetSmallIndexAsync(C.bool(Params.QueryNodeCfg.SmallIndexAsync))
+	C.SegcoreSetSmallIndexBuildThreads(C.int64_t(Params.QueryNodeCfg.SmallIndexBuildThreads))
+	C.SegcoreSetSmallIndexBuildQueueSize(C.int64_t(Params.QueryNodeCfg.SmallIndexBuildQueueSize))
+	C.SegcoreSetVectorSmallIndexEnabled(C.bool(Params.QueryNodeCfg.VectorSmallIndexEnabled))
+	C.SegcoreSetScalarSmallIndexEnabled(C.bool(Params.QueryNodeCfg.ScalarSmallIndexEnabled))
+
 	// override segcore SIMD type
 	cSimdType := C.CString(Params.CommonCfg.SimdType)
 	cRealSimdType := C.SegcoreSetSimdType(cSimdType)
@@ -217,6 +223,22 @@ func (node *QueryNode) InitSegcore() {
 	cIndexSliceSize := C.int64_t(Params.CommonCfg.IndexSliceSize)
 	C.SegcoreSetIndexSliceSize(cIndexSliceSize)
 
+	// override segcore plan cache
+	C.SegcoreSetPlanCacheCapacity(C.int64_t(Params.QueryNodeCfg.PlanCacheCapacity))
+	C.SegcoreSetPlanCacheMemoryLimit(C.int64_t(Params.QueryNodeCfg.PlanCacheMemoryLimit))
+
+	// override segcore predicate cache
+	C.SegcoreSetPredicateCacheMemoryLimit(C.int64_t(Params.QueryNodeCfg.PredicateCacheMemoryLimit))
+
+	// override segcore filter evaluation
+	C.SegcoreSetLazyPredicateEnabled(C.bool(Params.QueryNodeCfg.LazyPredicateEnabled))
+	C.SegcoreSetExactSearchThreshold(C.int64_t(Params.QueryNodeCfg.ExactSearchThreshold))
+
+	// override segcore encoding of sealed segment columns
+	C.SegcoreSetStringDictMaxCardinality(C.int64_t(Params.QueryNodeCfg.StringDictMaxCardinality))
+	C.SegcoreSetPackedIntMaxBitWidth(C.int64_t(Params.QueryNodeCfg.PackedIntMaxBitWidth))
+	C.SegcoreSetMmapEnabled(C.bool(Params.QueryNodeCfg.MmapEnabled))
+
 	initcore.InitLocalStorageConfig(&Params)
 	initcore.InitMinioConfig(&Params)
 }
@@ -800,6 +800,23 @@ type queryNodeConfig struct {
 	SmallIndexNlist  int64
 	SmallIndexNProbe int64
 
+	SmallIndexAsync          bool
+	SmallIndexBuildThreads   int64
+	SmallIndexBuildQueueSize int64
+	VectorSmallIndexEnabled  bool
+	ScalarSmallIndexEnabled  bool
+
+	PlanCacheCapacity    int64
+	PlanCacheMemoryLimit int64
+
+	PredicateCacheMemoryLimit int64
+	LazyPredicateEnabled      bool
+	ExactSearchThreshold      int64
+
+	StringDictMaxCardinality int64
+	PackedIntMaxBitWidth     int64
+	MmapEnabled              bool
+
 	CreatedTime time.Time
 	UpdatedTime time.Time
 
@@ -835,6 +852,13 @@ func (p *queryNodeConfig) init(base *BaseTable) {
 	p.initStatsPublishInterval()
 
 	p.initSmallIndexParams()
+	p.initPlanCacheParams()
+	p.initPredicateCacheMemoryLimit()
+	p.initLazyPredicateEnabled()
+	p.initExactSearchThreshold()
+	p.initStringDictMaxCardinality()
+	p.initPackedIntMaxBitWidth()
+	p.initMmapEnabled()
 
 	p.initLoadMemoryUsageFactor()
 	p.initOverloadedMemoryThresholdPercentage()
@@ -902,6 +926,41 @@ func (p *queryNodeConfig) initSmallIndexParams() {
 		log.Warn("small index nprobe must smaller than nlist, force set to", zap.Any("nprobe", p.SmallIndexNlist))
 		p.SmallIndexNProbe = p.SmallIndexNlist
 	}
+
+	p.SmallIndexAsync = p.Base.ParseBool("queryNode.segcore.smallIndex.async", true)
+	p.SmallIndexBuildThreads = p.Base.ParseInt64WithDefault("queryNode.segcore.smallIndex.buildThreads", 2)
+	p.SmallIndexBuildQueueSize = p.Base.ParseInt64WithDefault("queryNode.segcore.smallIndex.buildQueueSize", 16)
+	p.VectorSmallIndexEnabled = p.Base.ParseBool("queryNode.segcore.smallIndex.vectorEnabled", true)
+	p.ScalarSmallIndexEnabled = p.Base.ParseBool("queryNode.segcore.smallIndex.scalarEnabled", true)
+}
+
+func (p *queryNodeConfig) initPlanCacheParams() {
+	p.PlanCacheCapacity = p.Base.ParseInt64WithDefault("queryNode.segcore.planCache.capacity", 0)
+	p.PlanCacheMemoryLimit = p.Base.ParseInt64WithDefault("queryNode.segcore.planCache.memoryLimit", 64*1024*1024)
+}
+
+func (p *queryNodeConfig) initPredicateCacheMemoryLimit() {
+	p.PredicateCacheMemoryLimit = p.Base.ParseInt64WithDefault("queryNode.segcore.predicateCache.memoryLimit", 0)
+}
+
+func (p *queryNodeConfig) initLazyPredicateEnabled() {
+	p.LazyPredicateEnabled = p.Base.ParseBool("queryNode.segcore.lazyPredicate.enabled", true)
+}
+
+func (p *queryNodeConfig) initExactSearchThreshold() {
+	p.ExactSearchThreshold = p.Base.ParseInt64WithDefault("queryNode.segcore.exactSearch.threshold", 0)
+}
+
+func (p *queryNodeConfig) initStringDictMaxCardinality() {
+	p.StringDictMaxCardinality = p.Base.ParseInt64WithDefault("queryNode.segcore.stringDict.maxCardinality", 0)
+}
+
+func (p *queryNodeConfig) initPackedIntMaxBitWidth() {
+	p.PackedIntMaxBitWidth = p.Base.ParseInt64WithDefault("queryNode.segcore.packedInt.maxBitWidth", 0)
+}
+
+func (p *queryNodeConfig) initMmapEnabled() {
+	p.MmapEnabled = p.Base.ParseBool("queryNode.segcore.mmap.enabled", false)
 }
 
 func (p *queryNodeConfig) initLoadMemoryUsageFactor() {
@@ -236,6 +236,21 @@ func TestComponentParam(t *testing.T) {
 		nprobe := Params.SmallIndexNProbe
 		assert.Equal(t, int64(16), nprobe)
 
+		assert.Equal(t, true, Params.SmallIndexAsync)
+		assert.Equal(t, int64(2), Params.SmallIndexBuildThreads)
+		assert.Equal(t, int64(16), Params.SmallIndexBuildQueueSize)
+		assert.Equal(t, true, Params.VectorSmallIndexEnabled)
+		assert.Equal(t, true, Params.ScalarSmallIndexEnabled)
+
+		assert.Equal(t, int64(0), Params.PlanCacheCapacity)
+		assert.Equal(t, int64(64*1024*1024), Params.PlanCacheMemoryLimit)
+		assert.Equal(t, int64(0), Params.PredicateCacheMemoryLimit)
+		assert.Equal(t, true, Params.LazyPredicateEnabled)
+		assert.Equal(t, int64(0), Params.ExactSearchThreshold)
+		assert.Equal(t, int64(0), Params.StringDictMaxCardinality)
+		assert.Equal(t, int64(0), Params.PackedIntMaxBitWidth)
+		assert.Equal(t, false, Params.MmapEnabled)
+
 		assert.Equal(t, true, Params.GroupEnabled)
 		assert.Equal(t, int32(10240), Params.MaxReceiveChanSize)
 		assert.Equal(t, int32(10240), Params.MaxUnsolvedQueueSize)